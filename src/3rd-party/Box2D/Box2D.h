@@ -50,6 +50,7 @@ For discussion please visit http://box2d.org/forum
 #include "Dynamics/b2WorldCallbacks.h"
 #include "Dynamics/b2TimeStep.h"
 #include "Dynamics/b2World.h"
+#include "Dynamics/b2WorldSnapshot.h"
 
 #include "Dynamics/Contacts/b2Contact.h"
 
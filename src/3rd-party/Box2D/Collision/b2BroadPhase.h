@@ -49,6 +49,11 @@ public:
 	/// UpdatePairs is called.
 	int32 CreateProxy(const b2AABB& aabb, void* userData);
 
+	/// Create proxies for many AABBs at once, see b2DynamicTree::CreateProxies.
+	/// Unlike CreateProxy the new proxies are not buffered as moved. Call
+	/// TouchProxy on the proxies that should look for new pairs.
+	void CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds);
+
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
 
@@ -107,6 +112,7 @@ public:
 private:
 
 	friend class b2DynamicTree;
+	friend class b2WorldSnapshot;
 
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
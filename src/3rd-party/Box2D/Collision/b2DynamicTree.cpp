@@ -118,6 +118,243 @@ int32 b2DynamicTree::CreateProxy(const b2AABB& aabb, void* userData)
 	return proxyId;
 }
 
+void b2DynamicTree::CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds)
+{
+	if (count <= 0)
+	{
+		return;
+	}
+
+	int32* leaves = (int32*)b2Alloc(count * sizeof(int32));
+
+	// Fatten the aabbs.
+	b2Vec2 r(b2_aabbExtension, b2_aabbExtension);
+	for (int32 i = 0; i < count; ++i)
+	{
+		int32 proxyId = AllocateNode();
+		m_nodes[proxyId].aabb.lowerBound = aabbs[i].lowerBound - r;
+		m_nodes[proxyId].aabb.upperBound = aabbs[i].upperBound + r;
+		m_nodes[proxyId].userData = userData[i];
+		m_nodes[proxyId].height = 0;
+
+		proxyIds[i] = proxyId;
+		leaves[i] = proxyId;
+	}
+
+	int32 root = BuildTopDown(leaves, count);
+	b2Free(leaves);
+
+	InsertLeaf(root);
+}
+
+// Build a subtree over the given leaves and return its root. Internal nodes are
+// allocated before their children, so the bounds and heights are filled in
+// reverse allocation order.
+int32 b2DynamicTree::BuildTopDown(int32* leaves, int32 count)
+{
+	if (count == 1)
+	{
+		return leaves[0];
+	}
+
+	struct b2BuildEntry
+	{
+		int32 start;
+		int32 count;
+		int32 parent;
+	};
+
+	int32* internals = (int32*)b2Alloc((count - 1) * sizeof(int32));
+	int32 internalCount = 0;
+	int32 root = b2_nullNode;
+
+	b2GrowableStack<b2BuildEntry, 256> stack;
+	b2BuildEntry entry = { 0, count, b2_nullNode };
+	stack.Push(entry);
+
+	while (stack.GetCount() > 0)
+	{
+		entry = stack.Pop();
+
+		int32 nodeId;
+		if (entry.count == 1)
+		{
+			nodeId = leaves[entry.start];
+		}
+		else
+		{
+			nodeId = AllocateNode();
+			internals[internalCount++] = nodeId;
+
+			int32 split = PartitionLeaves(leaves + entry.start, entry.count);
+
+			// The first half is popped first and becomes child1.
+			b2BuildEntry second = { entry.start + split, entry.count - split, nodeId };
+			b2BuildEntry first = { entry.start, split, nodeId };
+			stack.Push(second);
+			stack.Push(first);
+		}
+
+		m_nodes[nodeId].parent = entry.parent;
+		if (entry.parent == b2_nullNode)
+		{
+			root = nodeId;
+		}
+		else if (m_nodes[entry.parent].child1 == b2_nullNode)
+		{
+			m_nodes[entry.parent].child1 = nodeId;
+		}
+		else
+		{
+			m_nodes[entry.parent].child2 = nodeId;
+		}
+	}
+
+	for (int32 i = internalCount - 1; i >= 0; --i)
+	{
+		b2TreeNode* node = m_nodes + internals[i];
+		const b2TreeNode* child1 = m_nodes + node->child1;
+		const b2TreeNode* child2 = m_nodes + node->child2;
+
+		node->aabb.Combine(child1->aabb, child2->aabb);
+		node->height = 1 + b2Max(child1->height, child2->height);
+	}
+
+	b2Free(internals);
+	return root;
+}
+
+// Reorder the leaves in two groups using a binned surface area heuristic on the
+// centers along the longest axis. In 2D the perimeter is used as the area.
+// Returns the size of the first group.
+int32 b2DynamicTree::PartitionLeaves(int32* leaves, int32 count) const
+{
+	if (count == 2)
+	{
+		return 1;
+	}
+
+	b2Vec2 lower = m_nodes[leaves[0]].aabb.GetCenter();
+	b2Vec2 upper = lower;
+	for (int32 i = 1; i < count; ++i)
+	{
+		b2Vec2 c = m_nodes[leaves[i]].aabb.GetCenter();
+		lower = b2Min(lower, c);
+		upper = b2Max(upper, c);
+	}
+
+	b2Vec2 extent = upper - lower;
+	int32 axis = extent.x >= extent.y ? 0 : 1;
+	float32 minValue = axis == 0 ? lower.x : lower.y;
+	float32 range = axis == 0 ? extent.x : extent.y;
+
+	if (range <= b2_epsilon)
+	{
+		// All centers coincide, any split is as good as another.
+		return count / 2;
+	}
+
+	const int32 binCount = 16;
+	b2AABB binBounds[binCount];
+	int32 binCounts[binCount];
+	for (int32 i = 0; i < binCount; ++i)
+	{
+		binCounts[i] = 0;
+	}
+
+	float32 scale = binCount / range;
+	for (int32 i = 0; i < count; ++i)
+	{
+		const b2AABB& aabb = m_nodes[leaves[i]].aabb;
+		b2Vec2 c = aabb.GetCenter();
+		int32 bin = b2Min(int32(((axis == 0 ? c.x : c.y) - minValue) * scale), binCount - 1);
+		if (binCounts[bin] == 0)
+		{
+			binBounds[bin] = aabb;
+		}
+		else
+		{
+			binBounds[bin].Combine(aabb);
+		}
+		++binCounts[bin];
+	}
+
+	// Cost of the right side of each split plane, swept from the right.
+	float32 rightCost[binCount];
+	b2AABB bounds;
+	int32 sideCount = 0;
+	for (int32 i = binCount - 1; i > 0; --i)
+	{
+		if (binCounts[i] > 0)
+		{
+			if (sideCount == 0)
+			{
+				bounds = binBounds[i];
+			}
+			else
+			{
+				bounds.Combine(binBounds[i]);
+			}
+			sideCount += binCounts[i];
+		}
+		rightCost[i] = sideCount > 0 ? bounds.GetPerimeter() * sideCount : 0.0f;
+	}
+
+	// Sweep from the left and pick the cheapest plane with leaves on both sides.
+	int32 bestSplit = -1;
+	float32 bestCost = b2_maxFloat;
+	sideCount = 0;
+	for (int32 i = 0; i < binCount - 1; ++i)
+	{
+		if (binCounts[i] > 0)
+		{
+			if (sideCount == 0)
+			{
+				bounds = binBounds[i];
+			}
+			else
+			{
+				bounds.Combine(binBounds[i]);
+			}
+			sideCount += binCounts[i];
+		}
+
+		if (sideCount == 0 || sideCount == count)
+		{
+			continue;
+		}
+
+		float32 cost = bounds.GetPerimeter() * sideCount + rightCost[i + 1];
+		if (cost < bestCost)
+		{
+			bestCost = cost;
+			bestSplit = i + 1;
+		}
+	}
+
+	// The extreme centers fall in the first and last bins, so a split always exists.
+	b2Assert(bestSplit > 0);
+
+	int32 first = 0;
+	int32 last = count - 1;
+	while (first <= last)
+	{
+		b2Vec2 c = m_nodes[leaves[first]].aabb.GetCenter();
+		int32 bin = b2Min(int32(((axis == 0 ? c.x : c.y) - minValue) * scale), binCount - 1);
+		if (bin < bestSplit)
+		{
+			++first;
+		}
+		else
+		{
+			b2Swap(leaves[first], leaves[last]);
+			--last;
+		}
+	}
+
+	return first;
+}
+
 void b2DynamicTree::DestroyProxy(int32 proxyId)
 {
 	b2Assert(0 <= proxyId && proxyId < m_nodeCapacity);
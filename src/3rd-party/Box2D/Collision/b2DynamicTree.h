@@ -70,6 +70,13 @@ public:
 	/// Create a proxy. Provide a tight fitting AABB and a userData pointer.
 	int32 CreateProxy(const b2AABB& aabb, void* userData);
 
+	/// Create proxies for many AABBs at once. The new proxies are built into a
+	/// subtree top-down with a binned surface area heuristic and the subtree is
+	/// inserted as a whole. This is faster than calling CreateProxy for each
+	/// AABB and gives a better tree.
+	/// @param proxyIds receives the proxy id of each AABB.
+	void CreateProxies(const b2AABB* aabbs, void* const* userData, int32 count, int32* proxyIds);
+
 	/// Destroy a proxy. This asserts if the id is invalid.
 	void DestroyProxy(int32 proxyId);
 
@@ -125,12 +132,17 @@ public:
 
 private:
 
+	friend class b2WorldSnapshot;
+
 	int32 AllocateNode();
 	void FreeNode(int32 node);
 
 	void InsertLeaf(int32 node);
 	void RemoveLeaf(int32 node);
 
+	int32 BuildTopDown(int32* leaves, int32 count);
+	int32 PartitionLeaves(int32* leaves, int32 count) const;
+
 	int32 Balance(int32 index);
 
 	int32 ComputeHeight() const;
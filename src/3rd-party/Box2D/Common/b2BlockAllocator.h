@@ -46,6 +46,9 @@ public:
 
 	void Clear();
 
+	/// Get the number of chunks, each chunk is b2_chunkSize bytes.
+	int32 GetChunkCount() const { return m_chunkCount; }
+
 private:
 
 	b2Chunk* m_chunks;
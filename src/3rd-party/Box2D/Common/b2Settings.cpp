@@ -23,14 +23,35 @@
 
 b2Version b2_version = {2, 3, 2};
 
-// Memory allocators. Modify these to use your own allocator.
+static b2AllocFcn b2_allocFcn = nullptr;
+static b2FreeFcn b2_freeFcn = nullptr;
+static void* b2_allocUserData = nullptr;
+
+void b2SetAllocator(b2AllocFcn allocFcn, b2FreeFcn freeFcn, void* userData)
+{
+	b2Assert((allocFcn == nullptr) == (freeFcn == nullptr));
+	b2_allocFcn = allocFcn;
+	b2_freeFcn = freeFcn;
+	b2_allocUserData = userData;
+}
+
+// Memory allocators. Use b2SetAllocator to use your own allocator.
 void* b2Alloc(int32 size)
 {
+	if (b2_allocFcn)
+	{
+		return b2_allocFcn(size, b2_allocUserData);
+	}
 	return malloc(size);
 }
 
 void b2Free(void* mem)
 {
+	if (b2_freeFcn)
+	{
+		b2_freeFcn(mem, b2_allocUserData);
+		return;
+	}
 	free(mem);
 }
 
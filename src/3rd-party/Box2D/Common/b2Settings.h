@@ -131,10 +131,19 @@ typedef double float64;
 
 // Memory Allocation
 
-/// Implement this function to use your own memory allocator.
+/// Memory allocation hooks, see b2SetAllocator.
+typedef void* (*b2AllocFcn)(int32 size, void* userData);
+typedef void (*b2FreeFcn)(void* mem, void* userData);
+
+/// Route b2Alloc and b2Free through your own allocator. Pass nullptr to use
+/// malloc and free again. Call this before any Box2D memory is allocated, memory
+/// must be freed by the allocator that allocated it.
+void b2SetAllocator(b2AllocFcn allocFcn, b2FreeFcn freeFcn, void* userData);
+
+/// Allocate memory with the current allocator.
 void* b2Alloc(int32 size);
 
-/// If you implement b2Alloc, you should also implement this function.
+/// Free memory allocated by b2Alloc.
 void b2Free(void* mem);
 
 /// Logging function.
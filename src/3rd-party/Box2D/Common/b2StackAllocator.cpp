@@ -21,7 +21,10 @@
 
 b2StackAllocator::b2StackAllocator()
 {
+	m_data = (char*)b2Alloc(b2_stackSize);
+	m_capacity = b2_stackSize;
 	m_index = 0;
+	m_overflowCount = 0;
 	m_allocation = 0;
 	m_maxAllocation = 0;
 	m_entryCount = 0;
@@ -31,6 +34,7 @@ b2StackAllocator::~b2StackAllocator()
 {
 	b2Assert(m_index == 0);
 	b2Assert(m_entryCount == 0);
+	b2Free(m_data);
 }
 
 void* b2StackAllocator::Allocate(int32 size)
@@ -39,10 +43,11 @@ void* b2StackAllocator::Allocate(int32 size)
 
 	b2StackEntry* entry = m_entries + m_entryCount;
 	entry->size = size;
-	if (m_index + size > b2_stackSize)
+	if (m_index + size > m_capacity)
 	{
 		entry->data = (char*)b2Alloc(size);
 		entry->usedMalloc = true;
+		++m_overflowCount;
 	}
 	else
 	{
@@ -81,3 +86,28 @@ int32 b2StackAllocator::GetMaxAllocation() const
 {
 	return m_maxAllocation;
 }
+
+void b2StackAllocator::Grow()
+{
+	b2Assert(m_entryCount == 0);
+	if (m_entryCount > 0 || m_maxAllocation <= m_capacity)
+	{
+		return;
+	}
+
+	// Leave some room so a slowly growing scene does not resize every step.
+	int32 capacity = m_maxAllocation + m_maxAllocation / 4;
+	b2Free(m_data);
+	m_data = (char*)b2Alloc(capacity);
+	m_capacity = capacity;
+}
+
+int32 b2StackAllocator::GetCapacity() const
+{
+	return m_capacity;
+}
+
+int32 b2StackAllocator::GetOverflowCount() const
+{
+	return m_overflowCount;
+}
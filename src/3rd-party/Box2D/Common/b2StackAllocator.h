@@ -21,7 +21,7 @@
 
 #include "b2Settings.h"
 
-const int32 b2_stackSize = 100 * 1024;	// 100k
+const int32 b2_stackSize = 100 * 1024;	// 100k initial capacity
 const int32 b2_maxStackEntries = 32;
 
 struct b2StackEntry
@@ -45,10 +45,22 @@ public:
 
 	int32 GetMaxAllocation() const;
 
+	/// Grow the arena to fit the largest total allocation seen so far, so the
+	/// next steps do not fall back to b2Alloc. Only valid when nothing is allocated.
+	void Grow();
+
+	/// Get the arena size in bytes.
+	int32 GetCapacity() const;
+
+	/// Get the number of allocations that did not fit in the arena and used b2Alloc.
+	int32 GetOverflowCount() const;
+
 private:
 
-	char m_data[b2_stackSize];
+	char* m_data;
+	int32 m_capacity;
 	int32 m_index;
+	int32 m_overflowCount;
 
 	int32 m_allocation;
 	int32 m_maxAllocation;
@@ -27,6 +27,15 @@ class b2Contact;
 class b2Body;
 class b2StackAllocator;
 struct b2ContactPositionConstraint;
+struct b2WideContactBatch;
+struct b2WideContactConstraint;
+
+// The wide contact solver uses SSE2 to solve four contacts at once.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define B2_WIDE_CONTACT_SOLVER 1
+#else
+#define B2_WIDE_CONTACT_SOLVER 0
+#endif
 
 struct b2VelocityConstraintPoint
 {
@@ -81,6 +90,11 @@ public:
 	bool SolvePositionConstraints();
 	bool SolveTOIPositionConstraints(int32 toiIndexA, int32 toiIndexB);
 
+	// Wide contact solver, see b2WideContactSolver.cpp.
+	void InitializeWideConstraints();
+	void SolveWideVelocityConstraints();
+	void StoreWideImpulses();
+
 	b2TimeStep m_step;
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
@@ -89,6 +103,9 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+	b2WideContactBatch* m_wideBatches;
+	b2WideContactConstraint* m_wideConstraints;
+	int32 m_wideCount;
 };
 
 #endif
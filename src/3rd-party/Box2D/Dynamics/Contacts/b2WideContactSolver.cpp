@@ -0,0 +1,483 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Box2D/Dynamics/Contacts/b2ContactSolver.h"
+#include "Box2D/Common/b2StackAllocator.h"
+
+#include <string.h>
+
+#if B2_WIDE_CONTACT_SOLVER
+
+#include <emmintrin.h>
+
+#define b2_wideLanes 4
+
+// Number of partially filled batches per point count that are searched for a
+// free lane. Keeps the coloring linear in the number of contacts.
+#define b2_wideOpenBatches 8
+
+// The contacts solved together. No dynamic body appears twice in a batch.
+struct b2WideContactBatch
+{
+	int32 constraints[b2_wideLanes];
+	int32 bodies[2 * b2_wideLanes];
+	int32 count;
+	int32 pointCount;
+};
+
+struct b2WideConstraintPoint
+{
+	float32 rAx[b2_wideLanes], rAy[b2_wideLanes];
+	float32 rBx[b2_wideLanes], rBy[b2_wideLanes];
+	float32 normalImpulse[b2_wideLanes];
+	float32 tangentImpulse[b2_wideLanes];
+	float32 normalMass[b2_wideLanes];
+	float32 tangentMass[b2_wideLanes];
+	float32 velocityBias[b2_wideLanes];
+};
+
+// Structure of arrays copy of b2ContactVelocityConstraint. Empty lanes have
+// zero mass and index -1, so they produce zero impulses.
+struct b2WideContactConstraint
+{
+	b2WideConstraintPoint points[b2_maxManifoldPoints];
+	float32 normalX[b2_wideLanes], normalY[b2_wideLanes];
+	float32 k11[b2_wideLanes], k12[b2_wideLanes], k22[b2_wideLanes];
+	float32 normalMass11[b2_wideLanes], normalMass12[b2_wideLanes], normalMass22[b2_wideLanes];
+	float32 invMassA[b2_wideLanes], invIA[b2_wideLanes];
+	float32 invMassB[b2_wideLanes], invIB[b2_wideLanes];
+	float32 friction[b2_wideLanes];
+	float32 tangentSpeed[b2_wideLanes];
+	int32 indexA[b2_wideLanes], indexB[b2_wideLanes];
+	int32 pointCount;
+};
+
+static inline void b2GatherVelocities(const b2Velocity* velocities, const int32* indices, __m128* vx, __m128* vy, __m128* w)
+{
+	float32 x[b2_wideLanes], y[b2_wideLanes], a[b2_wideLanes];
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		int32 index = indices[i];
+		if (index >= 0)
+		{
+			x[i] = velocities[index].v.x;
+			y[i] = velocities[index].v.y;
+			a[i] = velocities[index].w;
+		}
+		else
+		{
+			x[i] = y[i] = a[i] = 0.0f;
+		}
+	}
+	*vx = _mm_loadu_ps(x);
+	*vy = _mm_loadu_ps(y);
+	*w = _mm_loadu_ps(a);
+}
+
+// Lanes may share a static or kinematic body. Its velocity is not changed by
+// the solver, so every lane writes back the same value.
+static inline void b2ScatterVelocities(b2Velocity* velocities, const int32* indices, __m128 vx, __m128 vy, __m128 w)
+{
+	float32 x[b2_wideLanes], y[b2_wideLanes], a[b2_wideLanes];
+	_mm_storeu_ps(x, vx);
+	_mm_storeu_ps(y, vy);
+	_mm_storeu_ps(a, w);
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		int32 index = indices[i];
+		if (index >= 0)
+		{
+			velocities[index].v.Set(x[i], y[i]);
+			velocities[index].w = a[i];
+		}
+	}
+}
+
+static inline __m128 b2WideSelect(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+void b2ContactSolver::InitializeWideConstraints()
+{
+	if (m_count == 0)
+	{
+		return;
+	}
+
+	m_wideBatches = (b2WideContactBatch*)m_allocator->Allocate(m_count * sizeof(b2WideContactBatch));
+
+	// Greedy graph coloring. Contacts with one and two points are kept in
+	// separate batches because they use different normal solvers.
+	int32 open[b2_maxManifoldPoints][b2_wideOpenBatches];
+	int32 openCount[b2_maxManifoldPoints] = { 0 };
+	int32 batchCount = 0;
+
+	for (int32 i = 0; i < m_count; ++i)
+	{
+		const b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
+
+		// Only bodies with mass are written by the solver.
+		int32 bodyA = (vc->invMassA > 0.0f || vc->invIA > 0.0f) ? vc->indexA : -1;
+		int32 bodyB = (vc->invMassB > 0.0f || vc->invIB > 0.0f) ? vc->indexB : -1;
+
+		int32* familyOpen = open[vc->pointCount - 1];
+		int32& familyCount = openCount[vc->pointCount - 1];
+
+		int32 slot = -1;
+		for (int32 j = 0; j < familyCount && slot < 0; ++j)
+		{
+			const b2WideContactBatch* batch = m_wideBatches + familyOpen[j];
+
+			bool conflict = false;
+			for (int32 k = 0; k < 2 * batch->count; ++k)
+			{
+				int32 body = batch->bodies[k];
+				if (body >= 0 && (body == bodyA || body == bodyB))
+				{
+					conflict = true;
+					break;
+				}
+			}
+
+			if (conflict == false)
+			{
+				slot = j;
+			}
+		}
+
+		if (slot < 0)
+		{
+			if (familyCount == b2_wideOpenBatches)
+			{
+				// Give up on the oldest batch, it is solved partially filled.
+				memmove(familyOpen, familyOpen + 1, (b2_wideOpenBatches - 1) * sizeof(int32));
+				--familyCount;
+			}
+
+			b2WideContactBatch* batch = m_wideBatches + batchCount;
+			batch->count = 0;
+			batch->pointCount = vc->pointCount;
+
+			slot = familyCount;
+			familyOpen[familyCount++] = batchCount++;
+		}
+
+		b2WideContactBatch* batch = m_wideBatches + familyOpen[slot];
+		batch->constraints[batch->count] = i;
+		batch->bodies[2 * batch->count + 0] = bodyA;
+		batch->bodies[2 * batch->count + 1] = bodyB;
+		++batch->count;
+
+		if (batch->count == b2_wideLanes)
+		{
+			memmove(familyOpen + slot, familyOpen + slot + 1, (familyCount - slot - 1) * sizeof(int32));
+			--familyCount;
+		}
+	}
+
+	m_wideCount = batchCount;
+	m_wideConstraints = (b2WideContactConstraint*)m_allocator->Allocate(m_wideCount * sizeof(b2WideContactConstraint));
+
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		const b2WideContactBatch* batch = m_wideBatches + i;
+		b2WideContactConstraint* wc = m_wideConstraints + i;
+
+		memset(wc, 0, sizeof(b2WideContactConstraint));
+		wc->pointCount = batch->pointCount;
+
+		for (int32 k = 0; k < b2_wideLanes; ++k)
+		{
+			if (k >= batch->count)
+			{
+				wc->indexA[k] = -1;
+				wc->indexB[k] = -1;
+				continue;
+			}
+
+			const b2ContactVelocityConstraint* vc = m_velocityConstraints + batch->constraints[k];
+
+			for (int32 j = 0; j < vc->pointCount; ++j)
+			{
+				const b2VelocityConstraintPoint* vcp = vc->points + j;
+				b2WideConstraintPoint* wcp = wc->points + j;
+
+				wcp->rAx[k] = vcp->rA.x;
+				wcp->rAy[k] = vcp->rA.y;
+				wcp->rBx[k] = vcp->rB.x;
+				wcp->rBy[k] = vcp->rB.y;
+				wcp->normalImpulse[k] = vcp->normalImpulse;
+				wcp->tangentImpulse[k] = vcp->tangentImpulse;
+				wcp->normalMass[k] = vcp->normalMass;
+				wcp->tangentMass[k] = vcp->tangentMass;
+				wcp->velocityBias[k] = vcp->velocityBias;
+			}
+
+			wc->normalX[k] = vc->normal.x;
+			wc->normalY[k] = vc->normal.y;
+			wc->k11[k] = vc->K.ex.x;
+			wc->k12[k] = vc->K.ex.y;
+			wc->k22[k] = vc->K.ey.y;
+			wc->normalMass11[k] = vc->normalMass.ex.x;
+			wc->normalMass12[k] = vc->normalMass.ey.x;
+			wc->normalMass22[k] = vc->normalMass.ey.y;
+			wc->invMassA[k] = vc->invMassA;
+			wc->invIA[k] = vc->invIA;
+			wc->invMassB[k] = vc->invMassB;
+			wc->invIB[k] = vc->invIB;
+			wc->friction[k] = vc->friction;
+			wc->tangentSpeed[k] = vc->tangentSpeed;
+			wc->indexA[k] = vc->indexA;
+			wc->indexB[k] = vc->indexB;
+		}
+	}
+}
+
+// Same math as b2ContactSolver::SolveVelocityConstraints, four contacts at a time.
+void b2ContactSolver::SolveWideVelocityConstraints()
+{
+	const __m128 zero = _mm_setzero_ps();
+
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		b2WideContactConstraint* wc = m_wideConstraints + i;
+
+		__m128 vAx, vAy, wA, vBx, vBy, wB;
+		b2GatherVelocities(m_velocities, wc->indexA, &vAx, &vAy, &wA);
+		b2GatherVelocities(m_velocities, wc->indexB, &vBx, &vBy, &wB);
+
+		const __m128 mA = _mm_loadu_ps(wc->invMassA);
+		const __m128 iA = _mm_loadu_ps(wc->invIA);
+		const __m128 mB = _mm_loadu_ps(wc->invMassB);
+		const __m128 iB = _mm_loadu_ps(wc->invIB);
+
+		const __m128 nx = _mm_loadu_ps(wc->normalX);
+		const __m128 ny = _mm_loadu_ps(wc->normalY);
+		const __m128 tx = ny;
+		const __m128 ty = _mm_sub_ps(zero, nx);
+		const __m128 friction = _mm_loadu_ps(wc->friction);
+		const __m128 tangentSpeed = _mm_loadu_ps(wc->tangentSpeed);
+
+		// Solve tangent constraints first because non-penetration is more important
+		// than friction.
+		for (int32 j = 0; j < wc->pointCount; ++j)
+		{
+			b2WideConstraintPoint* wcp = wc->points + j;
+
+			const __m128 rAx = _mm_loadu_ps(wcp->rAx);
+			const __m128 rAy = _mm_loadu_ps(wcp->rAy);
+			const __m128 rBx = _mm_loadu_ps(wcp->rBx);
+			const __m128 rBy = _mm_loadu_ps(wcp->rBy);
+
+			// Relative velocity at contact
+			__m128 dvx = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBx, _mm_mul_ps(wB, rBy)), vAx), _mm_mul_ps(wA, rAy));
+			__m128 dvy = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBy, _mm_mul_ps(wB, rBx)), vAy), _mm_mul_ps(wA, rAx));
+
+			// Compute tangent force
+			__m128 vt = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(dvx, tx), _mm_mul_ps(dvy, ty)), tangentSpeed);
+			__m128 lambda = _mm_mul_ps(_mm_loadu_ps(wcp->tangentMass), _mm_sub_ps(zero, vt));
+
+			// b2Clamp the accumulated force
+			__m128 tangentImpulse = _mm_loadu_ps(wcp->tangentImpulse);
+			__m128 maxFriction = _mm_mul_ps(friction, _mm_loadu_ps(wcp->normalImpulse));
+			__m128 newImpulse = _mm_max_ps(_mm_sub_ps(zero, maxFriction), _mm_min_ps(_mm_add_ps(tangentImpulse, lambda), maxFriction));
+			lambda = _mm_sub_ps(newImpulse, tangentImpulse);
+			_mm_storeu_ps(wcp->tangentImpulse, newImpulse);
+
+			// Apply contact impulse
+			__m128 Px = _mm_mul_ps(lambda, tx);
+			__m128 Py = _mm_mul_ps(lambda, ty);
+
+			vAx = _mm_sub_ps(vAx, _mm_mul_ps(mA, Px));
+			vAy = _mm_sub_ps(vAy, _mm_mul_ps(mA, Py));
+			wA = _mm_sub_ps(wA, _mm_mul_ps(iA, _mm_sub_ps(_mm_mul_ps(rAx, Py), _mm_mul_ps(rAy, Px))));
+
+			vBx = _mm_add_ps(vBx, _mm_mul_ps(mB, Px));
+			vBy = _mm_add_ps(vBy, _mm_mul_ps(mB, Py));
+			wB = _mm_add_ps(wB, _mm_mul_ps(iB, _mm_sub_ps(_mm_mul_ps(rBx, Py), _mm_mul_ps(rBy, Px))));
+		}
+
+		if (wc->pointCount == 1)
+		{
+			b2WideConstraintPoint* wcp = wc->points;
+
+			const __m128 rAx = _mm_loadu_ps(wcp->rAx);
+			const __m128 rAy = _mm_loadu_ps(wcp->rAy);
+			const __m128 rBx = _mm_loadu_ps(wcp->rBx);
+			const __m128 rBy = _mm_loadu_ps(wcp->rBy);
+
+			// Relative velocity at contact
+			__m128 dvx = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBx, _mm_mul_ps(wB, rBy)), vAx), _mm_mul_ps(wA, rAy));
+			__m128 dvy = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBy, _mm_mul_ps(wB, rBx)), vAy), _mm_mul_ps(wA, rAx));
+
+			// Compute normal impulse
+			__m128 vn = _mm_add_ps(_mm_mul_ps(dvx, nx), _mm_mul_ps(dvy, ny));
+			__m128 lambda = _mm_mul_ps(_mm_sub_ps(zero, _mm_loadu_ps(wcp->normalMass)), _mm_sub_ps(vn, _mm_loadu_ps(wcp->velocityBias)));
+
+			// b2Clamp the accumulated impulse
+			__m128 normalImpulse = _mm_loadu_ps(wcp->normalImpulse);
+			__m128 newImpulse = _mm_max_ps(_mm_add_ps(normalImpulse, lambda), zero);
+			lambda = _mm_sub_ps(newImpulse, normalImpulse);
+			_mm_storeu_ps(wcp->normalImpulse, newImpulse);
+
+			// Apply contact impulse
+			__m128 Px = _mm_mul_ps(lambda, nx);
+			__m128 Py = _mm_mul_ps(lambda, ny);
+
+			vAx = _mm_sub_ps(vAx, _mm_mul_ps(mA, Px));
+			vAy = _mm_sub_ps(vAy, _mm_mul_ps(mA, Py));
+			wA = _mm_sub_ps(wA, _mm_mul_ps(iA, _mm_sub_ps(_mm_mul_ps(rAx, Py), _mm_mul_ps(rAy, Px))));
+
+			vBx = _mm_add_ps(vBx, _mm_mul_ps(mB, Px));
+			vBy = _mm_add_ps(vBy, _mm_mul_ps(mB, Py));
+			wB = _mm_add_ps(wB, _mm_mul_ps(iB, _mm_sub_ps(_mm_mul_ps(rBx, Py), _mm_mul_ps(rBy, Px))));
+		}
+		else
+		{
+			// Block solver, see b2ContactSolver::SolveVelocityConstraints. All four
+			// cases are evaluated and the first valid one is selected per lane.
+			b2WideConstraintPoint* cp1 = wc->points + 0;
+			b2WideConstraintPoint* cp2 = wc->points + 1;
+
+			const __m128 rA1x = _mm_loadu_ps(cp1->rAx);
+			const __m128 rA1y = _mm_loadu_ps(cp1->rAy);
+			const __m128 rB1x = _mm_loadu_ps(cp1->rBx);
+			const __m128 rB1y = _mm_loadu_ps(cp1->rBy);
+			const __m128 rA2x = _mm_loadu_ps(cp2->rAx);
+			const __m128 rA2y = _mm_loadu_ps(cp2->rAy);
+			const __m128 rB2x = _mm_loadu_ps(cp2->rBx);
+			const __m128 rB2y = _mm_loadu_ps(cp2->rBy);
+
+			const __m128 a1 = _mm_loadu_ps(cp1->normalImpulse);
+			const __m128 a2 = _mm_loadu_ps(cp2->normalImpulse);
+
+			// Relative velocity at contact
+			__m128 dv1x = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBx, _mm_mul_ps(wB, rB1y)), vAx), _mm_mul_ps(wA, rA1y));
+			__m128 dv1y = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBy, _mm_mul_ps(wB, rB1x)), vAy), _mm_mul_ps(wA, rA1x));
+			__m128 dv2x = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(vBx, _mm_mul_ps(wB, rB2y)), vAx), _mm_mul_ps(wA, rA2y));
+			__m128 dv2y = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(vBy, _mm_mul_ps(wB, rB2x)), vAy), _mm_mul_ps(wA, rA2x));
+
+			// Compute normal velocity
+			__m128 vn1 = _mm_add_ps(_mm_mul_ps(dv1x, nx), _mm_mul_ps(dv1y, ny));
+			__m128 vn2 = _mm_add_ps(_mm_mul_ps(dv2x, nx), _mm_mul_ps(dv2y, ny));
+
+			// Compute b'
+			const __m128 k11 = _mm_loadu_ps(wc->k11);
+			const __m128 k12 = _mm_loadu_ps(wc->k12);
+			const __m128 k22 = _mm_loadu_ps(wc->k22);
+			__m128 b1 = _mm_sub_ps(_mm_sub_ps(vn1, _mm_loadu_ps(cp1->velocityBias)), _mm_add_ps(_mm_mul_ps(k11, a1), _mm_mul_ps(k12, a2)));
+			__m128 b2 = _mm_sub_ps(_mm_sub_ps(vn2, _mm_loadu_ps(cp2->velocityBias)), _mm_add_ps(_mm_mul_ps(k12, a1), _mm_mul_ps(k22, a2)));
+
+			// Case 1: vn = 0
+			const __m128 nm11 = _mm_loadu_ps(wc->normalMass11);
+			const __m128 nm12 = _mm_loadu_ps(wc->normalMass12);
+			const __m128 nm22 = _mm_loadu_ps(wc->normalMass22);
+			__m128 x1Case1 = _mm_sub_ps(zero, _mm_add_ps(_mm_mul_ps(nm11, b1), _mm_mul_ps(nm12, b2)));
+			__m128 x2Case1 = _mm_sub_ps(zero, _mm_add_ps(_mm_mul_ps(nm12, b1), _mm_mul_ps(nm22, b2)));
+			__m128 case1 = _mm_and_ps(_mm_cmpge_ps(x1Case1, zero), _mm_cmpge_ps(x2Case1, zero));
+
+			// Case 2: vn1 = 0 and x2 = 0
+			__m128 x1Case2 = _mm_mul_ps(_mm_sub_ps(zero, _mm_loadu_ps(cp1->normalMass)), b1);
+			__m128 vn2Case2 = _mm_add_ps(_mm_mul_ps(k12, x1Case2), b2);
+			__m128 case2 = _mm_and_ps(_mm_cmpge_ps(x1Case2, zero), _mm_cmpge_ps(vn2Case2, zero));
+
+			// Case 3: vn2 = 0 and x1 = 0
+			__m128 x2Case3 = _mm_mul_ps(_mm_sub_ps(zero, _mm_loadu_ps(cp2->normalMass)), b2);
+			__m128 vn1Case3 = _mm_add_ps(_mm_mul_ps(k12, x2Case3), b1);
+			__m128 case3 = _mm_and_ps(_mm_cmpge_ps(x2Case3, zero), _mm_cmpge_ps(vn1Case3, zero));
+
+			// Case 4: x1 = 0 and x2 = 0
+			__m128 case4 = _mm_and_ps(_mm_cmpge_ps(b1, zero), _mm_cmpge_ps(b2, zero));
+
+			// No valid case keeps the old impulse.
+			__m128 x1 = b2WideSelect(case4, zero, a1);
+			__m128 x2 = b2WideSelect(case4, zero, a2);
+			x1 = b2WideSelect(case3, zero, x1);
+			x2 = b2WideSelect(case3, x2Case3, x2);
+			x1 = b2WideSelect(case2, x1Case2, x1);
+			x2 = b2WideSelect(case2, zero, x2);
+			x1 = b2WideSelect(case1, x1Case1, x1);
+			x2 = b2WideSelect(case1, x2Case1, x2);
+
+			// Get the incremental impulse
+			__m128 d1 = _mm_sub_ps(x1, a1);
+			__m128 d2 = _mm_sub_ps(x2, a2);
+
+			// Apply incremental impulse
+			__m128 P1x = _mm_mul_ps(d1, nx);
+			__m128 P1y = _mm_mul_ps(d1, ny);
+			__m128 P2x = _mm_mul_ps(d2, nx);
+			__m128 P2y = _mm_mul_ps(d2, ny);
+
+			vAx = _mm_sub_ps(vAx, _mm_mul_ps(mA, _mm_add_ps(P1x, P2x)));
+			vAy = _mm_sub_ps(vAy, _mm_mul_ps(mA, _mm_add_ps(P1y, P2y)));
+			wA = _mm_sub_ps(wA, _mm_mul_ps(iA, _mm_add_ps(
+				_mm_sub_ps(_mm_mul_ps(rA1x, P1y), _mm_mul_ps(rA1y, P1x)),
+				_mm_sub_ps(_mm_mul_ps(rA2x, P2y), _mm_mul_ps(rA2y, P2x)))));
+
+			vBx = _mm_add_ps(vBx, _mm_mul_ps(mB, _mm_add_ps(P1x, P2x)));
+			vBy = _mm_add_ps(vBy, _mm_mul_ps(mB, _mm_add_ps(P1y, P2y)));
+			wB = _mm_add_ps(wB, _mm_mul_ps(iB, _mm_add_ps(
+				_mm_sub_ps(_mm_mul_ps(rB1x, P1y), _mm_mul_ps(rB1y, P1x)),
+				_mm_sub_ps(_mm_mul_ps(rB2x, P2y), _mm_mul_ps(rB2y, P2x)))));
+
+			// Accumulate
+			_mm_storeu_ps(cp1->normalImpulse, x1);
+			_mm_storeu_ps(cp2->normalImpulse, x2);
+		}
+
+		b2ScatterVelocities(m_velocities, wc->indexA, vAx, vAy, wA);
+		b2ScatterVelocities(m_velocities, wc->indexB, vBx, vBy, wB);
+	}
+}
+
+void b2ContactSolver::StoreWideImpulses()
+{
+	for (int32 i = 0; i < m_wideCount; ++i)
+	{
+		const b2WideContactBatch* batch = m_wideBatches + i;
+		const b2WideContactConstraint* wc = m_wideConstraints + i;
+
+		for (int32 k = 0; k < batch->count; ++k)
+		{
+			b2ContactVelocityConstraint* vc = m_velocityConstraints + batch->constraints[k];
+			for (int32 j = 0; j < vc->pointCount; ++j)
+			{
+				vc->points[j].normalImpulse = wc->points[j].normalImpulse[k];
+				vc->points[j].tangentImpulse = wc->points[j].tangentImpulse[k];
+			}
+		}
+	}
+}
+
+#else
+
+void b2ContactSolver::InitializeWideConstraints()
+{
+}
+
+void b2ContactSolver::SolveWideVelocityConstraints()
+{
+}
+
+void b2ContactSolver::StoreWideImpulses()
+{
+}
+
+#endif
@@ -83,6 +83,9 @@ b2Body::b2Body(const b2BodyDef* bd, b2World* world)
 
 	m_sleepTime = 0.0f;
 
+	m_stepInterval = 1;
+	m_stepPhase = 0;
+
 	m_type = bd->type;
 
 	if (m_type == b2_dynamicBody)
@@ -211,6 +214,130 @@ b2Fixture* b2Body::CreateFixture(const b2Shape* shape, float32 density)
 	return CreateFixture(&def);
 }
 
+void b2Body::CreateFixtures(const b2FixtureDef* defs, int32 count, b2Fixture** fixtures)
+{
+	b2Assert(m_world->IsLocked() == false);
+	if (m_world->IsLocked() == true || count <= 0)
+	{
+		return;
+	}
+
+	b2BlockAllocator* allocator = &m_world->m_blockAllocator;
+
+	bool resetMass = false;
+	int32 proxyCount = 0;
+	for (int32 i = 0; i < count; ++i)
+	{
+		void* memory = allocator->Allocate(sizeof(b2Fixture));
+		b2Fixture* fixture = new (memory) b2Fixture;
+		fixture->Create(allocator, this, defs + i);
+
+		fixture->m_next = m_fixtureList;
+		m_fixtureList = fixture;
+		++m_fixtureCount;
+
+		fixture->m_body = this;
+
+		resetMass = resetMass || fixture->m_density > 0.0f;
+		proxyCount += fixture->m_shape->GetChildCount();
+
+		if (fixtures)
+		{
+			fixtures[i] = fixture;
+		}
+	}
+
+	if (m_flags & e_activeFlag)
+	{
+		b2StackAllocator* stackAllocator = &m_world->m_stackAllocator;
+		b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
+
+		b2AABB* aabbs = (b2AABB*)stackAllocator->Allocate(proxyCount * sizeof(b2AABB));
+		void** userData = (void**)stackAllocator->Allocate(proxyCount * sizeof(void*));
+		int32* proxyIds = (int32*)stackAllocator->Allocate(proxyCount * sizeof(int32));
+
+		// The new fixtures are at the front of the list.
+		int32 index = 0;
+		b2Fixture* fixture = m_fixtureList;
+		for (int32 i = 0; i < count; ++i, fixture = fixture->m_next)
+		{
+			fixture->m_proxyCount = fixture->m_shape->GetChildCount();
+			for (int32 j = 0; j < fixture->m_proxyCount; ++j)
+			{
+				b2FixtureProxy* proxy = fixture->m_proxies + j;
+				fixture->m_shape->ComputeAABB(&proxy->aabb, m_xf, j);
+				proxy->fixture = fixture;
+				proxy->childIndex = j;
+
+				aabbs[index] = proxy->aabb;
+				userData[index] = proxy;
+				++index;
+			}
+		}
+
+		broadPhase->CreateProxies(aabbs, userData, proxyCount, proxyIds);
+
+		for (int32 i = 0; i < proxyCount; ++i)
+		{
+			((b2FixtureProxy*)userData[i])->proxyId = proxyIds[i];
+		}
+
+		// Static proxies never pair with each other, so for a static body it is
+		// enough to search from the non-static proxies if there are fewer of them.
+		int32 otherCount = 0;
+		if (m_type == b2_staticBody)
+		{
+			for (b2Body* b = m_world->m_bodyList; b && otherCount < proxyCount; b = b->m_next)
+			{
+				if (b->m_type != b2_staticBody)
+				{
+					for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+					{
+						otherCount += f->m_proxyCount;
+					}
+				}
+			}
+		}
+
+		if (m_type == b2_staticBody && otherCount < proxyCount)
+		{
+			for (b2Body* b = m_world->m_bodyList; b; b = b->m_next)
+			{
+				if (b->m_type != b2_staticBody)
+				{
+					for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+					{
+						for (int32 i = 0; i < f->m_proxyCount; ++i)
+						{
+							broadPhase->TouchProxy(f->m_proxies[i].proxyId);
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			for (int32 i = 0; i < proxyCount; ++i)
+			{
+				broadPhase->TouchProxy(proxyIds[i]);
+			}
+		}
+
+		stackAllocator->Free(proxyIds);
+		stackAllocator->Free(userData);
+		stackAllocator->Free(aabbs);
+	}
+
+	// Adjust mass properties if needed.
+	if (resetMass)
+	{
+		ResetMassData();
+	}
+
+	// Let the world know we have new fixtures.
+	m_world->m_flags |= b2World::e_newFixture;
+}
+
 void b2Body::DestroyFixture(b2Fixture* fixture)
 {
 	if (fixture == NULL)
@@ -436,6 +563,9 @@ void b2Body::SetTransform(const b2Vec2& position, float32 angle)
 	m_sweep.c0 = m_sweep.c;
 	m_sweep.a0 = angle;
 
+	// The contacts of this body must be updated again.
+	m_flags &= ~e_skippedFlag;
+
 	b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
 	for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
 	{
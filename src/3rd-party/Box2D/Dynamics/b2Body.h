@@ -146,6 +146,17 @@ public:
 	/// @warning This function is locked during callbacks.
 	b2Fixture* CreateFixture(const b2Shape* shape, float32 density);
 
+	/// Creates many fixtures at once. This is faster than calling CreateFixture
+	/// for each definition: the broad-phase proxies are built top-down in one pass
+	/// and the mass is updated once. For a static body, new pairs are searched
+	/// from the non-static proxies of the world when there are fewer of them.
+	/// Contacts are not created until the next time step.
+	/// @param defs the fixture definitions.
+	/// @param count the number of fixture definitions.
+	/// @param fixtures optional array that receives the created fixtures.
+	/// @warning This function is locked during callbacks.
+	void CreateFixtures(const b2FixtureDef* defs, int32 count, b2Fixture** fixtures = nullptr);
+
 	/// Destroy a fixture. This removes the fixture from the broad-phase and
 	/// destroys all contacts associated with this fixture. This will
 	/// automatically adjust the mass of the body if the body is dynamic and the
@@ -324,6 +335,19 @@ public:
 	/// Is this body allowed to sleep
 	bool IsSleepingAllowed() const;
 
+	/// Set how often this body is simulated. An interval of 1 simulates the body every
+	/// step. An interval of n simulates it every n-th step with n times the time step,
+	/// and 0 freezes it. An island uses the smallest interval of its bodies, so a body
+	/// touching a body with a smaller interval is simulated at that rate. The narrow-phase
+	/// skips contacts between bodies that did not move in the last step, and bodies with
+	/// an interval other than 1 do not take part in continuous collision. Reduced rate
+	/// islands are spread over the steps of their interval, so they are not all solved
+	/// in the same step.
+	void SetStepInterval(int32 interval);
+
+	/// Get the step interval of this body.
+	int32 GetStepInterval() const;
+
 	/// Set the sleep state of the body. A sleeping body has very
 	/// low CPU cost.
 	/// @param flag set to true to wake the body, false to put it to sleep.
@@ -396,6 +420,7 @@ private:
 	friend class b2ContactManager;
 	friend class b2ContactSolver;
 	friend class b2Contact;
+	friend class b2WorldSnapshot;
 	
 	friend class b2DistanceJoint;
 	friend class b2FrictionJoint;
@@ -418,7 +443,9 @@ private:
 		e_bulletFlag		= 0x0008,
 		e_fixedRotationFlag	= 0x0010,
 		e_activeFlag		= 0x0020,
-		e_toiFlag			= 0x0040
+		e_toiFlag			= 0x0040,
+		e_skippedFlag		= 0x0080,
+		e_reducedRateFlag	= 0x0100
 	};
 
 	b2Body(const b2BodyDef* bd, b2World* world);
@@ -469,6 +496,11 @@ private:
 
 	float32 m_sleepTime;
 
+	int32 m_stepInterval;
+
+	// Offset of the steps this body is solved in when its island runs at a reduced rate.
+	uint32 m_stepPhase;
+
 	void* m_userData;
 };
 
@@ -687,6 +719,17 @@ inline bool b2Body::IsSleepingAllowed() const
 	return (m_flags & e_autoSleepFlag) == e_autoSleepFlag;
 }
 
+inline void b2Body::SetStepInterval(int32 interval)
+{
+	b2Assert(interval >= 0);
+	m_stepInterval = interval;
+}
+
+inline int32 b2Body::GetStepInterval() const
+{
+	return m_stepInterval;
+}
+
 inline b2Fixture* b2Body::GetFixtureList()
 {
 	return m_fixtureList;
@@ -143,6 +143,10 @@ void b2ContactManager::Collide()
 		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
 		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
 
+		// Bodies skipped by their step interval did not move.
+		activeA = activeA && (bodyA->m_flags & b2Body::e_skippedFlag) == 0;
+		activeB = activeB && (bodyB->m_flags & b2Body::e_skippedFlag) == 0;
+
 		// At least one body must be awake and it must be dynamic or kinematic.
 		if (activeA == false && activeB == false)
 		{
@@ -48,6 +48,7 @@ b2World::b2World(const b2Vec2& gravity)
 	m_warmStarting = true;
 	m_continuousPhysics = true;
 	m_subStepping = false;
+	m_wideContactSolver = false;
 
 	m_stepComplete = true;
 
@@ -61,6 +62,10 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+	m_islandCount = 0;
+	m_skippedIslandCount = 0;
+	m_stepCount = 0;
+	m_nextStepPhase = 0;
 }
 
 b2World::~b2World()
@@ -114,6 +119,7 @@ b2Body* b2World::CreateBody(const b2BodyDef* def)
 
 	void* mem = m_blockAllocator.Allocate(sizeof(b2Body));
 	b2Body* b = new (mem) b2Body(def, this);
+	b->m_stepPhase = m_nextStepPhase++;
 
 	// Add to world doubly linked list.
 	b->m_prev = nullptr;
@@ -388,6 +394,8 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
+	m_islandCount = 0;
+	m_skippedIslandCount = 0;
 
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
@@ -399,7 +407,7 @@ void b2World::Solve(const b2TimeStep& step)
 	// Clear all the island flags.
 	for (b2Body* b = m_bodyList; b; b = b->m_next)
 	{
-		b->m_flags &= ~b2Body::e_islandFlag;
+		b->m_flags &= ~(b2Body::e_islandFlag | b2Body::e_skippedFlag | b2Body::e_reducedRateFlag);
 	}
 	for (b2Contact* c = m_contactManager.m_contactList; c; c = c->m_next)
 	{
@@ -433,6 +441,7 @@ void b2World::Solve(const b2TimeStep& step)
 
 		// Reset island and stack.
 		island.Clear();
+		int32 interval = 0;
 		int32 stackCount = 0;
 		stack[stackCount++] = seed;
 		seed->m_flags |= b2Body::e_islandFlag;
@@ -455,6 +464,12 @@ void b2World::Solve(const b2TimeStep& step)
 				continue;
 			}
 
+			// The island is simulated at the rate of its fastest body.
+			if (b->m_stepInterval > 0 && (interval == 0 || b->m_stepInterval < interval))
+			{
+				interval = b->m_stepInterval;
+			}
+
 			// Search all contacts connected to this body.
 			for (b2ContactEdge* ce = b->m_contactList; ce; ce = ce->next)
 			{
@@ -527,8 +542,40 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
+		// Frozen islands and reduced rate islands out of phase keep their state. The phase
+		// comes from the seed body, the first island body in the body list, so it stays
+		// the same while the island keeps its bodies and reduced rate islands are spread
+		// evenly over the steps instead of all being solved in the same step.
+		if (interval == 0 || (interval > 1 && (m_stepCount + seed->m_stepPhase) % uint32(interval) != 0))
+		{
+			for (int32 i = 0; i < island.m_bodyCount; ++i)
+			{
+				b2Body* b = island.m_bodies[i];
+				if (b->GetType() == b2_staticBody)
+				{
+					b->m_flags &= ~b2Body::e_islandFlag;
+					continue;
+				}
+
+				// The body did not move in this step, keep it out of the TOI sweep.
+				b->m_flags |= b2Body::e_skippedFlag;
+				b->m_sweep.c0 = b->m_sweep.c;
+				b->m_sweep.a0 = b->m_sweep.a;
+			}
+			++m_skippedIslandCount;
+			continue;
+		}
+
+		b2TimeStep islandStep = step;
+		if (interval > 1)
+		{
+			islandStep.dt = step.dt * interval;
+			islandStep.inv_dt = step.inv_dt / interval;
+		}
+
 		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
+		island.Solve(&profile, islandStep, m_gravity, m_allowSleep);
+		++m_islandCount;
 		m_profile.solveInit += profile.solveInit;
 		m_profile.solveVelocity += profile.solveVelocity;
 		m_profile.solvePosition += profile.solvePosition;
@@ -542,10 +589,18 @@ void b2World::Solve(const b2TimeStep& step)
 			{
 				b->m_flags &= ~b2Body::e_islandFlag;
 			}
+			else if (interval > 1)
+			{
+				// The sweep spans several steps, keep the body out of the TOI sweep.
+				b->m_flags |= b2Body::e_reducedRateFlag;
+				b->m_sweep.c0 = b->m_sweep.c;
+				b->m_sweep.a0 = b->m_sweep.a;
+			}
 		}
 	}
 
 	m_stackAllocator.Free(stack);
+	++m_stepCount;
 
 	{
 		b2Timer timer;
@@ -553,7 +608,7 @@ void b2World::Solve(const b2TimeStep& step)
 		for (b2Body* b = m_bodyList; b; b = b->GetNext())
 		{
 			// If a body was not in an island then it did not move.
-			if ((b->m_flags & b2Body::e_islandFlag) == 0)
+			if ((b->m_flags & b2Body::e_islandFlag) == 0 || (b->m_flags & b2Body::e_skippedFlag) != 0)
 			{
 				continue;
 			}
@@ -643,6 +698,11 @@ void b2World::SolveTOI(const b2TimeStep& step)
 				bool activeA = bA->IsAwake() && typeA != b2_staticBody;
 				bool activeB = bB->IsAwake() && typeB != b2_staticBody;
 
+				// Bodies skipped or solved at a reduced rate do not use continuous collision.
+				const uint16 reducedFlags = b2Body::e_skippedFlag | b2Body::e_reducedRateFlag;
+				activeA = activeA && (bA->m_flags & reducedFlags) == 0;
+				activeB = activeB && (bB->m_flags & reducedFlags) == 0;
+
 				// Is at least one body active (awake and dynamic or kinematic)?
 				if (activeA == false && activeB == false)
 				{
@@ -860,13 +920,14 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		subStep.positionIterations = 20;
 		subStep.velocityIterations = step.velocityIterations;
 		subStep.warmStarting = false;
+		subStep.wideContactSolver = false;
 		island.SolveTOI(subStep, bA->m_islandIndex, bB->m_islandIndex);
 
 		// Reset island flags and synchronize broad-phase proxies.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
 		{
 			b2Body* body = island.m_bodies[i];
-			body->m_flags &= ~b2Body::e_islandFlag;
+			body->m_flags &= ~(b2Body::e_islandFlag | b2Body::e_skippedFlag | b2Body::e_reducedRateFlag);
 
 			if (body->m_type != b2_dynamicBody)
 			{
@@ -923,6 +984,7 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	step.dtRatio = m_inv_dt0 * dt;
 
 	step.warmStarting = m_warmStarting;
+	step.wideContactSolver = m_wideContactSolver;
 	
 	// Update contacts. This is where some contacts are destroyed.
 	{
@@ -959,6 +1021,9 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 
 	m_flags &= ~e_locked;
 
+	// Resize the stack arena between steps if the last step did not fit.
+	m_stackAllocator.Grow();
+
 	m_profile.step = stepTimer.GetMilliseconds();
 }
 
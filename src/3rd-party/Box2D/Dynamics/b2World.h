@@ -157,6 +157,13 @@ public:
 	void SetSubStepping(bool flag) { m_subStepping = flag; }
 	bool GetSubStepping() const { return m_subStepping; }
 
+	/// Enable/disable the wide contact solver. It colors the contact graph and
+	/// solves the velocity constraints of several contacts at once using SIMD.
+	/// The results differ slightly from the scalar solver because the contacts
+	/// are solved in a different order. Ignored on platforms without SSE2.
+	void SetWideContactSolver(bool flag) { m_wideContactSolver = flag; }
+	bool GetWideContactSolver() const { return m_wideContactSolver; }
+
 	/// Get the number of broad-phase proxies.
 	int32 GetProxyCount() const;
 
@@ -169,6 +176,13 @@ public:
 	/// Get the number of contacts (each may have 0 or more contact points).
 	int32 GetContactCount() const;
 
+	/// Get the number of islands solved in the last time step.
+	int32 GetIslandCount() const;
+
+	/// Get the number of islands skipped in the last time step because of the
+	/// step interval of their bodies. See b2Body::SetStepInterval.
+	int32 GetSkippedIslandCount() const;
+
 	/// Get the height of the dynamic tree.
 	int32 GetTreeHeight() const;
 
@@ -205,6 +219,12 @@ public:
 	/// Get the current profile.
 	const b2Profile& GetProfile() const;
 
+	/// Get the small object allocator. For memory statistics.
+	const b2BlockAllocator& GetBlockAllocator() const { return m_blockAllocator; }
+
+	/// Get the per step stack allocator. For memory statistics.
+	const b2StackAllocator& GetStackAllocator() const { return m_stackAllocator; }
+
 	/// Dump the world into the log file.
 	/// @warning this should be called outside of a time step.
 	void Dump();
@@ -223,6 +243,7 @@ private:
 	friend class b2Fixture;
 	friend class b2ContactManager;
 	friend class b2Controller;
+	friend class b2WorldSnapshot;
 
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
@@ -257,10 +278,19 @@ private:
 	bool m_warmStarting;
 	bool m_continuousPhysics;
 	bool m_subStepping;
+	bool m_wideContactSolver;
 
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+	int32 m_islandCount;
+	int32 m_skippedIslandCount;
+
+	// Counts solved steps, the phase of reduced rate bodies.
+	uint32 m_stepCount;
+
+	// Round-robin step phase handed to new bodies.
+	uint32 m_nextStepPhase;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -346,6 +376,16 @@ inline const b2ContactManager& b2World::GetContactManager() const
 	return m_contactManager;
 }
 
+inline int32 b2World::GetIslandCount() const
+{
+	return m_islandCount;
+}
+
+inline int32 b2World::GetSkippedIslandCount() const
+{
+	return m_skippedIslandCount;
+}
+
 inline const b2Profile& b2World::GetProfile() const
 {
 	return m_profile;
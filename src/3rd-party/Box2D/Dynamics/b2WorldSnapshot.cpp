@@ -0,0 +1,606 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "Box2D/Dynamics/b2WorldSnapshot.h"
+#include "Box2D/Dynamics/b2World.h"
+#include "Box2D/Dynamics/b2Body.h"
+#include "Box2D/Dynamics/b2Fixture.h"
+#include "Box2D/Dynamics/Contacts/b2Contact.h"
+#include "Box2D/Dynamics/Joints/b2DistanceJoint.h"
+#include "Box2D/Dynamics/Joints/b2FrictionJoint.h"
+#include "Box2D/Dynamics/Joints/b2GearJoint.h"
+#include "Box2D/Dynamics/Joints/b2MotorJoint.h"
+#include "Box2D/Dynamics/Joints/b2MouseJoint.h"
+#include "Box2D/Dynamics/Joints/b2PrismaticJoint.h"
+#include "Box2D/Dynamics/Joints/b2PulleyJoint.h"
+#include "Box2D/Dynamics/Joints/b2RevoluteJoint.h"
+#include "Box2D/Dynamics/Joints/b2RopeJoint.h"
+#include "Box2D/Dynamics/Joints/b2WeldJoint.h"
+#include "Box2D/Dynamics/Joints/b2WheelJoint.h"
+#include <string.h>
+
+namespace
+{
+	const uint32 b2_snapshotMagic = 0x53573242;	// "B2WS"
+	const uint32 b2_snapshotVersion = 2;
+
+	struct b2SnapshotHeader
+	{
+		uint32 magic;
+		uint32 version;
+		int32 bodyCount;
+		int32 fixtureCount;
+		int32 proxyCount;
+		int32 jointCount;
+		int32 contactCount;
+		int32 nodeCapacity;
+		int32 moveCount;
+	};
+
+	struct b2BodyState
+	{
+		int32 type;
+		uint16 flags;
+		int32 fixtureCount;
+		b2Transform xf;
+		b2Sweep sweep;
+		b2Vec2 linearVelocity;
+		float32 angularVelocity;
+		b2Vec2 force;
+		float32 torque;
+		float32 sleepTime;
+		int32 stepInterval;
+	};
+
+	struct b2ProxyState
+	{
+		b2AABB aabb;
+		int32 proxyId;
+	};
+
+	struct b2ContactState
+	{
+		int32 proxyIdA;
+		int32 proxyIdB;
+		uint32 flags;
+		b2Manifold manifold;
+		int32 toiCount;
+		float32 toi;
+		float32 friction;
+		float32 restitution;
+		float32 tangentSpeed;
+	};
+
+	struct b2TreeState
+	{
+		int32 root;
+		int32 nodeCount;
+		int32 freeList;
+		uint32 path;
+		int32 insertionCount;
+	};
+
+	struct b2WorldState
+	{
+		int32 flags;
+		float32 inv_dt0;
+		int32 stepComplete;
+		int32 proxyCount;
+		uint32 stepCount;
+	};
+
+	// Size of the joint object including the derived class data.
+	int32 b2GetJointSize(b2JointType type)
+	{
+		switch (type)
+		{
+		case e_distanceJoint:	return sizeof(b2DistanceJoint);
+		case e_frictionJoint:	return sizeof(b2FrictionJoint);
+		case e_gearJoint:		return sizeof(b2GearJoint);
+		case e_motorJoint:		return sizeof(b2MotorJoint);
+		case e_mouseJoint:		return sizeof(b2MouseJoint);
+		case e_prismaticJoint:	return sizeof(b2PrismaticJoint);
+		case e_pulleyJoint:		return sizeof(b2PulleyJoint);
+		case e_revoluteJoint:	return sizeof(b2RevoluteJoint);
+		case e_ropeJoint:		return sizeof(b2RopeJoint);
+		case e_weldJoint:		return sizeof(b2WeldJoint);
+		case e_wheelJoint:		return sizeof(b2WheelJoint);
+		default:				return 0;
+		}
+	}
+
+	// Derived joint data lives after the b2Joint base. b2Joint ends with a
+	// pointer so the derived members never share its tail padding.
+	int32 b2GetJointStateSize(b2JointType type)
+	{
+		int32 size = b2GetJointSize(type);
+		return size > 0 ? size - int32(sizeof(b2Joint)) : 0;
+	}
+
+	struct b2SnapshotReader
+	{
+		b2SnapshotReader(const uint8* data, int32 size) : m_data(data), m_size(size), m_offset(0) {}
+
+		template <typename T>
+		bool Read(T* value)
+		{
+			return Read(value, sizeof(T));
+		}
+
+		bool Read(void* data, int32 size)
+		{
+			const uint8* p = Skip(size);
+			if (p == nullptr)
+			{
+				return false;
+			}
+			memcpy(data, p, size);
+			return true;
+		}
+
+		const uint8* Skip(int32 size)
+		{
+			if (size < 0 || m_size - m_offset < size)
+			{
+				return nullptr;
+			}
+			const uint8* p = m_data + m_offset;
+			m_offset += size;
+			return p;
+		}
+
+		const uint8* m_data;
+		int32 m_size;
+		int32 m_offset;
+	};
+}
+
+b2WorldSnapshot::b2WorldSnapshot()
+{
+	m_data = nullptr;
+	m_size = 0;
+	m_capacity = 0;
+}
+
+b2WorldSnapshot::~b2WorldSnapshot()
+{
+	b2Free(m_data);
+}
+
+void b2WorldSnapshot::Reserve(int32 capacity)
+{
+	if (capacity <= m_capacity)
+	{
+		return;
+	}
+
+	int32 newCapacity = b2Max(capacity, 2 * m_capacity);
+	uint8* data = (uint8*)b2Alloc(newCapacity);
+	if (m_size > 0)
+	{
+		memcpy(data, m_data, m_size);
+	}
+	b2Free(m_data);
+	m_data = data;
+	m_capacity = newCapacity;
+}
+
+void b2WorldSnapshot::Write(const void* data, int32 size)
+{
+	Reserve(m_size + size);
+	memcpy(m_data + m_size, data, size);
+	m_size += size;
+}
+
+void b2WorldSnapshot::SetData(const uint8* data, int32 size)
+{
+	m_size = 0;
+	if (size > 0)
+	{
+		Write(data, size);
+	}
+}
+
+void b2WorldSnapshot::Save(const b2World* world)
+{
+	b2Assert(world->IsLocked() == false);
+
+	const b2ContactManager& cm = world->m_contactManager;
+	const b2BroadPhase& bp = cm.m_broadPhase;
+	const b2DynamicTree& tree = bp.m_tree;
+
+	b2SnapshotHeader header;
+	header.magic = b2_snapshotMagic;
+	header.version = b2_snapshotVersion;
+	header.bodyCount = world->m_bodyCount;
+	header.fixtureCount = 0;
+	header.proxyCount = 0;
+	header.jointCount = world->m_jointCount;
+	header.contactCount = cm.m_contactCount;
+	header.nodeCapacity = tree.m_nodeCapacity;
+	header.moveCount = bp.m_moveCount;
+
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		header.fixtureCount += b->m_fixtureCount;
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			header.proxyCount += f->m_proxyCount;
+		}
+	}
+
+	int32 jointBytes = 0;
+	for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		jointBytes += sizeof(int32) + b2GetJointStateSize(j->m_type);
+	}
+
+	m_size = 0;
+	Reserve(sizeof(b2SnapshotHeader)
+		+ header.bodyCount * sizeof(b2BodyState)
+		+ header.fixtureCount * sizeof(int32)
+		+ header.proxyCount * sizeof(b2ProxyState)
+		+ sizeof(b2TreeState) + header.nodeCapacity * sizeof(b2TreeNode)
+		+ header.moveCount * sizeof(int32)
+		+ sizeof(b2WorldState)
+		+ header.contactCount * sizeof(b2ContactState)
+		+ jointBytes);
+
+	Write(header);
+
+	// Bodies, then the proxies of their fixtures.
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2BodyState state = b2BodyState();
+		state.type = b->m_type;
+		state.flags = b->m_flags;
+		state.fixtureCount = b->m_fixtureCount;
+		state.xf = b->m_xf;
+		state.sweep = b->m_sweep;
+		state.linearVelocity = b->m_linearVelocity;
+		state.angularVelocity = b->m_angularVelocity;
+		state.force = b->m_force;
+		state.torque = b->m_torque;
+		state.sleepTime = b->m_sleepTime;
+		state.stepInterval = b->m_stepInterval;
+		Write(state);
+
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			Write(f->m_proxyCount);
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2ProxyState proxy = b2ProxyState();
+				proxy.aabb = f->m_proxies[i].aabb;
+				proxy.proxyId = f->m_proxies[i].proxyId;
+				Write(proxy);
+			}
+		}
+	}
+
+	// Broad-phase tree. The node user data is rebuilt from the proxies.
+	b2TreeState treeState;
+	treeState.root = tree.m_root;
+	treeState.nodeCount = tree.m_nodeCount;
+	treeState.freeList = tree.m_freeList;
+	treeState.path = tree.m_path;
+	treeState.insertionCount = tree.m_insertionCount;
+	Write(treeState);
+	Write(tree.m_nodes, tree.m_nodeCapacity * sizeof(b2TreeNode));
+	Write(bp.m_moveBuffer, bp.m_moveCount * sizeof(int32));
+
+	b2WorldState worldState;
+	worldState.flags = world->m_flags;
+	worldState.inv_dt0 = world->m_inv_dt0;
+	worldState.stepComplete = world->m_stepComplete ? 1 : 0;
+	worldState.proxyCount = bp.m_proxyCount;
+	worldState.stepCount = world->m_stepCount;
+	Write(worldState);
+
+	// Contacts in world list order. Fixtures are referenced by proxy id.
+	for (const b2Contact* c = cm.m_contactList; c; c = c->m_next)
+	{
+		b2ContactState state = b2ContactState();
+		state.proxyIdA = c->m_fixtureA->m_proxies[c->m_indexA].proxyId;
+		state.proxyIdB = c->m_fixtureB->m_proxies[c->m_indexB].proxyId;
+		state.flags = c->m_flags;
+		state.manifold = c->m_manifold;
+		state.toiCount = c->m_toiCount;
+		state.toi = c->m_toi;
+		state.friction = c->m_friction;
+		state.restitution = c->m_restitution;
+		state.tangentSpeed = c->m_tangentSpeed;
+		Write(state);
+	}
+
+	// Joints store the derived class data as raw bytes.
+	for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		int32 type = j->m_type;
+		Write(type);
+		Write((const uint8*)j + sizeof(b2Joint), b2GetJointStateSize(j->m_type));
+	}
+}
+
+bool b2WorldSnapshot::Validate(const b2World* world) const
+{
+	b2SnapshotReader reader(m_data, m_size);
+
+	b2SnapshotHeader header;
+	if (!reader.Read(&header) || header.magic != b2_snapshotMagic || header.version != b2_snapshotVersion)
+	{
+		return false;
+	}
+
+	if (header.bodyCount != world->m_bodyCount || header.jointCount != world->m_jointCount
+		|| header.contactCount < 0 || header.nodeCapacity <= 0 || header.moveCount < 0)
+	{
+		return false;
+	}
+
+	for (const b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2BodyState state;
+		if (!reader.Read(&state) || state.type != b->m_type || state.fixtureCount != b->m_fixtureCount
+			|| (state.flags & b2Body::e_activeFlag) != (b->m_flags & b2Body::e_activeFlag)
+			|| state.stepInterval < 0)
+		{
+			return false;
+		}
+
+		for (const b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			int32 proxyCount;
+			if (!reader.Read(&proxyCount) || proxyCount != f->m_proxyCount)
+			{
+				return false;
+			}
+
+			for (int32 i = 0; i < proxyCount; ++i)
+			{
+				b2ProxyState proxy = b2ProxyState();
+				if (!reader.Read(&proxy) || proxy.proxyId < 0 || proxy.proxyId >= header.nodeCapacity)
+				{
+					return false;
+				}
+			}
+		}
+	}
+
+	if (reader.Skip(sizeof(b2TreeState) + header.nodeCapacity * sizeof(b2TreeNode)) == nullptr
+		|| reader.Skip(header.moveCount * sizeof(int32)) == nullptr
+		|| reader.Skip(sizeof(b2WorldState)) == nullptr)
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < header.contactCount; ++i)
+	{
+		b2ContactState state;
+		if (!reader.Read(&state) || state.proxyIdA < 0 || state.proxyIdA >= header.nodeCapacity
+			|| state.proxyIdB < 0 || state.proxyIdB >= header.nodeCapacity)
+		{
+			return false;
+		}
+	}
+
+	for (const b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		int32 type;
+		if (!reader.Read(&type) || type != j->m_type || reader.Skip(b2GetJointStateSize(j->m_type)) == nullptr)
+		{
+			return false;
+		}
+	}
+
+	return reader.m_offset == reader.m_size;
+}
+
+bool b2WorldSnapshot::Restore(b2World* world) const
+{
+	b2Assert(world->IsLocked() == false);
+
+	if (Validate(world) == false)
+	{
+		return false;
+	}
+
+	b2ContactManager& cm = world->m_contactManager;
+	b2BroadPhase& bp = cm.m_broadPhase;
+	b2DynamicTree& tree = bp.m_tree;
+
+	// Drop the current contacts without reporting them.
+	b2ContactListener* listener = cm.m_contactListener;
+	cm.m_contactListener = nullptr;
+	while (cm.m_contactList)
+	{
+		cm.Destroy(cm.m_contactList);
+	}
+	cm.m_contactListener = listener;
+
+	b2SnapshotReader reader(m_data, m_size);
+
+	b2SnapshotHeader header;
+	reader.Read(&header);
+
+	// The tree nodes are needed to resolve the proxies, so locate them first.
+	if (tree.m_nodeCapacity != header.nodeCapacity)
+	{
+		b2Free(tree.m_nodes);
+		tree.m_nodes = (b2TreeNode*)b2Alloc(header.nodeCapacity * sizeof(b2TreeNode));
+		tree.m_nodeCapacity = header.nodeCapacity;
+	}
+
+	for (b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		b2BodyState state;
+		reader.Read(&state);
+		b->m_flags = state.flags;
+		b->m_xf = state.xf;
+		b->m_sweep = state.sweep;
+		b->m_linearVelocity = state.linearVelocity;
+		b->m_angularVelocity = state.angularVelocity;
+		b->m_force = state.force;
+		b->m_torque = state.torque;
+		b->m_sleepTime = state.sleepTime;
+		b->m_stepInterval = state.stepInterval;
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			reader.Skip(sizeof(int32));
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				b2ProxyState proxy = b2ProxyState();
+				reader.Read(&proxy);
+				f->m_proxies[i].aabb = proxy.aabb;
+				f->m_proxies[i].proxyId = proxy.proxyId;
+			}
+		}
+	}
+
+	b2TreeState treeState;
+	reader.Read(&treeState);
+	tree.m_root = treeState.root;
+	tree.m_nodeCount = treeState.nodeCount;
+	tree.m_freeList = treeState.freeList;
+	tree.m_path = treeState.path;
+	tree.m_insertionCount = treeState.insertionCount;
+	reader.Read(tree.m_nodes, header.nodeCapacity * sizeof(b2TreeNode));
+
+	for (int32 i = 0; i < header.nodeCapacity; ++i)
+	{
+		tree.m_nodes[i].userData = nullptr;
+	}
+
+	for (b2Body* b = world->m_bodyList; b; b = b->m_next)
+	{
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next)
+		{
+			for (int32 i = 0; i < f->m_proxyCount; ++i)
+			{
+				tree.m_nodes[f->m_proxies[i].proxyId].userData = f->m_proxies + i;
+			}
+		}
+	}
+
+	if (bp.m_moveCapacity < header.moveCount)
+	{
+		b2Free(bp.m_moveBuffer);
+		bp.m_moveBuffer = (int32*)b2Alloc(header.moveCount * sizeof(int32));
+		bp.m_moveCapacity = header.moveCount;
+	}
+	reader.Read(bp.m_moveBuffer, header.moveCount * sizeof(int32));
+	bp.m_moveCount = header.moveCount;
+
+	b2WorldState worldState;
+	reader.Read(&worldState);
+	world->m_flags = worldState.flags;
+	world->m_inv_dt0 = worldState.inv_dt0;
+	world->m_stepComplete = worldState.stepComplete != 0;
+	bp.m_proxyCount = worldState.proxyCount;
+	world->m_stepCount = worldState.stepCount;
+
+	// Contacts are pushed to the front of the lists, so create them in
+	// reverse to get the original world and body list order back.
+	const uint8* contacts = reader.Skip(header.contactCount * sizeof(b2ContactState));
+	for (int32 i = header.contactCount - 1; i >= 0; --i)
+	{
+		b2ContactState state;
+		memcpy(&state, contacts + i * sizeof(b2ContactState), sizeof(state));
+
+		b2FixtureProxy* proxyA = (b2FixtureProxy*)tree.GetUserData(state.proxyIdA);
+		b2FixtureProxy* proxyB = (b2FixtureProxy*)tree.GetUserData(state.proxyIdB);
+		if (proxyA == nullptr || proxyB == nullptr)
+		{
+			continue;
+		}
+
+		b2Contact* c = b2Contact::Create(proxyA->fixture, proxyA->childIndex, proxyB->fixture, proxyB->childIndex, &world->m_blockAllocator);
+		if (c == nullptr)
+		{
+			continue;
+		}
+
+		b2Body* bodyA = c->m_fixtureA->m_body;
+		b2Body* bodyB = c->m_fixtureB->m_body;
+
+		c->m_prev = nullptr;
+		c->m_next = cm.m_contactList;
+		if (cm.m_contactList != nullptr)
+		{
+			cm.m_contactList->m_prev = c;
+		}
+		cm.m_contactList = c;
+
+		c->m_nodeA.contact = c;
+		c->m_nodeA.other = bodyB;
+		c->m_nodeA.prev = nullptr;
+		c->m_nodeA.next = bodyA->m_contactList;
+		if (bodyA->m_contactList != nullptr)
+		{
+			bodyA->m_contactList->prev = &c->m_nodeA;
+		}
+		bodyA->m_contactList = &c->m_nodeA;
+
+		c->m_nodeB.contact = c;
+		c->m_nodeB.other = bodyA;
+		c->m_nodeB.prev = nullptr;
+		c->m_nodeB.next = bodyB->m_contactList;
+		if (bodyB->m_contactList != nullptr)
+		{
+			bodyB->m_contactList->prev = &c->m_nodeB;
+		}
+		bodyB->m_contactList = &c->m_nodeB;
+
+		c->m_flags = state.flags;
+		c->m_manifold = state.manifold;
+		c->m_toiCount = state.toiCount;
+		c->m_toi = state.toi;
+		c->m_friction = state.friction;
+		c->m_restitution = state.restitution;
+		c->m_tangentSpeed = state.tangentSpeed;
+
+		++cm.m_contactCount;
+	}
+
+	for (b2Joint* j = world->m_jointList; j; j = j->m_next)
+	{
+		reader.Skip(sizeof(int32));
+
+		if (j->m_type == e_gearJoint)
+		{
+			// Keep the references to the live joints and bodies.
+			b2GearJoint* gear = (b2GearJoint*)j;
+			b2Joint* joint1 = gear->m_joint1;
+			b2Joint* joint2 = gear->m_joint2;
+			b2Body* bodyC = gear->m_bodyC;
+			b2Body* bodyD = gear->m_bodyD;
+			reader.Read((uint8*)j + sizeof(b2Joint), b2GetJointStateSize(j->m_type));
+			gear->m_joint1 = joint1;
+			gear->m_joint2 = joint2;
+			gear->m_bodyC = bodyC;
+			gear->m_bodyD = bodyD;
+		}
+		else
+		{
+			reader.Read((uint8*)j + sizeof(b2Joint), b2GetJointStateSize(j->m_type));
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,76 @@
+/*
+* Copyright (c) 2006-2011 Erin Catto http://www.box2d.org
+*
+* This software is provided 'as-is', without any express or implied
+* warranty.  In no event will the authors be held liable for any damages
+* arising from the use of this software.
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+* 1. The origin of this software must not be misrepresented; you must not
+* claim that you wrote the original software. If you use this software
+* in a product, an acknowledgment in the product documentation would be
+* appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+* misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef B2_WORLD_SNAPSHOT_H
+#define B2_WORLD_SNAPSHOT_H
+
+#include "Box2D/Common/b2Settings.h"
+
+class b2World;
+
+/// A compact binary copy of the simulation state of a world. This holds the
+/// body motion and sleep state, the broad-phase tree, the contacts with their
+/// manifolds (and therefore the warm starting impulses) and the joint state.
+/// Restoring a snapshot and stepping again reproduces the original steps.
+/// The world must contain the same bodies, fixtures and joints, created in the
+/// same order, as when the snapshot was saved. Shapes, filters and other
+/// definition data are not stored.
+class b2WorldSnapshot
+{
+public:
+	b2WorldSnapshot();
+	~b2WorldSnapshot();
+
+	/// Capture the state of the world. The world must not be locked.
+	void Save(const b2World* world);
+
+	/// Restore the state of the world. Returns false if the world layout does
+	/// not match the snapshot. The world must not be locked.
+	/// No contact listener callbacks are issued while restoring.
+	bool Restore(b2World* world) const;
+
+	/// Get the snapshot bytes.
+	const uint8* GetData() const { return m_data; }
+
+	/// Get the snapshot size in bytes.
+	int32 GetSize() const { return m_size; }
+
+	/// Replace the snapshot with bytes previously returned by GetData.
+	void SetData(const uint8* data, int32 size);
+
+	/// Drop the snapshot bytes but keep the buffer.
+	void Clear() { m_size = 0; }
+
+private:
+
+	b2WorldSnapshot(const b2WorldSnapshot&);
+	b2WorldSnapshot& operator=(const b2WorldSnapshot&);
+
+	bool Validate(const b2World* world) const;
+	void Reserve(int32 capacity);
+	void Write(const void* data, int32 size);
+
+	template <typename T>
+	void Write(const T& value) { Write(&value, sizeof(T)); }
+
+	uint8* m_data;
+	int32 m_size;
+	int32 m_capacity;
+};
+
+#endif
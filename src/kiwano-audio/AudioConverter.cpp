@@ -0,0 +1,286 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-audio/AudioConverter.h>
+#include <kiwano/utils/Logger.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define KGE_CONVERTER_USE_SSE
+#endif
+
+namespace kiwano
+{
+namespace audio
+{
+namespace
+{
+
+class ConvertedAudioData : public AudioData
+{
+public:
+    ConvertedAudioData(Vector<uint8_t>&& raw, const AudioMeta& meta)
+        : raw_(std::move(raw))
+    {
+        data_ = BinaryData{ raw_.data(), raw_.size() };
+        meta_ = meta;
+    }
+
+    Vector<uint8_t> raw_;
+};
+
+bool IsSupportedOutput(const AudioMeta& meta)
+{
+    if (meta.channels != 1 && meta.channels != 2)
+        return false;
+    if (meta.samples_per_sec == 0)
+        return false;
+    return (meta.format == AudioFormat::PCM && meta.bits_per_sample == 16)
+           || (meta.format == AudioFormat::IEEEFloat && meta.bits_per_sample == 32);
+}
+
+void ConvertInt16ToFloat(float* out, const int16_t* src, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef KGE_CONVERTER_USE_SSE
+    const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i s  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = src[i] * (1.f / 32768.f);
+    }
+}
+
+void ConvertFloatToInt16(int16_t* out, const float* src, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef KGE_CONVERTER_USE_SSE
+    // _mm_packs_epi32 saturates the samples out of range
+    const __m128 scale = _mm_set1_ps(32767.f);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i lo = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i), scale));
+        __m128i hi = _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(lo, hi));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        const float s = std::min(std::max(src[i], -1.f), 1.f);
+        out[i]        = int16_t(std::lround(s * 32767.f));
+    }
+}
+
+// Keeps the first channels or duplicates a mono channel
+void ConvertChannels(Vector<float>& samples, uint32_t src_channels, uint32_t dst_channels)
+{
+    if (src_channels == dst_channels)
+        return;
+
+    const uint32_t frames = uint32_t(samples.size() / src_channels);
+
+    Vector<float> output(size_t(frames) * dst_channels);
+    if (dst_channels == 1)
+    {
+        // down-mix the front channels
+        const uint32_t mixed = std::min(src_channels, 2u);
+        const float    scale = 1.f / mixed;
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            float sum = 0.f;
+            for (uint32_t c = 0; c < mixed; ++c)
+                sum += samples[i * src_channels + c];
+            output[i] = sum * scale;
+        }
+    }
+    else
+    {
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            const float* src  = &samples[i * src_channels];
+            output[i * 2]     = src[0];
+            output[i * 2 + 1] = (src_channels > 1) ? src[1] : src[0];
+        }
+    }
+    samples.swap(output);
+}
+
+// Linear interpolation resampling of one channel, four output frames per iteration
+void ResampleChannel(float* out, const float* src, uint32_t src_frames, uint32_t channels, uint32_t channel,
+                     double step, uint32_t frames)
+{
+    const uint32_t last = src_frames - 1;
+
+    uint32_t i = 0;
+#ifdef KGE_CONVERTER_USE_SSE
+    for (; i + 4 <= frames; i += 4)
+    {
+        float a[4], b[4], t[4];
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            const double   pos   = step * (i + k);
+            const uint32_t index = std::min(uint32_t(pos), last);
+            const uint32_t next  = std::min(index + 1, last);
+
+            a[k] = src[index * channels + channel];
+            b[k] = src[next * channels + channel];
+            t[k] = float(pos - index);
+        }
+
+        __m128 va = _mm_loadu_ps(a);
+        __m128 vs = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), va), _mm_loadu_ps(t)));
+
+        float resampled[4];
+        _mm_storeu_ps(resampled, vs);
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            out[(i + k) * channels + channel] = resampled[k];
+        }
+    }
+#endif
+    for (; i < frames; ++i)
+    {
+        const double   pos   = step * i;
+        const uint32_t index = std::min(uint32_t(pos), last);
+        const uint32_t next  = std::min(index + 1, last);
+
+        const float a = src[index * channels + channel];
+        const float b = src[next * channels + channel];
+
+        out[i * channels + channel] = a + (b - a) * float(pos - index);
+    }
+}
+
+void Resample(Vector<float>& samples, uint32_t channels, uint32_t src_rate, uint32_t dst_rate)
+{
+    const uint32_t src_frames = uint32_t(samples.size() / channels);
+    if (src_rate == dst_rate || src_frames == 0)
+        return;
+
+    const uint32_t frames = uint32_t((uint64_t(src_frames) * dst_rate + src_rate - 1) / src_rate);
+    const double   step   = double(src_rate) / dst_rate;
+
+    Vector<float> output(size_t(frames) * channels);
+    for (uint32_t c = 0; c < channels; ++c)
+    {
+        ResampleChannel(output.data(), samples.data(), src_frames, channels, c, step, frames);
+    }
+    samples.swap(output);
+}
+
+}  // namespace
+
+bool ConvertToFloat(const AudioData& data, Vector<float>& output)
+{
+    const AudioMeta  meta   = data.GetMeta();
+    const BinaryData binary = data.GetData();
+    if (!binary.IsValid())
+        return false;
+
+    if (meta.format == AudioFormat::IEEEFloat && meta.bits_per_sample == 32)
+    {
+        const float* src = static_cast<const float*>(binary.buffer);
+        output.assign(src, src + binary.size / sizeof(float));
+        return true;
+    }
+
+    if (meta.format != AudioFormat::PCM)
+        return false;
+
+    if (meta.bits_per_sample == 16)
+    {
+        const uint32_t count = binary.size / sizeof(int16_t);
+        output.resize(count);
+        ConvertInt16ToFloat(output.data(), static_cast<const int16_t*>(binary.buffer), count);
+        return true;
+    }
+
+    if (meta.bits_per_sample == 8)
+    {
+        const uint8_t* src   = static_cast<const uint8_t*>(binary.buffer);
+        const uint32_t count = binary.size;
+        output.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            output[i] = (int(src[i]) - 128) * (1.f / 128.f);
+        }
+        return true;
+    }
+    return false;
+}
+
+RefPtr<AudioData> ConvertAudioData(RefPtr<AudioData> data, const AudioMeta& meta)
+{
+    if (!data || data->IsStreaming())
+    {
+        return data;
+    }
+
+    const AudioMeta src_meta = data->GetMeta();
+    if (src_meta.format == meta.format && src_meta.bits_per_sample == meta.bits_per_sample
+        && src_meta.channels == meta.channels && src_meta.samples_per_sec == meta.samples_per_sec)
+    {
+        return data;
+    }
+
+    if (!IsSupportedOutput(meta))
+    {
+        KGE_ERRORF("Audio data can only be converted to mono or stereo 16-bit PCM or 32-bit float");
+        return nullptr;
+    }
+
+    Vector<float> samples;
+    if (src_meta.channels == 0 || !ConvertToFloat(*data, samples))
+    {
+        KGE_ERRORF("Unsupported audio format for converting");
+        return nullptr;
+    }
+
+    ConvertChannels(samples, src_meta.channels, meta.channels);
+    Resample(samples, meta.channels, src_meta.samples_per_sec, meta.samples_per_sec);
+
+    AudioMeta output_meta   = meta;
+    output_meta.block_align = uint16_t(meta.channels * meta.bits_per_sample / 8);
+
+    const uint32_t  count = uint32_t(samples.size());
+    Vector<uint8_t> raw(size_t(count) * meta.bits_per_sample / 8);
+    if (meta.format == AudioFormat::IEEEFloat)
+    {
+        std::memcpy(raw.data(), samples.data(), raw.size());
+    }
+    else
+    {
+        ConvertFloatToInt16(reinterpret_cast<int16_t*>(raw.data()), samples.data(), count);
+    }
+
+    RefPtr<AudioData> output = new ConvertedAudioData(std::move(raw), output_meta);
+    return output;
+}
+
+}  // namespace audio
+}  // namespace kiwano
@@ -0,0 +1,58 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano-audio/AudioData.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+/**
+ * \addtogroup Audio
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ƵתΪ洢 32 λ
+ * @details ֧ 8/16 λ PCM  32 λʽ
+ * @param data Ƶ
+ * @param output ĸ
+ * @return Ƶʽ֧ʱ false
+ */
+bool ConvertToFloat(const AudioData& data, Vector<float>& output);
+
+/**
+ * \~chinese
+ * @brief תƵݵĸʽͲ
+ * @details ֧ 8/16 λ PCM  32 λʽ룬 16 λ PCM  32 λʽĵݡ
+ * ʹԲֵתݽǰ
+ * @param data Ƶ
+ * @param meta Ŀʽ
+ * @return תƵݣʽͬʱԭݣ֧תʱؿ
+ */
+RefPtr<AudioData> ConvertAudioData(RefPtr<AudioData> data, const AudioMeta& meta);
+
+/** @} */
+
+}  // namespace audio
+}  // namespace kiwano
@@ -40,5 +40,10 @@ BinaryData AudioData::GetData() const
     return data_;
 }
 
+bool AudioData::IsStreaming() const
+{
+    return false;
+}
+
 }  // namespace audio
 }  // namespace kiwano
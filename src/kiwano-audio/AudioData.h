@@ -39,7 +39,8 @@ namespace audio
  */
 enum class AudioFormat
 {
-    PCM,
+    PCM,        ///<  PCM
+    IEEEFloat,  ///< 32 λ PCM
 };
 
 /**
@@ -81,6 +82,10 @@ public:
     /// @brief ȡ
     BinaryData GetData() const;
 
+    /// \~chinese
+    /// @brief ǷΪƵ
+    virtual bool IsStreaming() const;
+
 protected:
     AudioData() = default;
 
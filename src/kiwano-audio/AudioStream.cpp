@@ -0,0 +1,426 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-audio/AudioStream.h>
+#include <kiwano-audio/Sound.h>
+#include <kiwano/platform/Application.h>
+#include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
+#include <xaudio2.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+bool AudioStream::IsStreaming() const
+{
+    return true;
+}
+
+AudioStreamQueue::AudioStreamQueue(RefPtr<AudioStream> stream, IXAudio2SourceVoice* voice,
+                                   RefPtr<SoundCallback> callback, uint32_t buffer_count, uint32_t buffer_size)
+    : stream_(stream)
+    , voice_(voice)
+    , callback_(callback)
+    , buffer_size_(buffer_size)
+    , head_(0)
+    , queued_(0)
+    , filled_(0)
+    , loops_remaining_(0)
+    , decode_finished_(false)
+    , first_pending_(true)
+    , generation_(0)
+    , running_(false)
+    , exiting_(false)
+    , busy_(false)
+    , flushing_(false)
+    , finished_(false)
+    , handle_(std::make_shared<AudioStreamQueue*>(this))
+{
+    KGE_ASSERT(stream_ && voice_ && buffer_count > 0);
+
+    // 룬һֵ֡
+    const uint32_t block_align = std::max<uint32_t>(stream_->GetMeta().block_align, 1);
+    buffer_size_               = std::max(buffer_size_ - buffer_size_ % block_align, block_align);
+
+    buffers_.resize(buffer_count);
+    for (auto& buffer : buffers_)
+    {
+        buffer.queue = this;
+        buffer.data.resize(buffer_size_);
+    }
+}
+
+AudioStreamQueue::~AudioStreamQueue()
+{
+    StopPlayback();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        exiting_ = true;
+    }
+    cond_.notify_all();
+
+    if (worker_.joinable())
+    {
+        worker_.join();
+    }
+
+    // ֻ߳٣δִе̻߳صٷʶ
+    *handle_ = nullptr;
+}
+
+void AudioStreamQueue::Prefetch()
+{
+    KGE_ASSERT(!running_ && "Prefetch() must not be called while the stream is playing");
+
+    const uint32_t count = uint32_t(buffers_.size());
+    while (!decode_finished_ && queued_ + filled_ < count)
+    {
+        Buffer& buffer = buffers_[(head_ + queued_ + filled_) % count];
+        Decode(buffer);
+
+        decode_finished_ = buffer.last;
+        if (buffer.size > 0)
+        {
+            ++filled_;
+        }
+    }
+}
+
+bool AudioStreamQueue::Start(int loop_count)
+{
+    bool need_rewind;
+    {
+        // Ԥʱ֪ѭѽ뵽ĩβҪ½
+        std::lock_guard<std::mutex> lock(mutex_);
+        need_rewind = running_ || finished_ || queued_ > 0 || (decode_finished_ && loop_count != 0);
+    }
+
+    if (need_rewind)
+    {
+        StopPlayback();
+        stream_->Seek(Duration());
+    }
+
+    loops_remaining_ = loop_count;
+    Prefetch();
+
+    if (filled_ == 0)
+    {
+        KGE_WARNF("Audio stream is empty");
+        return false;
+    }
+
+    StartWorker();
+
+    HRESULT hr = voice_->Start();
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Start voice failed with HRESULT of %08X", hr);
+        StopPlayback();
+        return false;
+    }
+    return true;
+}
+
+void AudioStreamQueue::Stop()
+{
+    StopPlayback();
+    stream_->Seek(Duration());
+    Prefetch();
+}
+
+bool AudioStreamQueue::Seek(Duration pos)
+{
+    bool was_running;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        was_running = running_;
+    }
+
+    StopPlayback();
+    if (!stream_->Seek(pos))
+    {
+        KGE_WARNF("Seeking audio stream failed");
+        return false;
+    }
+
+    Prefetch();
+
+    if (was_running)
+    {
+        if (filled_ == 0)
+            return true;
+
+        StartWorker();
+        return SUCCEEDED(voice_->Start());
+    }
+    return true;
+}
+
+bool AudioStreamQueue::IsFinished() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_;
+}
+
+void AudioStreamQueue::OnBufferStart(Buffer* buffer)
+{
+    if (!buffer->first)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!flushing_ && buffer->generation == generation_)
+    {
+        PostCallback(CallbackType::Start);
+    }
+}
+
+void AudioStreamQueue::OnBufferEnd(Buffer* buffer)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // ֹͣʱȴʱƵֹ֮ͣǰύĻ֮صʱѱ
+        if (buffer->generation != generation_)
+            return;
+
+        head_ = (head_ + 1) % uint32_t(buffers_.size());
+        --queued_;
+
+        if (!flushing_)
+        {
+            const bool ended = buffer->last || (decode_finished_ && queued_ == 0 && filled_ == 0);
+            finished_        = finished_ || ended;
+
+            if (buffer->loop_end)
+                PostCallback(CallbackType::LoopEnd);
+
+            if (ended)
+                PostCallback(CallbackType::End);
+        }
+    }
+    cond_.notify_all();
+}
+
+void AudioStreamQueue::StartWorker()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        KGE_ASSERT(!running_);
+
+        running_ = true;
+    }
+
+    if (!worker_.joinable())
+    {
+        worker_ = std::thread(&AudioStreamQueue::WorkerLoop, this);
+    }
+    cond_.notify_all();
+}
+
+void AudioStreamQueue::StopWorker()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    running_ = false;
+    cond_.notify_all();
+
+    // ȴ߳ڽеĽύ
+    cond_.wait(lock, [this]() { return !busy_; });
+}
+
+void AudioStreamQueue::StopPlayback()
+{
+    StopWorker();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushing_ = true;
+    }
+
+    voice_->Stop();
+    voice_->FlushSourceBuffers();
+
+    // ȴύĻȫգƵֹͣʱյص
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait_for(lock, std::chrono::milliseconds(500), [this]() { return queued_ == 0; });
+
+    // µĲŴʱŻصľɻ޸ļ
+    ++generation_;
+
+    head_            = 0;
+    queued_          = 0;
+    filled_          = 0;
+    loops_remaining_ = 0;
+    decode_finished_ = false;
+    first_pending_   = true;
+    flushing_        = false;
+    finished_        = false;
+}
+
+void AudioStreamQueue::WorkerLoop()
+{
+    Profiler::GetInstance().SetThreadName("Audio Stream");
+
+    const uint32_t count = uint32_t(buffers_.size());
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!exiting_)
+    {
+        if (!running_)
+        {
+            cond_.wait(lock);
+            continue;
+        }
+
+        if (filled_ > 0)
+        {
+            Buffer& buffer = buffers_[(head_ + queued_) % count];
+            buffer.generation = generation_;
+            --filled_;
+            ++queued_;
+
+            busy_ = true;
+            lock.unlock();
+            const bool submitted = Submit(buffer);
+            lock.lock();
+            busy_ = false;
+            cond_.notify_all();
+
+            if (!submitted)
+            {
+                --queued_;
+                running_ = false;
+            }
+            continue;
+        }
+
+        if (!decode_finished_ && queued_ + filled_ < count)
+        {
+            Buffer& buffer = buffers_[(head_ + queued_ + filled_) % count];
+
+            busy_ = true;
+            lock.unlock();
+            Decode(buffer);
+            lock.lock();
+            busy_ = false;
+            cond_.notify_all();
+
+            decode_finished_ = buffer.last;
+            if (buffer.size > 0)
+            {
+                ++filled_;
+            }
+            else if (buffer.last && queued_ == 0 && !finished_)
+            {
+                // ĩβĿջύʱлѲϣɹ߳̽
+                finished_ = true;
+                PostCallback(CallbackType::End);
+            }
+            continue;
+        }
+
+        cond_.wait(lock);
+    }
+}
+
+void AudioStreamQueue::PostCallback(CallbackType type)
+{
+    // Դ̺߳͹̶ֱִ߳ƵصͳһͶݵִ߳Уֹͣ²źִ
+    auto           handle     = handle_;
+    const uint32_t generation = generation_;
+    Application::GetInstance().PerformInMainThread([handle, generation, type]() {
+        AudioStreamQueue* queue = *handle;
+        if (!queue || queue->generation_ != generation)
+            return;
+
+        switch (type)
+        {
+        case CallbackType::Start:
+            queue->callback_->OnStart(nullptr);
+            break;
+        case CallbackType::LoopEnd:
+            queue->callback_->OnLoopEnd(nullptr);
+            break;
+        case CallbackType::End:
+            queue->callback_->OnEnd(nullptr);
+            break;
+        }
+    });
+}
+
+void AudioStreamQueue::Decode(Buffer& buffer)
+{
+    KGE_PROFILE_SCOPE("audio::AudioStreamQueue::Decode");
+
+    buffer.size     = 0;
+    buffer.first    = first_pending_;
+    buffer.last     = false;
+    buffer.loop_end = false;
+    first_pending_  = false;
+
+    bool rewound = false;
+    while (buffer.size < buffer_size_)
+    {
+        const uint32_t bytes_read = stream_->Read(buffer.data.data() + buffer.size, buffer_size_ - buffer.size);
+        if (bytes_read > 0)
+        {
+            buffer.size += bytes_read;
+            rewound = false;
+            continue;
+        }
+
+        // ĩβҪѭʱصͷ룬ʹβͬһν
+        if (loops_remaining_ != 0 && !rewound && stream_->Seek(Duration()))
+        {
+            if (loops_remaining_ > 0)
+                --loops_remaining_;
+
+            buffer.loop_end = true;
+            rewound         = true;
+            continue;
+        }
+
+        buffer.last = true;
+        break;
+    }
+}
+
+bool AudioStreamQueue::Submit(Buffer& buffer)
+{
+    XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+    xaudio2_buffer.pAudioData     = buffer.data.data();
+    xaudio2_buffer.AudioBytes     = UINT32(buffer.size);
+    xaudio2_buffer.Flags          = buffer.last ? XAUDIO2_END_OF_STREAM : 0;
+    xaudio2_buffer.pContext       = &buffer;
+
+    HRESULT hr = voice_->SubmitSourceBuffer(&xaudio2_buffer);
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Submitting stream buffer failed with HRESULT of %08X", hr);
+        return false;
+    }
+    return true;
+}
+
+}  // namespace audio
+}  // namespace kiwano
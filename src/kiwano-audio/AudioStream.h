@@ -0,0 +1,192 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano-audio/AudioData.h>
+#include <kiwano/core/Duration.h>
+#include <thread>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+struct IXAudio2SourceVoice;
+
+namespace kiwano
+{
+namespace audio
+{
+
+class SoundCallback;
+
+/**
+ * \addtogroup Audio
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief Ƶ
+ * @details Ƶڲʱν룬ڴռƵʱ޹ء
+ * ƵжȡλãͬһʱֻܱһƵʹ
+ */
+class KGE_API AudioStream : public AudioData
+{
+public:
+    virtual ~AudioStream() = default;
+
+    bool IsStreaming() const override;
+
+    /// \~chinese
+    /// @brief ӵǰλöȡ PCM 
+    /// @param buffer 
+    /// @param size С
+    /// @return ȡֽ 0 ʾѵĩβ
+    virtual uint32_t Read(void* buffer, uint32_t size) = 0;
+
+    /// \~chinese
+    /// @brief תָλ
+    virtual bool Seek(Duration pos) = 0;
+
+    /// \~chinese
+    /// @brief ȡƵʱ
+    virtual Duration GetDuration() const = 0;
+
+protected:
+    AudioStream() = default;
+};
+
+/**
+ * \~chinese
+ * @brief Ƶ
+ * @details ɺ̨߳̽Ƶ뵽̶ĻλУύԴ
+ * ڲϺ󱻻ռ룬ѭʱڻ޷νβ
+ * ̨߳ڵһβʱֹͣź󱣳ֿУֱ
+ */
+class KGE_API AudioStreamQueue : Noncopyable
+{
+public:
+    /// \~chinese
+    /// @brief 
+    struct Buffer
+    {
+        AudioStreamQueue* queue    = nullptr;
+        uint32_t          size     = 0;
+        bool              first    = false;  ///< ǷΪĵһ
+        bool              last     = false;  ///< ǷΪһ
+        bool              loop_end = false;  ///< Ƿѭνӵ
+        uint32_t          generation = 0;    ///< ύʱĲŴ
+        Vector<uint8_t>   data;
+    };
+
+    /// \~chinese
+    /// @brief Ƶ
+    /// @param stream Ƶ
+    /// @param voice Դ
+    /// @param callback Ƶصлصִ߳
+    /// @param buffer_count 
+    /// @param buffer_size ÿֽ
+    AudioStreamQueue(RefPtr<AudioStream> stream, IXAudio2SourceVoice* voice, RefPtr<SoundCallback> callback,
+                     uint32_t buffer_count = 4, uint32_t buffer_size = 32768);
+
+    ~AudioStreamQueue();
+
+    /// \~chinese
+    /// @brief Ԥ룬пл
+    /// @details Ԥʼʱȴ
+    void Prefetch();
+
+    /// \~chinese
+    /// @brief ӵǰλÿʼ
+    /// @param loop_count ѭ -1 Ϊѭ
+    bool Start(int loop_count);
+
+    /// \~chinese
+    /// @brief ֹͣŲջ
+    void Stop();
+
+    /// \~chinese
+    /// @brief תָλãڲʱλü
+    bool Seek(Duration pos);
+
+    /// \~chinese
+    /// @brief ǷѾ
+    bool IsFinished() const;
+
+    /// \~chinese
+    /// @brief ʼʱԴص
+    void OnBufferStart(Buffer* buffer);
+
+    /// \~chinese
+    /// @brief ʱԴص
+    void OnBufferEnd(Buffer* buffer);
+
+private:
+    void StartWorker();
+
+    void StopWorker();
+
+    void WorkerLoop();
+
+    void StopPlayback();
+
+    enum class CallbackType
+    {
+        Start,
+        LoopEnd,
+        End,
+    };
+
+    // ƵصͶݵ̣߳ʱ mutex_
+    void PostCallback(CallbackType type);
+
+    void Decode(Buffer& buffer);
+
+    bool Submit(Buffer& buffer);
+
+private:
+    RefPtr<AudioStream>     stream_;
+    IXAudio2SourceVoice*    voice_;
+    RefPtr<SoundCallback>   callback_;
+    Vector<Buffer>          buffers_;
+    uint32_t                buffer_size_;
+    uint32_t                head_;
+    uint32_t                queued_;
+    uint32_t                filled_;
+    int                     loops_remaining_;
+    bool                    decode_finished_;
+    bool                    first_pending_;
+    uint32_t                generation_;
+    bool                    running_;
+    bool                    exiting_;
+    bool                    busy_;
+    bool                    flushing_;
+    bool                    finished_;
+    mutable std::mutex      mutex_;
+    std::condition_variable cond_;
+    std::thread             worker_;
+
+    // Ͷݵ̵߳ĻصͨþʶУٺÿ
+    std::shared_ptr<AudioStreamQueue*> handle_;
+};
+
+/** @} */
+
+}  // namespace audio
+}  // namespace kiwano
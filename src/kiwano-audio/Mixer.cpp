@@ -0,0 +1,245 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-audio/Mixer.h>
+#include <kiwano-audio/AudioConverter.h>
+#include <kiwano-audio/MixerKernel.h>
+#include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+MixerVoice::MixerVoice(RefPtr<AudioData> data)
+    : playing_(false)
+    , paused_(false)
+    , channels_(0)
+    , loops_remaining_(0)
+    , sample_rate_(0)
+    , frames_(0)
+    , volume_(1.f)
+    , pan_(0.f)
+    , pitch_(1.f)
+    , position_(0)
+{
+    if (!data || !ConvertToFloat(*data, samples_))
+    {
+        KGE_ERROR("MixerVoice only supports 8/16-bit PCM and 32-bit float audio data");
+        return;
+    }
+
+    const AudioMeta meta = data->GetMeta();
+    if (meta.channels != 1 && meta.channels != 2)
+    {
+        KGE_ERROR("MixerVoice only supports mono and stereo audio data");
+        samples_.clear();
+        return;
+    }
+
+    channels_    = meta.channels;
+    sample_rate_ = meta.samples_per_sec;
+    frames_      = uint32_t(samples_.size() / channels_);
+}
+
+MixerVoice::~MixerVoice() {}
+
+void MixerVoice::Play(int loop_count)
+{
+    if (frames_ == 0)
+        return;
+
+    position_        = 0;
+    loops_remaining_ = loop_count;
+    playing_         = true;
+    paused_          = false;
+}
+
+void MixerVoice::Pause()
+{
+    paused_ = true;
+}
+
+void MixerVoice::Resume()
+{
+    paused_ = false;
+}
+
+void MixerVoice::Stop()
+{
+    playing_  = false;
+    paused_   = false;
+    position_ = 0;
+}
+
+uint32_t MixerVoice::Mix(float* output, uint32_t frames, uint32_t output_rate, float master_volume)
+{
+    if (!IsPlaying())
+        return 0;
+
+    float gain_l, gain_r;
+    kernel::PanGains(volume_ * master_volume, pan_, gain_l, gain_r);
+
+    const double step = double(pitch_) * sample_rate_ / output_rate;
+
+    uint32_t mixed = 0;
+    while (mixed < frames && playing_)
+    {
+        float*   out   = output + mixed * Mixer::kOutputChannels;
+        uint32_t count =
+            kernel::MixFrames(out, samples_.data(), frames_, channels_, position_, step, frames - mixed, gain_l, gain_r);
+        mixed += count;
+
+        if (position_ >= frames_)
+        {
+            if (loops_remaining_ != 0)
+            {
+                if (loops_remaining_ > 0)
+                    --loops_remaining_;
+                position_ -= frames_;
+            }
+            else
+            {
+                Stop();
+            }
+        }
+        else if (count == 0)
+        {
+            break;
+        }
+    }
+    return mixed;
+}
+
+Mixer::Mixer(uint32_t sample_rate)
+    : sample_rate_(sample_rate)
+    , master_volume_(1.f)
+{
+}
+
+Mixer::~Mixer()
+{
+    if (sink_)
+    {
+        sink_->Close();
+    }
+}
+
+bool Mixer::SetSink(RefPtr<MixerSink> sink)
+{
+    if (sink_)
+    {
+        sink_->Close();
+    }
+
+    sink_ = sink;
+    if (sink_ && !sink_->Open(sample_rate_, kOutputChannels))
+    {
+        KGE_ERROR("Open mixer sink failed");
+        sink_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+RefPtr<MixerVoice> Mixer::CreateVoice(RefPtr<AudioData> data)
+{
+    auto voice = MakePtr<MixerVoice>(data);
+    if (voice->GetFrameCount() == 0)
+    {
+        return nullptr;
+    }
+    AddVoice(voice);
+    return voice;
+}
+
+void Mixer::AddVoice(RefPtr<MixerVoice> voice)
+{
+    KGE_ASSERT(voice && "Mixer::AddVoice failed, NULL pointer exception");
+
+    if (voice)
+    {
+        voices_.push_back(voice);
+    }
+}
+
+void Mixer::RemoveVoice(RefPtr<MixerVoice> voice)
+{
+    auto iter = std::find(voices_.begin(), voices_.end(), voice);
+    if (iter != voices_.end())
+    {
+        voices_.erase(iter);
+    }
+}
+
+void Mixer::RemoveStoppedVoices()
+{
+    auto iter = std::remove_if(voices_.begin(), voices_.end(),
+                               [](const RefPtr<MixerVoice>& voice) { return !voice->playing_; });
+    voices_.erase(iter, voices_.end());
+}
+
+void Mixer::RemoveAllVoices()
+{
+    voices_.clear();
+}
+
+void Mixer::Mix(float* output, uint32_t frames)
+{
+    KGE_PROFILE_SCOPE("audio::Mixer::Mix");
+
+    std::fill(output, output + frames * kOutputChannels, 0.f);
+
+    uint32_t active = 0;
+    for (auto& voice : voices_)
+    {
+        const uint32_t mixed = voice->Mix(output, frames, sample_rate_, master_volume_);
+        if (mixed > 0)
+        {
+            ++active;
+            stats_.mixed_voice_frames += mixed;
+        }
+    }
+
+    kernel::ClampOutput(output, frames * kOutputChannels);
+
+    stats_.mixed_frames += frames;
+    stats_.active_voices = active;
+}
+
+bool Mixer::Render(uint32_t frames)
+{
+    if (buffer_.size() < frames * kOutputChannels)
+    {
+        buffer_.resize(frames * kOutputChannels);
+    }
+
+    Mix(buffer_.data(), frames);
+
+    if (sink_)
+    {
+        return sink_->Write(buffer_.data(), frames);
+    }
+    return true;
+}
+
+}  // namespace audio
+}  // namespace kiwano
@@ -0,0 +1,299 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano-audio/AudioData.h>
+#include <kiwano-audio/MixerSink.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+/**
+ * \addtogroup Audio
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief Դ
+ * @details Դ 32 λʽĲݣɻϵ
+ */
+class KGE_API MixerVoice : public ObjectBase
+{
+    friend class Mixer;
+
+public:
+    /// \~chinese
+    /// @brief Դ
+    /// @param data ƵݣʽݻڴʱתΪʽ
+    MixerVoice(RefPtr<AudioData> data);
+
+    virtual ~MixerVoice();
+
+    /// \~chinese
+    /// @brief 
+    /// @param loop_count ѭ -1 Ϊѭ
+    void Play(int loop_count = 0);
+
+    /// \~chinese
+    /// @brief ͣ
+    void Pause();
+
+    /// \~chinese
+    /// @brief 
+    void Resume();
+
+    /// \~chinese
+    /// @brief ֹͣ
+    void Stop();
+
+    /// \~chinese
+    /// @brief Ƿڲ
+    bool IsPlaying() const;
+
+    /// \~chinese
+    /// @brief ȡ
+    float GetVolume() const;
+
+    /// \~chinese
+    /// @brief 
+    void SetVolume(float volume);
+
+    /// \~chinese
+    /// @brief ȡ
+    float GetPan() const;
+
+    /// \~chinese
+    /// @brief 
+    /// @param pan -1 Ϊ0 ΪУ1 Ϊ
+    void SetPan(float pan);
+
+    /// \~chinese
+    /// @brief ȡ
+    float GetPitch() const;
+
+    /// \~chinese
+    /// @brief 
+    /// @param pitch ʣ1.0 Ϊԭʼ
+    void SetPitch(float pitch);
+
+    /// \~chinese
+    /// @brief ȡ
+    uint16_t GetChannels() const;
+
+    /// \~chinese
+    /// @brief ȡ֡
+    uint32_t GetFrameCount() const;
+
+private:
+    uint32_t Mix(float* output, uint32_t frames, uint32_t output_rate, float master_volume);
+
+private:
+    bool          playing_;
+    bool          paused_;
+    uint16_t      channels_;
+    int           loops_remaining_;
+    uint32_t      sample_rate_;
+    uint32_t      frames_;
+    float         volume_;
+    float         pan_;
+    float         pitch_;
+    double        position_;
+    Vector<float> samples_;
+};
+
+/**
+ * \~chinese
+ * @brief 
+ * @details ڲŵԴΪ 32 λдˡ
+ * Ƶ豸ʹÿ˻ WAV ļ˽豸
+ */
+class KGE_API Mixer : public ObjectBase
+{
+public:
+    /// \~chinese
+    /// @brief ͳ
+    struct Stats
+    {
+        uint64_t mixed_frames       = 0;  ///< ѻϵ֡
+        uint64_t mixed_voice_frames = 0;  ///< ѻϵԴ֡ÿԴֱ
+        uint32_t active_voices      = 0;  ///< һλʱڲŵԴ
+    };
+
+    /// \~chinese
+    /// @brief 
+    static const uint16_t kOutputChannels = 2;
+
+    /// \~chinese
+    /// @brief 
+    /// @param sample_rate 
+    Mixer(uint32_t sample_rate = 44100);
+
+    virtual ~Mixer();
+
+    /// \~chinese
+    /// @brief ȡ
+    uint32_t GetSampleRate() const;
+
+    /// \~chinese
+    /// @brief ȡ
+    float GetMasterVolume() const;
+
+    /// \~chinese
+    /// @brief 
+    void SetMasterVolume(float volume);
+
+    /// \~chinese
+    /// @brief ȡ
+    RefPtr<MixerSink> GetSink() const;
+
+    /// \~chinese
+    /// @brief 
+    bool SetSink(RefPtr<MixerSink> sink);
+
+    /// \~chinese
+    /// @brief Դ
+    RefPtr<MixerVoice> CreateVoice(RefPtr<AudioData> data);
+
+    /// \~chinese
+    /// @brief Դ
+    void AddVoice(RefPtr<MixerVoice> voice);
+
+    /// \~chinese
+    /// @brief ӻƳԴ
+    void RemoveVoice(RefPtr<MixerVoice> voice);
+
+    /// \~chinese
+    /// @brief ƳֹͣԴ
+    void RemoveStoppedVoices();
+
+    /// \~chinese
+    /// @brief ƳԴ
+    void RemoveAllVoices();
+
+    /// \~chinese
+    /// @brief ȡԴ
+    const Vector<RefPtr<MixerVoice>>& GetVoices() const;
+
+    /// \~chinese
+    /// @brief ָ֡Ƶ
+    /// @param output 洢СΪ frames * 2
+    /// @param frames ֡
+    void Mix(float* output, uint32_t frames);
+
+    /// \~chinese
+    /// @brief ָ֡Ƶд
+    /// @return Ƿɹ
+    bool Render(uint32_t frames);
+
+    /// \~chinese
+    /// @brief ȡͳ
+    const Stats& GetStats() const;
+
+private:
+    uint32_t                   sample_rate_;
+    float                      master_volume_;
+    Stats                      stats_;
+    RefPtr<MixerSink>          sink_;
+    Vector<float>              buffer_;
+    Vector<RefPtr<MixerVoice>> voices_;
+};
+
+/** @} */
+
+inline bool MixerVoice::IsPlaying() const
+{
+    return playing_ && !paused_;
+}
+
+inline float MixerVoice::GetVolume() const
+{
+    return volume_;
+}
+
+inline void MixerVoice::SetVolume(float volume)
+{
+    volume_ = volume;
+}
+
+inline float MixerVoice::GetPan() const
+{
+    return pan_;
+}
+
+inline void MixerVoice::SetPan(float pan)
+{
+    pan_ = std::min(std::max(pan, -1.f), 1.f);
+}
+
+inline float MixerVoice::GetPitch() const
+{
+    return pitch_;
+}
+
+inline void MixerVoice::SetPitch(float pitch)
+{
+    pitch_ = std::max(pitch, 0.f);
+}
+
+inline uint16_t MixerVoice::GetChannels() const
+{
+    return channels_;
+}
+
+inline uint32_t MixerVoice::GetFrameCount() const
+{
+    return frames_;
+}
+
+inline uint32_t Mixer::GetSampleRate() const
+{
+    return sample_rate_;
+}
+
+inline float Mixer::GetMasterVolume() const
+{
+    return master_volume_;
+}
+
+inline void Mixer::SetMasterVolume(float volume)
+{
+    master_volume_ = volume;
+}
+
+inline RefPtr<MixerSink> Mixer::GetSink() const
+{
+    return sink_;
+}
+
+inline const Vector<RefPtr<MixerVoice>>& Mixer::GetVoices() const
+{
+    return voices_;
+}
+
+inline const Mixer::Stats& Mixer::GetStats() const
+{
+    return stats_;
+}
+
+}  // namespace audio
+}  // namespace kiwano
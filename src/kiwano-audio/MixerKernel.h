@@ -0,0 +1,202 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define KGE_MIXER_USE_SSE
+#endif
+
+namespace kiwano
+{
+namespace audio
+{
+
+/**
+ * \~chinese
+ * @brief ʹõĻز
+ * @details ֻ׼⣬Ƶ棬ƽ̨ϵԡ
+ * ʼΪ 32 λ
+ */
+namespace kernel
+{
+
+// out[2i] += src[2i] * gain_l, out[2i+1] += src[2i+1] * gain_r
+inline void MixStereo(float* out, const float* src, uint32_t frames, float gain_l, float gain_r)
+{
+    uint32_t i = 0;
+#ifdef KGE_MIXER_USE_SSE
+    const __m128 gain = _mm_setr_ps(gain_l, gain_r, gain_l, gain_r);
+    for (; i + 2 <= frames; i += 2)
+    {
+        __m128 o = _mm_loadu_ps(out + i * 2);
+        __m128 s = _mm_loadu_ps(src + i * 2);
+        _mm_storeu_ps(out + i * 2, _mm_add_ps(o, _mm_mul_ps(s, gain)));
+    }
+#endif
+    for (; i < frames; ++i)
+    {
+        out[i * 2]     += src[i * 2] * gain_l;
+        out[i * 2 + 1] += src[i * 2 + 1] * gain_r;
+    }
+}
+
+// out[2i] += src[i] * gain_l, out[2i+1] += src[i] * gain_r
+inline void MixMono(float* out, const float* src, uint32_t frames, float gain_l, float gain_r)
+{
+    uint32_t i = 0;
+#ifdef KGE_MIXER_USE_SSE
+    const __m128 gain = _mm_setr_ps(gain_l, gain_r, gain_l, gain_r);
+    for (; i + 4 <= frames; i += 4)
+    {
+        __m128 s  = _mm_loadu_ps(src + i);
+        __m128 lo = _mm_unpacklo_ps(s, s);
+        __m128 hi = _mm_unpackhi_ps(s, s);
+        _mm_storeu_ps(out + i * 2, _mm_add_ps(_mm_loadu_ps(out + i * 2), _mm_mul_ps(lo, gain)));
+        _mm_storeu_ps(out + i * 2 + 4, _mm_add_ps(_mm_loadu_ps(out + i * 2 + 4), _mm_mul_ps(hi, gain)));
+    }
+#endif
+    for (; i < frames; ++i)
+    {
+        out[i * 2]     += src[i] * gain_l;
+        out[i * 2 + 1] += src[i] * gain_r;
+    }
+}
+
+// Linear interpolation resampling, four output frames per iteration
+inline void MixResampledChannel(float* out, const float* src, uint32_t src_frames, uint32_t src_channels,
+                                uint32_t channel, double position, double step, uint32_t frames, float gain)
+{
+    const uint32_t last = src_frames - 1;
+
+    uint32_t i = 0;
+#ifdef KGE_MIXER_USE_SSE
+    const __m128 gain4 = _mm_set1_ps(gain);
+    for (; i + 4 <= frames; i += 4)
+    {
+        float a[4], b[4], t[4];
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            const double   pos   = position + step * (i + k);
+            const uint32_t index = std::min(uint32_t(pos), last);
+            const uint32_t next  = std::min(index + 1, last);
+
+            a[k] = src[index * src_channels + channel];
+            b[k] = src[next * src_channels + channel];
+            t[k] = float(pos - index);
+        }
+
+        __m128 va = _mm_loadu_ps(a);
+        __m128 vs = _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b), va), _mm_loadu_ps(t)));
+        vs        = _mm_mul_ps(vs, gain4);
+
+        float mixed[4];
+        _mm_storeu_ps(mixed, vs);
+        for (uint32_t k = 0; k < 4; ++k)
+        {
+            out[(i + k) * 2] += mixed[k];
+        }
+    }
+#endif
+    for (; i < frames; ++i)
+    {
+        const double   pos   = position + step * i;
+        const uint32_t index = std::min(uint32_t(pos), last);
+        const uint32_t next  = std::min(index + 1, last);
+
+        const float a = src[index * src_channels + channel];
+        const float b = src[next * src_channels + channel];
+        out[i * 2] += (a + (b - a) * float(pos - index)) * gain;
+    }
+}
+
+// Clamps the mixed output to [-1, 1]
+inline void ClampOutput(float* out, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef KGE_MIXER_USE_SSE
+    const __m128 lower = _mm_set1_ps(-1.f);
+    const __m128 upper = _mm_set1_ps(1.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(out + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(out + i), lower), upper));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        out[i] = std::min(std::max(out[i], -1.f), 1.f);
+    }
+}
+
+// Balance panning keeps the centered voice at unity gain
+inline void PanGains(float gain, float pan, float& gain_l, float& gain_r)
+{
+    gain_l = gain * (pan > 0.f ? 1.f - pan : 1.f);
+    gain_r = gain * (pan < 0.f ? 1.f + pan : 1.f);
+}
+
+// Mixes a mono or stereo source from position until the output is full or the source runs out,
+// resampling when step is not 1. Returns the number of output frames and advances position
+inline uint32_t MixFrames(float* out, const float* src, uint32_t src_frames, uint32_t src_channels, double& position,
+                          double step, uint32_t frames, float gain_l, float gain_r)
+{
+    if (step == 1.0)
+    {
+        const uint32_t index = uint32_t(position);
+        const uint32_t count = std::min(frames, src_frames - index);
+
+        if (src_channels == 2)
+            MixStereo(out, src + index * 2, count, gain_l, gain_r);
+        else
+            MixMono(out, src + index, count, gain_l, gain_r);
+
+        position += count;
+        return count;
+    }
+
+    if (step <= 0.0)
+        return 0;
+
+    // number of output frames before the source runs out
+    const double   available = (src_frames - position) / step;
+    const uint32_t count     = std::min(frames, uint32_t(std::ceil(available)));
+
+    if (src_channels == 2)
+    {
+        MixResampledChannel(out, src, src_frames, 2, 0, position, step, count, gain_l);
+        MixResampledChannel(out + 1, src, src_frames, 2, 1, position, step, count, gain_r);
+    }
+    else
+    {
+        MixResampledChannel(out, src, src_frames, 1, 0, position, step, count, gain_l);
+        MixResampledChannel(out + 1, src, src_frames, 1, 0, position, step, count, gain_r);
+    }
+
+    position += step * count;
+    return count;
+}
+
+}  // namespace kernel
+}  // namespace audio
+}  // namespace kiwano
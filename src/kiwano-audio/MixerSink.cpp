@@ -0,0 +1,230 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-audio/MixerSink.h>
+#include <kiwano-audio/Module.h>
+#include <kiwano/utils/Logger.h>
+
+namespace kiwano
+{
+namespace audio
+{
+
+NullMixerSink::NullMixerSink()
+    : written_frames_(0)
+{
+}
+
+bool NullMixerSink::Open(uint32_t sample_rate, uint16_t channels)
+{
+    KGE_NOT_USED(sample_rate);
+    KGE_NOT_USED(channels);
+
+    written_frames_ = 0;
+    return true;
+}
+
+bool NullMixerSink::Write(const float* samples, uint32_t frames)
+{
+    KGE_NOT_USED(samples);
+
+    written_frames_ += frames;
+    return true;
+}
+
+void NullMixerSink::Close() {}
+
+WavFileMixerSink::WavFileMixerSink(StringView file_path)
+    : channels_(0)
+    , sample_rate_(0)
+    , data_size_(0)
+    , file_path_(file_path)
+{
+}
+
+WavFileMixerSink::~WavFileMixerSink()
+{
+    Close();
+}
+
+bool WavFileMixerSink::Open(uint32_t sample_rate, uint16_t channels)
+{
+    Close();
+
+    ofs_.open(file_path_, std::ios::binary | std::ios::trunc);
+    if (!ofs_.is_open())
+    {
+        KGE_ERROR(strings::Format("Open wav file '%s' failed", file_path_.c_str()));
+        return false;
+    }
+
+    channels_    = channels;
+    sample_rate_ = sample_rate;
+    data_size_   = 0;
+
+    // the header is written again with the final sizes when the file is closed
+    WriteHeader();
+    return ofs_.good();
+}
+
+bool WavFileMixerSink::Write(const float* samples, uint32_t frames)
+{
+    if (!ofs_.is_open())
+        return false;
+
+    const uint32_t size = frames * channels_ * uint32_t(sizeof(float));
+    ofs_.write(reinterpret_cast<const char*>(samples), size);
+    data_size_ += size;
+    return ofs_.good();
+}
+
+void WavFileMixerSink::Close()
+{
+    if (ofs_.is_open())
+    {
+        ofs_.seekp(0);
+        WriteHeader();
+        ofs_.close();
+    }
+}
+
+void WavFileMixerSink::WriteHeader()
+{
+    auto write_u32 = [this](uint32_t value) { ofs_.write(reinterpret_cast<const char*>(&value), 4); };
+    auto write_u16 = [this](uint16_t value) { ofs_.write(reinterpret_cast<const char*>(&value), 2); };
+
+    const uint16_t block_align = uint16_t(channels_ * sizeof(float));
+    const uint32_t frames      = block_align ? data_size_ / block_align : 0;
+
+    ofs_.write("RIFF", 4);
+    write_u32(4 + (8 + 18) + (8 + 4) + (8 + data_size_));
+    ofs_.write("WAVE", 4);
+
+    // fmt chunk, WAVE_FORMAT_IEEE_FLOAT
+    ofs_.write("fmt ", 4);
+    write_u32(18);
+    write_u16(3);
+    write_u16(channels_);
+    write_u32(sample_rate_);
+    write_u32(sample_rate_ * block_align);
+    write_u16(block_align);
+    write_u16(32);
+    write_u16(0);
+
+    // non-PCM formats require a fact chunk
+    ofs_.write("fact", 4);
+    write_u32(4);
+    write_u32(frames);
+
+    ofs_.write("data", 4);
+    write_u32(data_size_);
+}
+
+XAudio2MixerSink::XAudio2MixerSink(uint32_t buffer_count)
+    : channels_(0)
+    , next_buffer_(0)
+    , voice_(nullptr)
+    , buffers_(std::max(buffer_count, 2u))
+{
+}
+
+XAudio2MixerSink::~XAudio2MixerSink()
+{
+    Close();
+}
+
+bool XAudio2MixerSink::Open(uint32_t sample_rate, uint16_t channels)
+{
+    Close();
+
+    AudioMeta meta;
+    meta.format          = AudioFormat::IEEEFloat;
+    meta.channels        = channels;
+    meta.samples_per_sec = sample_rate;
+    meta.bits_per_sample = 32;
+    meta.block_align     = uint16_t(channels * sizeof(float));
+
+    voice_ = Module::GetInstance().CreateSourceVoice(meta);
+    if (!voice_)
+        return false;
+
+    channels_    = channels;
+    next_buffer_ = 0;
+
+    HRESULT hr = voice_->Start();
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Start voice failed with HRESULT of %08X", hr);
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool XAudio2MixerSink::Write(const float* samples, uint32_t frames)
+{
+    if (!voice_)
+        return false;
+
+    // buffers are played in the order they were submitted, the next buffer is free when the queue is not full
+    if (GetQueuedBufferCount() >= buffers_.size())
+        return false;
+
+    auto& buffer = buffers_[next_buffer_];
+    buffer.assign(samples, samples + frames * channels_);
+
+    XAUDIO2_BUFFER xaudio2_buffer = { 0 };
+    xaudio2_buffer.pAudioData     = reinterpret_cast<const BYTE*>(buffer.data());
+    xaudio2_buffer.AudioBytes     = UINT32(buffer.size() * sizeof(float));
+
+    HRESULT hr = voice_->SubmitSourceBuffer(&xaudio2_buffer);
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Submitting source buffer failed with HRESULT of %08X", hr);
+        return false;
+    }
+
+    next_buffer_ = (next_buffer_ + 1) % uint32_t(buffers_.size());
+    return true;
+}
+
+void XAudio2MixerSink::Close()
+{
+    if (voice_)
+    {
+        voice_->Stop();
+        voice_->FlushSourceBuffers();
+        voice_->DestroyVoice();
+        voice_ = nullptr;
+    }
+}
+
+uint32_t XAudio2MixerSink::GetQueuedBufferCount() const
+{
+    if (!voice_)
+        return 0;
+
+    XAUDIO2_VOICE_STATE state;
+    voice_->GetState(&state);
+    return state.BuffersQueued;
+}
+
+}  // namespace audio
+}  // namespace kiwano
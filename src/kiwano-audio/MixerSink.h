@@ -0,0 +1,159 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/ObjectBase.h>
+#include <fstream>
+
+struct IXAudio2SourceVoice;
+
+namespace kiwano
+{
+namespace audio
+{
+
+/**
+ * \addtogroup Audio
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief 
+ * @details ջĽ洢 32 λ
+ */
+class KGE_API MixerSink : public ObjectBase
+{
+public:
+    /// \~chinese
+    /// @brief 
+    /// @param sample_rate 
+    /// @param channels 
+    virtual bool Open(uint32_t sample_rate, uint16_t channels) = 0;
+
+    /// \~chinese
+    /// @brief д
+    /// @param samples 洢Ĳ
+    /// @param frames ֡
+    /// @return Ƿ
+    virtual bool Write(const float* samples, uint32_t frames) = 0;
+
+    /// \~chinese
+    /// @brief ر
+    virtual void Close() = 0;
+};
+
+/**
+ * \~chinese
+ * @brief 
+ * @details ݣͳд֡Ƶ豸ʱĻ
+ */
+class KGE_API NullMixerSink : public MixerSink
+{
+public:
+    NullMixerSink();
+
+    bool Open(uint32_t sample_rate, uint16_t channels) override;
+
+    bool Write(const float* samples, uint32_t frames) override;
+
+    void Close() override;
+
+    /// \~chinese
+    /// @brief ȡд֡
+    uint64_t GetWrittenFrames() const;
+
+private:
+    uint64_t written_frames_;
+};
+
+/**
+ * \~chinese
+ * @brief WAV ļ
+ * @details д 32 λʽ WAV ļ
+ */
+class KGE_API WavFileMixerSink : public MixerSink
+{
+public:
+    /// \~chinese
+    /// @brief  WAV ļ
+    /// @param file_path ļ·
+    WavFileMixerSink(StringView file_path);
+
+    virtual ~WavFileMixerSink();
+
+    bool Open(uint32_t sample_rate, uint16_t channels) override;
+
+    bool Write(const float* samples, uint32_t frames) override;
+
+    void Close() override;
+
+private:
+    void WriteHeader();
+
+private:
+    uint16_t      channels_;
+    uint32_t      sample_rate_;
+    uint32_t      data_size_;
+    String        file_path_;
+    std::ofstream ofs_;
+};
+
+/**
+ * \~chinese
+ * @brief XAudio2 
+ * @details ύһ XAudio2 ԴȫڲŶʱܾд
+ */
+class KGE_API XAudio2MixerSink : public MixerSink
+{
+public:
+    /// \~chinese
+    /// @brief  XAudio2 
+    /// @param buffer_count 
+    XAudio2MixerSink(uint32_t buffer_count = 4);
+
+    virtual ~XAudio2MixerSink();
+
+    bool Open(uint32_t sample_rate, uint16_t channels) override;
+
+    bool Write(const float* samples, uint32_t frames) override;
+
+    void Close() override;
+
+    /// \~chinese
+    /// @brief ȡڲŶеĻ
+    uint32_t GetQueuedBufferCount() const;
+
+private:
+    uint16_t              channels_;
+    uint32_t              next_buffer_;
+    IXAudio2SourceVoice*  voice_;
+    Vector<Vector<float>> buffers_;
+};
+
+/** @} */
+
+inline uint64_t NullMixerSink::GetWrittenFrames() const
+{
+    return written_frames_;
+}
+
+}  // namespace audio
+}  // namespace kiwano
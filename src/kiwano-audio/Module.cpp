@@ -19,8 +19,10 @@
 // THE SOFTWARE.
 #include <kiwano/core/Exception.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/platform/FileSystem.h>
 #include <kiwano-audio/Module.h>
+#include <kiwano-audio/AudioConverter.h>
 #include <kiwano-audio/libraries.h>
 #include <kiwano-audio/MediaFoundation/MFTranscoder.h>
 #include <kiwano-audio/Ogg/OggTranscoder.h>
@@ -44,6 +46,13 @@ public:
 
     STDMETHOD_(void, OnBufferStart(void* pBufferContext))
     {
+        // buffers submitted by audio streams carry their context
+        if (pBufferContext)
+        {
+            auto buffer = static_cast<AudioStreamQueue::Buffer*>(pBufferContext);
+            buffer->queue->OnBufferStart(buffer);
+            return;
+        }
         cb->OnStart(nullptr);
     }
 
@@ -54,6 +63,12 @@ public:
 
     STDMETHOD_(void, OnBufferEnd(void* pBufferContext))
     {
+        if (pBufferContext)
+        {
+            auto buffer = static_cast<AudioStreamQueue::Buffer*>(pBufferContext);
+            buffer->queue->OnBufferEnd(buffer);
+            return;
+        }
         cb->OnEnd(nullptr);
     }
 
@@ -75,13 +90,28 @@ WORD ConvertWaveFormat(AudioFormat format)
     {
     case kiwano::audio::AudioFormat::PCM:
         return WAVE_FORMAT_PCM;
+    case kiwano::audio::AudioFormat::IEEEFloat:
+        return WAVE_FORMAT_IEEE_FLOAT;
     }
     return 0;
 }
 
+WAVEFORMATEX ConvertWaveFormat(const AudioMeta& meta)
+{
+    WAVEFORMATEX wave_fmt    = { 0 };
+    wave_fmt.wFormatTag      = ConvertWaveFormat(meta.format);
+    wave_fmt.nChannels       = WORD(meta.channels);
+    wave_fmt.nSamplesPerSec  = DWORD(meta.samples_per_sec);
+    wave_fmt.wBitsPerSample  = WORD(meta.bits_per_sample);
+    wave_fmt.nBlockAlign     = WORD(meta.block_align);
+    wave_fmt.nAvgBytesPerSec = DWORD(meta.avg_bytes_per_sec());
+    return wave_fmt;
+}
+
 Module::Module()
     : x_audio2_(nullptr)
     , mastering_voice_(nullptr)
+    , normalize_format_(false)
 {
 }
 
@@ -133,16 +163,7 @@ bool Module::CreateSound(Sound& sound, RefPtr<AudioData> data)
     WAVEFORMATEX* wave_fmt = data->GetNative<WAVEFORMATEX*>();
     if (wave_fmt == nullptr)
     {
-        const auto   meta   = data->GetMeta();
-        WAVEFORMATEX tmp    = { 0 };
-        tmp.wFormatTag      = ConvertWaveFormat(meta.format);
-        tmp.nChannels       = WORD(meta.channels);
-        tmp.nSamplesPerSec  = DWORD(meta.samples_per_sec);
-        tmp.wBitsPerSample  = WORD(meta.bits_per_sample);
-        tmp.nBlockAlign     = WORD(meta.block_align);
-        tmp.nAvgBytesPerSec = DWORD(meta.avg_bytes_per_sec());
-
-        data->SetNative(tmp);
+        data->SetNative(ConvertWaveFormat(data->GetMeta()));
         wave_fmt = const_cast<WAVEFORMATEX*>(data->GetNative().CastPtr<WAVEFORMATEX>());
     }
 
@@ -169,6 +190,23 @@ bool Module::CreateSound(Sound& sound, RefPtr<AudioData> data)
     return true;
 }
 
+IXAudio2SourceVoice* Module::CreateSourceVoice(const AudioMeta& meta)
+{
+    KGE_ASSERT(x_audio2_ && "Audio module hasn't been initialized!");
+
+    const WAVEFORMATEX wave_fmt = ConvertWaveFormat(meta);
+
+    IXAudio2SourceVoice* voice = nullptr;
+
+    HRESULT hr = x_audio2_->CreateSourceVoice(&voice, &wave_fmt);
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Create IXAudio2SourceVoice failed with HRESULT of %08X", hr);
+        return nullptr;
+    }
+    return voice;
+}
+
 void Module::Open()
 {
     KGE_ASSERT(x_audio2_ && "Audio module hasn't been initialized!");
@@ -199,7 +237,67 @@ RefPtr<Transcoder> Module::GetTranscoder(StringView ext)
     return registered_transcoders_.at("*");
 }
 
+String Module::GetFullPath(StringView file_path, RefPtr<Transcoder>& transcoder)
+{
+    if (!FileSystem::GetInstance().IsFileExists(file_path))
+    {
+        KGE_WARNF("Media file '%s' not found", file_path.data());
+        return String();
+    }
+
+    const auto ext = FileSystem::GetInstance().GetFileExt(file_path);
+
+    transcoder = GetTranscoder(ext);
+    if (!transcoder)
+    {
+        return String();
+    }
+    return FileSystem::GetInstance().GetFullPathForFile(file_path);
+}
+
 RefPtr<AudioData> Module::Decode(StringView file_path)
+{
+    KGE_PROFILE_SCOPE("audio::Module::Decode");
+
+    RefPtr<Transcoder> transcoder;
+    String             full_path = GetFullPath(file_path, transcoder);
+    if (full_path.empty())
+    {
+        return nullptr;
+    }
+    return Normalize(transcoder->Decode(full_path));
+}
+
+RefPtr<AudioData> Module::Decode(StringView file_path, const AudioMeta* normalized_meta)
+{
+    KGE_PROFILE_SCOPE("audio::Module::Decode");
+
+    RefPtr<Transcoder> transcoder;
+    String             full_path = GetFullPath(file_path, transcoder);
+    if (full_path.empty())
+    {
+        return nullptr;
+    }
+
+    RefPtr<AudioData> data;
+    if (auto ogg = dynamic_cast<OggTranscoder*>(transcoder.Get()))
+    {
+        const bool float_output = normalized_meta && normalized_meta->format == AudioFormat::IEEEFloat;
+        data                    = ogg->Decode(full_path, float_output);
+    }
+    else
+    {
+        data = transcoder->Decode(full_path);
+    }
+
+    if (!normalized_meta || !data)
+    {
+        return data;
+    }
+    return ConvertAudioData(data, *normalized_meta);
+}
+
+RefPtr<AudioStream> Module::OpenStream(StringView file_path)
 {
     if (!FileSystem::GetInstance().IsFileExists(file_path))
     {
@@ -214,18 +312,105 @@ RefPtr<AudioData> Module::Decode(StringView file_path)
     {
         return nullptr;
     }
+
     String full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
-    return transcoder->Decode(full_path);
+    auto   stream    = transcoder->OpenStream(full_path);
+    if (!stream)
+    {
+        KGE_WARNF("Streaming is not supported for media file '%s'", file_path.data());
+    }
+    return stream;
 }
 
 RefPtr<AudioData> Module::Decode(const Resource& res, StringView ext)
+{
+    KGE_PROFILE_SCOPE("audio::Module::Decode");
+
+    auto transcoder = GetTranscoder(ext);
+    if (!transcoder)
+    {
+        return nullptr;
+    }
+    return Normalize(transcoder->Decode(res));
+}
+
+RefPtr<AudioData> Module::Decode(const BinaryData& data, StringView ext)
+{
+    KGE_PROFILE_SCOPE("audio::Module::Decode");
+
+    auto transcoder = GetTranscoder(ext);
+    if (!transcoder)
+    {
+        return nullptr;
+    }
+    return Normalize(transcoder->Decode(data));
+}
+
+void Module::SetNormalizedFormat(const AudioMeta& meta)
+{
+    normalize_format_ = true;
+    normalized_meta_  = meta;
+
+    // decode float samples directly instead of converting 16-bit samples
+    SetOggFloatOutput(meta.format == AudioFormat::IEEEFloat);
+}
+
+void Module::ResetNormalizedFormat()
+{
+    normalize_format_ = false;
+    SetOggFloatOutput(false);
+}
+
+bool Module::GetNormalizedFormat(AudioMeta& meta) const
+{
+    if (!normalize_format_)
+    {
+        return false;
+    }
+    meta = normalized_meta_;
+    return true;
+}
+
+void Module::SetOggFloatOutput(bool enabled)
+{
+    auto iter = registered_transcoders_.find("ogg");
+    if (iter != registered_transcoders_.end())
+    {
+        if (auto ogg = dynamic_cast<OggTranscoder*>(iter->second.Get()))
+        {
+            ogg->SetFloatOutput(enabled);
+        }
+    }
+}
+
+RefPtr<AudioData> Module::Normalize(RefPtr<AudioData> data) const
+{
+    if (!normalize_format_ || !data)
+    {
+        return data;
+    }
+    return ConvertAudioData(data, normalized_meta_);
+}
+
+RefPtr<AudioStream> Module::OpenStream(const Resource& res, StringView ext)
+{
+    return OpenStream(res.GetData(), ext);
+}
+
+RefPtr<AudioStream> Module::OpenStream(const BinaryData& data, StringView ext)
 {
     auto transcoder = GetTranscoder(ext);
     if (!transcoder)
     {
         return nullptr;
     }
-    return transcoder->Decode(res);
+
+    auto stream = transcoder->OpenStream(data);
+    if (!stream)
+    {
+        KGE_WARNF("Streaming is not supported for audio type '%s'", ext.data());
+    }
+    return stream;
 }
 
 }  // namespace audio
@@ -74,16 +74,71 @@ public:
     /// @param file_path Ƶļ·
     RefPtr<AudioData> Decode(StringView file_path);
 
+    /// \~chinese
+    /// @brief ָͳһʽƵ
+    /// @details ȡǰõͳһʽں̨߳ SetNormalizedFormat ͬʱá
+    /// Ogg ƵͳһʽΪ 32 λʽʱֱӽΪ
+    /// @param file_path Ƶļ·
+    /// @param normalized_meta ͳһʽΪʱתʽ
+    RefPtr<AudioData> Decode(StringView file_path, const AudioMeta* normalized_meta);
+
     /// \~chinese
     /// @brief Ƶ
     /// @param res ƵԴ
     /// @param ext Ƶͣʹúֽ
     RefPtr<AudioData> Decode(const Resource& res, StringView ext = "");
 
+    /// \~chinese
+    /// @brief ڴеƵ
+    /// @param data Ƶ
+    /// @param ext Ƶͣʹúֽ
+    RefPtr<AudioData> Decode(const BinaryData& data, StringView ext = "");
+
+    /// \~chinese
+    /// @brief Ƶ
+    /// @details Ƶڲʱν룬ڱֵȽϳƵ
+    /// @param file_path Ƶļ·
+    RefPtr<AudioStream> OpenStream(StringView file_path);
+
+    /// \~chinese
+    /// @brief ƵԴ
+    /// @param res ƵԴ
+    /// @param ext Ƶͣʹúֽ
+    RefPtr<AudioStream> OpenStream(const Resource& res, StringView ext = "");
+
+    /// \~chinese
+    /// @brief ڴеƵ
+    /// @details ƵֱӶȡڴеݣƵǰݱ뱣Ч
+    /// @param data Ƶ
+    /// @param ext Ƶͣʹúֽ
+    RefPtr<AudioStream> OpenStream(const BinaryData& data, StringView ext = "");
+
+    /// \~chinese
+    /// @brief Ƶݵͳһʽ
+    /// @details úõƵݻڼʱתΪøʽ˫ 32 λʽ
+    /// ʱҪתʽͬʽԴҲԱáƵӰ
+    /// @param meta Ƶʽֵ֧ 16 λ PCM  32 λʽ
+    void SetNormalizedFormat(const AudioMeta& meta);
+
+    /// \~chinese
+    /// @brief ȡƵݵͳһʽ
+    void ResetNormalizedFormat();
+
+    /// \~chinese
+    /// @brief ȡƵݵͳһʽ
+    /// @param[out] meta ͳһʽ
+    /// @return δͳһʽʱ false
+    bool GetNormalizedFormat(AudioMeta& meta) const;
+
     /// \~chinese
     /// @brief Ƶ
     bool CreateSound(Sound& sound, RefPtr<AudioData> data);
 
+    /// \~chinese
+    /// @brief Դ
+    /// @details ɵ÷ύԴ
+    IXAudio2SourceVoice* CreateSourceVoice(const AudioMeta& meta);
+
 public:
     void SetupModule() override;
 
@@ -94,9 +149,17 @@ public:
 private:
     Module();
 
+    RefPtr<AudioData> Normalize(RefPtr<AudioData> data) const;
+
+    String GetFullPath(StringView file_path, RefPtr<Transcoder>& transcoder);
+
+    void SetOggFloatOutput(bool enabled);
+
 private:
     IXAudio2*               x_audio2_;
     IXAudio2MasteringVoice* mastering_voice_;
+    bool                    normalize_format_;
+    AudioMeta               normalized_meta_;
 
     UnorderedMap<String, RefPtr<Transcoder>> registered_transcoders_;
 };
@@ -22,11 +22,135 @@
 #include <kiwano-audio/Ogg/OggTranscoder.h>
 #include <3rd-party/vorbis/vorbisfile.h>
 
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define KGE_OGG_USE_SSE
+#endif
+
 namespace kiwano
 {
 namespace audio
 {
 
+namespace
+{
+
+AudioMeta ReadOggMeta(OggVorbis_File* vf)
+{
+    vorbis_info* vi = ov_info(vf, -1);
+
+    AudioMeta meta;
+    meta.samples_per_sec = uint32_t(vi->rate);
+    meta.channels        = uint16_t(vi->channels);
+    meta.bits_per_sample = uint16_t(16);  // the 'word' param of ov_read sets to 2, which means 16-bits samples.
+    meta.block_align     = uint16_t(meta.channels * meta.bits_per_sample / 8);
+    return meta;
+}
+
+// Interleaves the planar float samples returned by ov_read_float
+void InterleaveFloat(float* out, float** pcm, uint32_t channels, uint32_t frames)
+{
+    uint32_t i = 0;
+    if (channels == 2)
+    {
+#ifdef KGE_OGG_USE_SSE
+        for (; i + 4 <= frames; i += 4)
+        {
+            __m128 l = _mm_loadu_ps(pcm[0] + i);
+            __m128 r = _mm_loadu_ps(pcm[1] + i);
+            _mm_storeu_ps(out + i * 2, _mm_unpacklo_ps(l, r));
+            _mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(l, r));
+        }
+#endif
+    }
+
+    for (; i < frames; ++i)
+    {
+        for (uint32_t c = 0; c < channels; ++c)
+        {
+            out[i * channels + c] = pcm[c][i];
+        }
+    }
+}
+
+// Ogg data source that reads straight from memory
+struct OggMemorySource
+{
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+    size_t         pos  = 0;
+};
+
+size_t ReadOggMemory(void* ptr, size_t size, size_t nmemb, void* datasource)
+{
+    auto source = static_cast<OggMemorySource*>(datasource);
+
+    const size_t bytes = std::min(size * nmemb, source->size - source->pos);
+    if (bytes > 0)
+    {
+        std::memcpy(ptr, source->data + source->pos, bytes);
+        source->pos += bytes;
+    }
+    return size ? bytes / size : 0;
+}
+
+int SeekOggMemory(void* datasource, ogg_int64_t offset, int whence)
+{
+    auto source = static_cast<OggMemorySource*>(datasource);
+
+    ogg_int64_t pos = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = ogg_int64_t(source->pos) + offset;
+        break;
+    case SEEK_END:
+        pos = ogg_int64_t(source->size) + offset;
+        break;
+    default:
+        return -1;
+    }
+
+    if (pos < 0 || pos > ogg_int64_t(source->size))
+        return -1;
+
+    source->pos = size_t(pos);
+    return 0;
+}
+
+long TellOggMemory(void* datasource)
+{
+    return long(static_cast<OggMemorySource*>(datasource)->pos);
+}
+
+bool OpenOggMemory(OggMemorySource* source, const BinaryData& data, OggVorbis_File* vf)
+{
+    if (!data.IsValid())
+    {
+        KGE_ERROR("invalid audio data");
+        return false;
+    }
+
+    source->data = static_cast<const uint8_t*>(data.buffer);
+    source->size = data.size;
+    source->pos  = 0;
+
+    ov_callbacks callbacks = { ReadOggMemory, SeekOggMemory, nullptr, TellOggMemory };
+
+    int err = ov_open_callbacks(source, vf, nullptr, 0, callbacks);
+    if (err != 0)
+    {
+        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
 class OggAudioData : public AudioData
 {
 public:
@@ -40,28 +164,106 @@ public:
     std::vector<char> raw_;
 };
 
-RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+class OggAudioStream : public AudioStream
 {
-    OggVorbis_File vf;
+public:
+    OggAudioStream()
+        : opened_(false)
+        , vf_{}
+    {
+    }
 
-    int err = ov_fopen(file_path.data(), &vf);
-    if (err != 0)
+    ~OggAudioStream()
     {
-        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
-        return nullptr;
+        if (opened_)
+        {
+            ov_clear(&vf_);
+        }
     }
 
-    // read metadata
-    vorbis_info* vi = ov_info(&vf, -1);
+    bool Open(StringView file_path)
+    {
+        int err = ov_fopen(file_path.data(), &vf_);
+        if (err != 0)
+        {
+            KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+            return false;
+        }
+        OnOpened();
+        return true;
+    }
 
-    AudioMeta meta;
-    meta.samples_per_sec = uint32_t(vi->rate);
-    meta.channels        = uint16_t(vi->channels);
-    meta.bits_per_sample = uint16_t(16);  // the 'word' param of ov_read sets to 2, which means 16-bits samples.
-    meta.block_align     = uint16_t(meta.channels * meta.bits_per_sample / 8);
+    bool Open(const BinaryData& data)
+    {
+        if (!OpenOggMemory(&source_, data, &vf_))
+        {
+            return false;
+        }
+        OnOpened();
+        return true;
+    }
+
+    uint32_t Read(void* buffer, uint32_t size) override
+    {
+        uint32_t pos = 0;
+        int      bitstream;
+        while (pos < size)
+        {
+            long bytes_read = ov_read(&vf_, static_cast<char*>(buffer) + pos, int(size - pos), 0, 2, 1, &bitstream);
+            if (bytes_read == 0)
+                break;
+            if (bytes_read == OV_HOLE)
+                continue;  // interruption in the data, keep reading
+            if (bytes_read < 0)
+            {
+                KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, bytes_read, "Decode ogg audio failed"));
+                break;
+            }
+            pos += uint32_t(bytes_read);
+        }
+        return pos;
+    }
+
+    bool Seek(Duration pos) override
+    {
+        if (pos.IsZero())
+            return ov_pcm_seek(&vf_, 0) == 0;
+        return ov_time_seek(&vf_, pos.GetMilliseconds() / 1000.0) == 0;
+    }
+
+    Duration GetDuration() const override
+    {
+        return duration_;
+    }
+
+private:
+    void OnOpened()
+    {
+        opened_   = true;
+        meta_     = ReadOggMeta(&vf_);
+        duration_ = Duration(static_cast<int64_t>(ov_time_total(&vf_, -1) * 1000));
+    }
+
+private:
+    bool            opened_;
+    Duration        duration_;
+    OggMemorySource source_;
+    OggVorbis_File  vf_;
+};
+
+RefPtr<AudioData> DecodeOgg(OggVorbis_File* vf, bool float_output)
+{
+    // read metadata
+    AudioMeta meta = ReadOggMeta(vf);
+    if (float_output)
+    {
+        meta.format          = AudioFormat::IEEEFloat;
+        meta.bits_per_sample = 32;
+        meta.block_align     = uint16_t(meta.channels * sizeof(float));
+    }
 
     // Get the audio total duration (in microseconds)
-    auto duration = static_cast<std::uintmax_t>(math::Ceil(ov_time_total(&vf, -1) * 1e6));
+    auto duration = static_cast<std::uintmax_t>(math::Ceil(ov_time_total(vf, -1) * 1e6));
 
     // allocate buffer
     std::vector<char> data;
@@ -75,32 +277,106 @@ RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
     int    bitstream;
     while (true)
     {
-        if (data.size() <= pos)
+        // float samples are read in whole frames, keep a full step available
+        if (data.size() < pos + (float_output ? step : 1))
         {
             data.resize(pos + step);
         }
         const size_t buffer_size = std::min(step, data.size() - pos);
 
-        int bytes_read = ov_read(&vf, data.data() + pos, int(buffer_size), 0, 2, 1, &bitstream);
+        long bytes_read = 0;
+        if (float_output)
+        {
+            float** pcm    = nullptr;
+            long    frames = ov_read_float(vf, &pcm, int(buffer_size / meta.block_align), &bitstream);
+            if (frames > 0)
+            {
+                InterleaveFloat(reinterpret_cast<float*>(data.data() + pos), pcm, meta.channels, uint32_t(frames));
+                bytes_read = frames * meta.block_align;
+            }
+            else
+            {
+                bytes_read = frames;
+            }
+        }
+        else
+        {
+            bytes_read = ov_read(vf, data.data() + pos, int(buffer_size), 0, 2, 1, &bitstream);
+        }
+
         if (bytes_read == 0)
             break;
         if (bytes_read < 0)
         {
             KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, bytes_read, "Decode ogg audio failed"));
+            ov_clear(vf);
             return nullptr;
         }
         pos += bytes_read;
     }
-    ov_clear(&vf);
+    ov_clear(vf);
 
     RefPtr<AudioData> output = new OggAudioData(std::move(data), uint32_t(pos), meta);
     return output;
 }
 
+OggTranscoder::OggTranscoder()
+    : float_output_(false)
+{
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(StringView file_path)
+{
+    return Decode(file_path, float_output_);
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(StringView file_path, bool float_output)
+{
+    OggVorbis_File vf;
+
+    int err = ov_fopen(file_path.data(), &vf);
+    if (err != 0)
+    {
+        KGE_ERROR(strings::Format("%s failed (%d): %s", __FUNCTION__, err, "Open ogg audio failed"));
+        return nullptr;
+    }
+    return DecodeOgg(&vf, float_output);
+}
+
 RefPtr<AudioData> OggTranscoder::Decode(const Resource& res)
 {
-    KGE_ERROR("Loading audio from memory resource is not supported for OggTranscoder");
-    return nullptr;
+    return Decode(res.GetData());
+}
+
+RefPtr<AudioData> OggTranscoder::Decode(const BinaryData& data)
+{
+    OggMemorySource source;
+    OggVorbis_File  vf;
+    if (!OpenOggMemory(&source, data, &vf))
+    {
+        return nullptr;
+    }
+    return DecodeOgg(&vf, float_output_);
+}
+
+RefPtr<AudioStream> OggTranscoder::OpenStream(StringView file_path)
+{
+    auto stream = MakePtr<OggAudioStream>();
+    if (!stream->Open(file_path))
+    {
+        return nullptr;
+    }
+    return stream;
+}
+
+RefPtr<AudioStream> OggTranscoder::OpenStream(const BinaryData& data)
+{
+    auto stream = MakePtr<OggAudioStream>();
+    if (!stream->Open(data))
+    {
+        return nullptr;
+    }
+    return stream;
 }
 
 }  // namespace audio
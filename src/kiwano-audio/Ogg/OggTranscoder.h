@@ -38,11 +38,47 @@ namespace audio
 class KGE_API OggTranscoder : public Transcoder
 {
 public:
+    OggTranscoder();
+
+    /// \~chinese
+    /// @brief ǷƵΪ 32 λʽ
+    /// @details ʹ ov_read_float 룬Ϊ 16 λתΪ㣬ƵӰ
+    void SetFloatOutput(bool enabled);
+
+    /// \~chinese
+    /// @brief ǷƵΪ 32 λʽ
+    bool IsFloatOutput() const;
+
     RefPtr<AudioData> Decode(StringView file_path) override;
 
+    /// \~chinese
+    /// @brief Ƶļȡ SetFloatOutput 
+    /// @param file_path Ƶļ·
+    /// @param float_output ǷΪ 32 λʽ
+    RefPtr<AudioData> Decode(StringView file_path, bool float_output);
+
     RefPtr<AudioData> Decode(const Resource& res) override;
+
+    RefPtr<AudioData> Decode(const BinaryData& data) override;
+
+    RefPtr<AudioStream> OpenStream(StringView file_path) override;
+
+    RefPtr<AudioStream> OpenStream(const BinaryData& data) override;
+
+private:
+    bool float_output_;
 };
 
+inline void OggTranscoder::SetFloatOutput(bool enabled)
+{
+    float_output_ = enabled;
+}
+
+inline bool OggTranscoder::IsFloatOutput() const
+{
+    return float_output_;
+}
+
 /** @} */
 
 }  // namespace audio
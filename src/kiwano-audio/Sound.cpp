@@ -28,6 +28,17 @@ namespace kiwano
 namespace audio
 {
 
+namespace
+{
+
+bool IsSameFormat(const AudioMeta& lhs, const AudioMeta& rhs)
+{
+    return lhs.format == rhs.format && lhs.channels == rhs.channels && lhs.samples_per_sec == rhs.samples_per_sec
+           && lhs.bits_per_sample == rhs.bits_per_sample && lhs.block_align == rhs.block_align;
+}
+
+}  // namespace
+
 Sound::Sound(StringView file_path)
     : Sound()
 {
@@ -50,6 +61,7 @@ Sound::Sound()
     : opened_(false)
     , playing_(false)
     , volume_(1.f)
+    , stream_queue_(nullptr)
 {
 }
 
@@ -67,6 +79,13 @@ bool Sound::Load(RefPtr<AudioData> data)
 
     if (opened_)
     {
+        // reuse the voice if the wave format does not change
+        if (!stream_queue_ && !data->IsStreaming() && IsSameFormat(data_->GetMeta(), data->GetMeta()))
+        {
+            Stop();
+            data_ = data;
+            return true;
+        }
         Close();
     }
     if (!Module::GetInstance().CreateSound(*this, data))
@@ -74,6 +93,13 @@ bool Sound::Load(RefPtr<AudioData> data)
         return false;
     }
 
+    if (data->IsStreaming())
+    {
+        auto voice    = GetNative<IXAudio2SourceVoice*>();
+        stream_queue_ = new AudioStreamQueue(static_cast<AudioStream*>(data.Get()), voice, GetCallbackChain());
+        stream_queue_->Prefetch();
+    }
+
     // reset volume
     ResetVolume();
 
@@ -90,6 +116,12 @@ void Sound::Play(int loop_count)
         return;
     }
 
+    if (stream_queue_)
+    {
+        playing_ = stream_queue_->Start(loop_count);
+        return;
+    }
+
     auto voice = GetNative<IXAudio2SourceVoice*>();
     KGE_ASSERT(voice != nullptr && "IXAudio2SourceVoice* is NULL");
 
@@ -156,6 +188,13 @@ void Sound::Resume()
 
 void Sound::Stop()
 {
+    if (stream_queue_)
+    {
+        stream_queue_->Stop();
+        playing_ = false;
+        return;
+    }
+
     auto voice = GetNative<IXAudio2SourceVoice*>();
     KGE_ASSERT(voice != nullptr && "IXAudio2SourceVoice* is NULL");
 
@@ -176,8 +215,25 @@ void Sound::Stop()
     }
 }
 
+bool Sound::Seek(Duration pos)
+{
+    if (!stream_queue_)
+    {
+        KGE_WARNF("Seeking is only supported by audio streams");
+        return false;
+    }
+    return stream_queue_->Seek(pos);
+}
+
 void Sound::Close()
 {
+    // the stream queue must be stopped before the voice is destroyed
+    if (stream_queue_)
+    {
+        delete stream_queue_;
+        stream_queue_ = nullptr;
+    }
+
     auto voice = GetNative<IXAudio2SourceVoice*>();
     if (voice)
     {
@@ -198,6 +254,9 @@ bool Sound::IsPlaying() const
         if (!playing_)
             return false;
 
+        if (stream_queue_)
+            return !stream_queue_->IsFinished();
+
         auto voice = GetNative<IXAudio2SourceVoice*>();
         if (!voice)
             return false;
@@ -20,7 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Resource.h>
-#include <kiwano-audio/AudioData.h>
+#include <kiwano-audio/AudioStream.h>
 
 namespace kiwano
 {
@@ -125,10 +125,19 @@ public:
     /// @brief ֹͣ
     void Stop();
 
+    /// \~chinese
+    /// @brief תָλ
+    /// @details Ƶ֧ת
+    bool Seek(Duration pos);
+
     /// \~chinese
     /// @brief رղԴ
     void Close();
 
+    /// \~chinese
+    /// @brief ǷΪʽ
+    bool IsStreaming() const;
+
     /// \~chinese
     /// @brief Ƿڲ
     bool IsPlaying() const;
@@ -155,6 +164,9 @@ public:
     const List<RefPtr<SoundCallback>>& GetCallbacks() const;
 
 protected:
+    /// \~chinese
+    /// @brief Ƶ
+    /// @details 뵱ǰݸʽͬʱѴԴ
     bool Load(RefPtr<AudioData> data);
 
     RefPtr<SoundCallback> GetCallbackChain();
@@ -166,6 +178,7 @@ private:
     bool              playing_;
     float             volume_;
     RefPtr<AudioData> data_;
+    AudioStreamQueue* stream_queue_;
 
     RefPtr<SoundCallback>       callback_chain_;
     List<RefPtr<SoundCallback>> callbacks_;
@@ -173,6 +186,11 @@ private:
 
 /** @} */
 
+inline bool Sound::IsStreaming() const
+{
+    return stream_queue_ != nullptr;
+}
+
 inline List<RefPtr<SoundCallback>>& kiwano::audio::Sound::GetCallbacks()
 {
     return callbacks_;
@@ -21,14 +21,37 @@
 #include <kiwano-audio/SoundPlayer.h>
 #include <kiwano-audio/Module.h>
 #include <kiwano/platform/Application.h>
+#include <kiwano/platform/FileSystem.h>
+#include <kiwano/utils/Profiler.h>
+#include <objbase.h>  // CoInitializeEx
 
 namespace kiwano
 {
 namespace audio
 {
 
+namespace
+{
+
+uint64_t GetFormatKey(const AudioMeta& meta)
+{
+    return (uint64_t(meta.format) << 56) | (uint64_t(meta.bits_per_sample) << 48) | (uint64_t(meta.channels) << 32)
+           | uint64_t(meta.samples_per_sec);
+}
+
+// voices whose flushed buffers are not drained within this time are destroyed instead of pooled
+const Duration kVoiceDrainTimeout = time::Millisecond * 500;
+
+}  // namespace
+
 SoundPlayer::SoundPlayer()
     : volume_(1.f)
+    , voice_pool_limit_(16)
+    , trash_retry_posted_(false)
+    , stream_evicted_(false)
+    , cache_budget_(0)
+    , cache_bytes_(0)
+    , handle_(std::make_shared<SoundPlayer*>(this))
 {
     class SoundCallbackFunc : public SoundCallback
     {
@@ -53,19 +76,55 @@ SoundPlayer::SoundPlayer()
     callback_ = cb;
 }
 
-SoundPlayer::~SoundPlayer() {}
+SoundPlayer::~SoundPlayer()
+{
+    // wait for the preload workers
+    for (auto& batch : preload_batches_)
+    {
+        for (auto& thread : batch->threads)
+        {
+            if (thread.joinable())
+                thread.join();
+        }
+    }
+    ClearVoicePool();
+
+    // the player is destroyed on the main thread, pending main thread tasks will skip it
+    *handle_ = nullptr;
+}
 
 RefPtr<AudioData> SoundPlayer::Preload(StringView file_path)
 {
     size_t hash_code = std::hash<String>{}(file_path);
-    if (cache_.count(hash_code))
+
+    auto iter = cache_.find(hash_code);
+    if (iter != cache_.end())
     {
-        return cache_.at(hash_code);
+        cache_lru_.splice(cache_lru_.begin(), cache_lru_, iter->second.lru);
+        return Reload(iter->second);
     }
-    RefPtr<AudioData> ptr = Module::GetInstance().Decode(file_path);
+
+    RefPtr<AudioData> ptr;
+
+    // wait for the preload worker instead of decoding it twice
+    auto pending = pending_preloads_.find(hash_code);
+    if (pending != pending_preloads_.end())
+    {
+        ptr = pending->second.get();
+        pending_preloads_.erase(pending);
+    }
+    else
+    {
+        ptr = Module::GetInstance().Decode(file_path);
+    }
+
     if (ptr)
     {
-        cache_.insert(std::make_pair(hash_code, ptr));
+        CacheEntry entry;
+        entry.data      = ptr;
+        entry.file_path = file_path;
+        entry.ext       = FileSystem::GetInstance().GetFileExt(file_path);
+        InsertCache(hash_code, std::move(entry));
     }
     return ptr;
 }
@@ -73,42 +132,452 @@ RefPtr<AudioData> SoundPlayer::Preload(StringView file_path)
 RefPtr<AudioData> SoundPlayer::Preload(const Resource& res, StringView ext)
 {
     size_t hash_code = res.GetId();
-    if (cache_.count(hash_code))
+
+    auto iter = cache_.find(hash_code);
+    if (iter != cache_.end())
     {
-        return cache_.at(hash_code);
+        cache_lru_.splice(cache_lru_.begin(), cache_lru_, iter->second.lru);
+        return Reload(iter->second);
     }
+
     RefPtr<AudioData> ptr = Module::GetInstance().Decode(res, ext);
     if (ptr)
     {
-        cache_.insert(std::make_pair(hash_code, ptr));
+        CacheEntry entry;
+        entry.data = ptr;
+        entry.res  = res;
+        entry.ext  = ext;
+        InsertCache(hash_code, std::move(entry));
     }
     return ptr;
 }
 
+Vector<SoundPlayer::PreloadFuture> SoundPlayer::PreloadAsync(const Vector<String>& file_paths, uint32_t max_concurrency)
+{
+    Vector<PreloadFuture> futures;
+    StartPreload(file_paths, max_concurrency, futures);
+    return futures;
+}
+
+Vector<RefPtr<AudioData>> SoundPlayer::Preload(const Vector<String>& file_paths, uint32_t max_concurrency)
+{
+    Vector<PreloadFuture> futures;
+
+    auto batch = StartPreload(file_paths, max_concurrency, futures);
+    if (batch)
+    {
+        for (auto& thread : batch->threads)
+        {
+            thread.join();
+        }
+        CollectPreloaded(batch.get());
+    }
+
+    Vector<RefPtr<AudioData>> result;
+    result.reserve(futures.size());
+    for (auto& future : futures)
+    {
+        result.push_back(future.get());
+    }
+    return result;
+}
+
+std::shared_ptr<SoundPlayer::PreloadBatch> SoundPlayer::StartPreload(const Vector<String>& file_paths,
+                                                                     uint32_t               max_concurrency,
+                                                                     Vector<PreloadFuture>& futures)
+{
+    auto batch       = std::make_shared<PreloadBatch>();
+    batch->player    = handle_;
+    batch->next_task = 0;
+    batch->running   = 0;
+
+    // workers decode with the format at the time of the request, SetNormalizedFormat may be called meanwhile
+    batch->normalize = Module::GetInstance().GetNormalizedFormat(batch->normalized_meta);
+
+    futures.reserve(file_paths.size());
+    for (const auto& file_path : file_paths)
+    {
+        size_t hash_code = std::hash<String>{}(file_path);
+
+        // cached or decoding audio data is shared
+        auto iter = cache_.find(hash_code);
+        if (iter != cache_.end() && iter->second.data)
+        {
+            std::promise<RefPtr<AudioData>> promise;
+            promise.set_value(iter->second.data);
+            futures.push_back(promise.get_future().share());
+            continue;
+        }
+
+        auto pending = pending_preloads_.find(hash_code);
+        if (pending != pending_preloads_.end())
+        {
+            futures.push_back(pending->second);
+            continue;
+        }
+
+        // workers only see absolute paths, FileSystem lookups are not thread-safe
+        PreloadTask task;
+        task.key       = hash_code;
+        task.full_path = FileSystem::GetInstance().GetFullPathForFile(file_path);
+
+        PreloadFuture future = task.promise.get_future().share();
+        futures.push_back(future);
+        pending_preloads_.insert(std::make_pair(hash_code, future));
+        batch->tasks.push_back(std::move(task));
+    }
+
+    if (batch->tasks.empty())
+    {
+        return nullptr;
+    }
+
+    uint32_t thread_count = max_concurrency ? max_concurrency : std::thread::hardware_concurrency();
+    thread_count          = std::max(1u, std::min(thread_count, uint32_t(batch->tasks.size())));
+
+    batch->running = thread_count;
+    for (uint32_t i = 0; i < thread_count; ++i)
+    {
+        batch->threads.emplace_back(&SoundPlayer::PreloadWorker, batch);
+    }
+    preload_batches_.push_back(batch);
+    return batch;
+}
+
+void SoundPlayer::PreloadWorker(std::shared_ptr<PreloadBatch> batch)
+{
+    // Media Foundation decoders require COM on the calling thread
+    HRESULT hr = ::CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+    Profiler::GetInstance().SetThreadName("Audio Preload");
+
+    while (true)
+    {
+        size_t index = batch->next_task++;
+        if (index >= batch->tasks.size())
+            break;
+
+        auto& task = batch->tasks[index];
+        if (task.full_path.empty())
+            task.promise.set_value(nullptr);
+        else
+            task.promise.set_value(Module::GetInstance().Decode(
+                task.full_path, batch->normalize ? &batch->normalized_meta : nullptr));
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        ::CoUninitialize();
+    }
+
+    // the last worker hands the results to the main thread, unless the player is gone or
+    // a synchronous Preload has collected the batch already
+    if (--batch->running == 0)
+    {
+        Application::GetInstance().PerformInMainThread([batch]() {
+            if (SoundPlayer* player = *batch->player)
+                player->CollectPreloaded(batch.get());
+        });
+    }
+}
+
+void SoundPlayer::CollectPreloaded(PreloadBatch* batch)
+{
+    auto iter = std::find_if(preload_batches_.begin(), preload_batches_.end(),
+                             [=](const std::shared_ptr<PreloadBatch>& ptr) { return ptr.get() == batch; });
+    if (iter == preload_batches_.end())
+        return;
+
+    for (auto& thread : batch->threads)
+    {
+        if (thread.joinable())
+            thread.join();
+    }
+
+    for (const auto& task : batch->tasks)
+    {
+        // the audio data may have been taken by Preload already
+        auto pending = pending_preloads_.find(task.key);
+        if (pending == pending_preloads_.end())
+            continue;
+
+        RefPtr<AudioData> ptr = pending->second.get();
+        pending_preloads_.erase(pending);
+
+        if (!ptr)
+            continue;
+
+        auto cached = cache_.find(task.key);
+        if (cached == cache_.end())
+        {
+            CacheEntry entry;
+            entry.data      = ptr;
+            entry.file_path = task.full_path;
+            entry.ext       = FileSystem::GetInstance().GetFileExt(task.full_path);
+            InsertCache(task.key, std::move(entry));
+        }
+        else if (!cached->second.data)
+        {
+            // restore an evicted entry
+            auto& entry         = cached->second;
+            entry.data          = ptr;
+            entry.decoded_bytes = ptr->GetData().size;
+            cache_bytes_ += entry.decoded_bytes;
+            TrimCache(&entry);
+        }
+    }
+
+    // a pending main thread task may still hold the batch, release the decoded data now
+    batch->tasks.clear();
+    preload_batches_.erase(iter);
+}
+
 void SoundPlayer::Play(RefPtr<Sound> sound, int loop_count)
 {
     if (sound)
     {
         SetCallback(sound.Get());
         sound->Play(loop_count);
+
+        std::lock_guard<std::mutex> lock(mutex_);
         sound_list_.push_back(sound);
+        playing_info_[sound.Get()] = PlayingInfo{ std::hash<String>{}(""), 0, Time::Now() };
     }
 }
 
 RefPtr<Sound> SoundPlayer::Play(StringView file_path, int loop_count)
 {
-    RefPtr<Sound> sound = new Sound(Preload(file_path));
-    Play(sound, loop_count);
-    return sound;
+    return Play(file_path, "", 0, loop_count);
 }
 
 RefPtr<Sound> SoundPlayer::Play(const Resource& res, int loop_count)
 {
-    RefPtr<Sound> sound = new Sound(Preload(res));
-    Play(sound, loop_count);
+    return Play(res, "", 0, loop_count);
+}
+
+RefPtr<Sound> SoundPlayer::Play(StringView file_path, StringView group, int priority, int loop_count)
+{
+    size_t hash_code = std::hash<String>{}(file_path);
+    return Play(hash_code, Preload(file_path), group, priority, loop_count);
+}
+
+RefPtr<Sound> SoundPlayer::Play(const Resource& res, StringView group, int priority, int loop_count)
+{
+    size_t hash_code = res.GetId();
+    return Play(hash_code, Preload(res), group, priority, loop_count);
+}
+
+RefPtr<Sound> SoundPlayer::Play(size_t sound_key, RefPtr<AudioData> data, StringView group, int priority,
+                                int loop_count)
+{
+    if (!data)
+    {
+        return nullptr;
+    }
+
+    const size_t  group_key = std::hash<String>{}(group);
+    RefPtr<Sound> victim;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!AcceptVoice(sound_key, group_key, priority, victim))
+        {
+            ++stats_.rejected_voices;
+            return nullptr;
+        }
+    }
+
+    // the stolen voice must be stopped without holding the lock
+    if (victim)
+    {
+        StopSound(victim);
+    }
+
+    RefPtr<Sound> sound = AcquireSound(data);
+    SetCallback(sound.Get());
+    sound->Play(loop_count);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    sound_list_.push_back(sound);
+    playing_info_[sound.Get()] = PlayingInfo{ group_key, priority, Time::Now() };
     return sound;
 }
 
+void SoundPlayer::SetGroupConfig(StringView group, const SoundGroupConfig& config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    groups_[std::hash<String>{}(group)].config = config;
+}
+
+void SoundPlayer::ReserveVoices(const AudioMeta& meta, uint32_t count)
+{
+    RefPtr<AudioData> data = MakePtr<AudioData>(BinaryData(), meta);
+
+    SoundList reserved;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        RefPtr<Sound> sound = new Sound(data);
+        if (!sound->opened_)
+            break;
+        reserved.push_back(sound);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.created_voices += reserved.size();
+
+    auto& pool = voice_pool_[GetFormatKey(meta)];
+    while (!reserved.empty() && pool.size() < voice_pool_limit_)
+    {
+        pool.push_back(reserved.front());
+        reserved.pop_front();
+    }
+    // voices beyond the limit are released after the lock
+}
+
+void SoundPlayer::SetVoicePoolLimit(uint32_t limit)
+{
+    SoundList released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        voice_pool_limit_ = limit;
+        for (auto& pair : voice_pool_)
+        {
+            auto& pool = pair.second;
+            while (pool.size() > limit)
+            {
+                released.push_back(pool.back());
+                pool.pop_back();
+            }
+        }
+    }
+}
+
+void SoundPlayer::ClearVoicePool()
+{
+    UnorderedMap<uint64_t, SoundList> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released.swap(voice_pool_);
+    }
+}
+
+SoundPlayer::Stats SoundPlayer::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Stats stats         = stats_;
+    stats.active_voices = uint32_t(sound_list_.size());
+    stats.pooled_voices = 0;
+    for (const auto& pair : voice_pool_)
+    {
+        stats.pooled_voices += uint32_t(pair.second.size());
+    }
+    return stats;
+}
+
+bool SoundPlayer::AcceptVoice(size_t sound_key, size_t group_key, int priority, RefPtr<Sound>& victim)
+{
+    auto iter = groups_.find(group_key);
+    if (iter == groups_.end())
+    {
+        return true;
+    }
+
+    auto&       group  = iter->second;
+    const auto& config = group.config;
+    const Time  now    = Time::Now();
+
+    if (!config.retrigger_interval.IsZero())
+    {
+        auto last = group.last_trigger_time.find(sound_key);
+        if (last != group.last_trigger_time.end() && (now - last->second) < config.retrigger_interval)
+        {
+            return false;
+        }
+    }
+
+    if (config.max_voices > 0)
+    {
+        // find the voice with the lowest priority, the oldest one first
+        uint32_t           count     = 0;
+        Sound*             candidate = nullptr;
+        const PlayingInfo* info      = nullptr;
+        for (const auto& pair : playing_info_)
+        {
+            if (pair.second.group != group_key)
+                continue;
+
+            ++count;
+            if (!info || pair.second.priority < info->priority
+                || (pair.second.priority == info->priority && (pair.second.start_time - info->start_time) < Duration()))
+            {
+                candidate = pair.first;
+                info      = &pair.second;
+            }
+        }
+
+        if (count >= config.max_voices)
+        {
+            if (!config.steal_voices || !candidate || info->priority > priority)
+            {
+                return false;
+            }
+
+            auto sound_iter = std::find(sound_list_.begin(), sound_list_.end(), candidate);
+            if (sound_iter != sound_list_.end())
+            {
+                victim = *sound_iter;
+                sound_list_.erase(sound_iter);
+            }
+            playing_info_.erase(candidate);
+            ++stats_.stolen_voices;
+        }
+    }
+
+    group.last_trigger_time[sound_key] = now;
+    return true;
+}
+
+RefPtr<Sound> SoundPlayer::AcquireSound(RefPtr<AudioData> data)
+{
+    RefPtr<Sound> sound;
+    if (!data->IsStreaming())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = voice_pool_.find(GetFormatKey(data->GetMeta()));
+        if (iter != voice_pool_.end() && !iter->second.empty())
+        {
+            sound = iter->second.back();
+            iter->second.pop_back();
+        }
+    }
+
+    if (sound && sound->Load(data))
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.reused_voices;
+        return sound;
+    }
+
+    sound = new Sound(data);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.created_voices;
+    return sound;
+}
+
+void SoundPlayer::StopSound(RefPtr<Sound> sound)
+{
+    RemoveCallback(sound.Get());
+    sound->Stop();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trash_.push_back(sound);
+    }
+    PostClearTrash();
+}
+
 float SoundPlayer::GetVolume() const
 {
     return volume_;
@@ -117,7 +586,13 @@ float SoundPlayer::GetVolume() const
 void SoundPlayer::SetVolume(float volume)
 {
     volume_ = volume;
-    for (auto& sound : sound_list_)
+
+    SoundList sounds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sounds = sound_list_;
+    }
+    for (auto& sound : sounds)
     {
         sound->ResetVolume();
     }
@@ -125,7 +600,12 @@ void SoundPlayer::SetVolume(float volume)
 
 void SoundPlayer::PauseAll()
 {
-    for (auto& sound : sound_list_)
+    SoundList sounds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sounds = sound_list_;
+    }
+    for (auto& sound : sounds)
     {
         sound->Pause();
     }
@@ -133,7 +613,12 @@ void SoundPlayer::PauseAll()
 
 void SoundPlayer::ResumeAll()
 {
-    for (auto& sound : sound_list_)
+    SoundList sounds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sounds = sound_list_;
+    }
+    for (auto& sound : sounds)
     {
         sound->Resume();
     }
@@ -141,7 +626,12 @@ void SoundPlayer::ResumeAll()
 
 void SoundPlayer::StopAll()
 {
-    for (auto& sound : sound_list_)
+    SoundList sounds;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sounds = sound_list_;
+    }
+    for (auto& sound : sounds)
     {
         sound->Stop();
     }
@@ -150,6 +640,123 @@ void SoundPlayer::StopAll()
 void SoundPlayer::ClearCache()
 {
     cache_.clear();
+    cache_lru_.clear();
+    cache_bytes_ = 0;
+}
+
+void SoundPlayer::SetCacheBudget(size_t bytes)
+{
+    cache_budget_ = bytes;
+    TrimCache(nullptr);
+}
+
+void SoundPlayer::SetStreamEvicted(bool enabled)
+{
+    stream_evicted_ = enabled;
+}
+
+SoundPlayer::CacheStats SoundPlayer::GetCacheStats() const
+{
+    CacheStats stats    = cache_stats_;
+    stats.budget_bytes  = cache_budget_;
+    stats.decoded_bytes = cache_bytes_;
+    stats.entries       = uint32_t(cache_.size());
+    for (const auto& pair : cache_)
+    {
+        const auto& entry = pair.second;
+        if (!entry.data)
+        {
+            stats.evicted_entries++;
+            stats.compressed_bytes += entry.compressed.size();
+            if (entry.decoded_bytes > entry.compressed.size())
+                stats.saved_bytes += entry.decoded_bytes - entry.compressed.size();
+        }
+    }
+    return stats;
+}
+
+RefPtr<AudioData> SoundPlayer::Reload(CacheEntry& entry)
+{
+    if (entry.data)
+    {
+        return entry.data;
+    }
+
+    // streams read the compressed data directly and are never cached
+    if (stream_evicted_)
+    {
+        RefPtr<AudioData> stream;
+        if (entry.file_path.empty())
+            stream = Module::GetInstance().OpenStream(entry.res, entry.ext);
+        else
+            stream = Module::GetInstance().OpenStream(entry.file_path);
+
+        if (stream)
+        {
+            cache_stats_.streams++;
+            return stream;
+        }
+    }
+
+    RefPtr<AudioData> ptr;
+    if (!entry.compressed.empty())
+        ptr = Module::GetInstance().Decode(BinaryData{ entry.compressed.data(), entry.compressed.size() }, entry.ext);
+    else if (entry.file_path.empty())
+        ptr = Module::GetInstance().Decode(entry.res, entry.ext);
+    else
+        ptr = Module::GetInstance().Decode(entry.file_path);
+
+    if (ptr)
+    {
+        cache_stats_.redecodes++;
+
+        entry.data          = ptr;
+        entry.decoded_bytes = ptr->GetData().size;
+        cache_bytes_ += entry.decoded_bytes;
+        TrimCache(&entry);
+    }
+    return ptr;
+}
+
+void SoundPlayer::InsertCache(size_t key, CacheEntry&& entry)
+{
+    cache_lru_.push_front(key);
+
+    entry.decoded_bytes = entry.data->GetData().size;
+    entry.lru           = cache_lru_.begin();
+    cache_bytes_ += entry.decoded_bytes;
+
+    auto iter = cache_.insert(std::make_pair(key, std::move(entry))).first;
+    TrimCache(&iter->second);
+}
+
+void SoundPlayer::TrimCache(const CacheEntry* keep)
+{
+    if (cache_budget_ == 0)
+    {
+        return;
+    }
+
+    for (auto iter = cache_lru_.rbegin(); iter != cache_lru_.rend() && cache_bytes_ > cache_budget_; ++iter)
+    {
+        auto& entry = cache_.at(*iter);
+        if (&entry == keep)
+            continue;
+
+        // data referenced by sounds or users is still in use
+        if (!entry.data || entry.data->GetRefCount() > 1)
+            continue;
+
+        // keep the compressed file data resident so that it can be decoded without touching the disk
+        if (!stream_evicted_ && entry.compressed.empty() && !entry.file_path.empty())
+        {
+            FileSystem::GetInstance().ReadFile(entry.file_path, entry.compressed);
+        }
+
+        cache_bytes_ -= entry.decoded_bytes;
+        entry.data = nullptr;
+        cache_stats_.evictions++;
+    }
 }
 
 void SoundPlayer::OnEnd(Sound* sound)
@@ -158,15 +765,20 @@ void SoundPlayer::OnEnd(Sound* sound)
     RemoveCallback(sound);
 
     // remove sound after stopped
-    auto iter = std::find(sound_list_.begin(), sound_list_.end(), sound);
-    if (iter != sound_list_.end())
     {
-        trash_.push_back(*iter);
-        sound_list_.erase(iter);
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto iter = std::find(sound_list_.begin(), sound_list_.end(), sound);
+        if (iter != sound_list_.end())
+        {
+            trash_.push_back(*iter);
+            sound_list_.erase(iter);
+        }
+        playing_info_.erase(sound);
     }
 
     // clear trash in main thread
-    Application::GetInstance().PerformInMainThread(std::bind(&SoundPlayer::ClearTrash, this));
+    PostClearTrash();
 }
 
 float SoundPlayer::OnVolumeChanged(Sound* sound, float volume)
@@ -198,7 +810,87 @@ void SoundPlayer::RemoveCallback(Sound* sound)
 
 void SoundPlayer::ClearTrash()
 {
-    trash_.clear();
+    SoundList trash;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        trash.swap(trash_);
+    }
+
+    SoundList  released;
+    const Time now = Time::Now();
+    for (auto& sound : trash)
+    {
+        // sounds still held by the user can not be reused
+        if (sound->GetRefCount() > 1 || !sound->opened_ || sound->IsStreaming())
+            released.push_back(sound);
+        else
+            draining_voices_.push_back(DrainingVoice{ sound, now });
+    }
+
+    for (auto iter = draining_voices_.begin(); iter != draining_voices_.end();)
+    {
+        // wait for the flushed buffers, or their callbacks may reach the next owner
+        XAUDIO2_VOICE_STATE state;
+        iter->sound->GetNative<IXAudio2SourceVoice*>()->GetState(&state);
+        if (!state.BuffersQueued)
+        {
+            RecycleVoice(iter->sound, released);
+        }
+        else if ((now - iter->trashed_time) >= kVoiceDrainTimeout)
+        {
+            // the voice never drained, destroy it rather than pooling it
+            released.push_back(iter->sound);
+        }
+        else
+        {
+            ++iter;
+            continue;
+        }
+        iter = draining_voices_.erase(iter);
+    }
+
+    // retry once per frame while some voices are still draining
+    if (!draining_voices_.empty() && !trash_retry_posted_)
+    {
+        trash_retry_posted_ = true;
+        Application::GetInstance().PerformInMainThread([handle = handle_]() {
+            if (SoundPlayer* player = *handle)
+            {
+                player->trash_retry_posted_ = false;
+                player->ClearTrash();
+            }
+        });
+    }
+    // released sounds destroy their voices here, outside of the lock
+}
+
+void SoundPlayer::PostClearTrash()
+{
+    // the player may be destroyed before the main thread runs the task
+    Application::GetInstance().PerformInMainThread([handle = handle_]() {
+        if (SoundPlayer* player = *handle)
+            player->ClearTrash();
+    });
+}
+
+void SoundPlayer::RecycleVoice(RefPtr<Sound> sound, SoundList& released)
+{
+    // pooled sounds must not keep the decoded data alive
+    const auto meta = sound->data_->GetMeta();
+    sound->data_    = MakePtr<AudioData>(BinaryData(), meta);
+
+    // the next owner must not inherit the volume or callbacks of the previous one
+    sound->callbacks_.clear();
+    sound->volume_ = 1.f;
+    sound->ResetVolume();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& pool = voice_pool_[GetFormatKey(meta)];
+    if (pool.size() < voice_pool_limit_)
+        pool.push_back(sound);
+    else
+        released.push_back(sound);
 }
 
 }  // namespace audio
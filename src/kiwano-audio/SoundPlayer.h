@@ -20,6 +20,11 @@
 
 #pragma once
 #include <kiwano-audio/Sound.h>
+#include <kiwano/core/Time.h>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
 
 namespace kiwano
 {
@@ -31,15 +36,57 @@ namespace audio
  * @{
  */
 
+/**
+ * \~chinese
+ * @brief Ƶ
+ */
+struct SoundGroupConfig
+{
+    uint32_t max_voices   = 0;     ///< ͬʱŵƵ0 ʾ
+    bool     steal_voices = true;  ///< ﵽʱǷֹͣȼƵ粥ŵƵ
+    Duration retrigger_interval;   ///< ͬһƵβŵСڵĲᱻܾ
+};
+
 /**
  * \~chinese
  * @brief Ƶ
+ * @details Ƶʽ沥ŽƵٴβͬʽƵʱԴ
+ * ְ֧Ƶͬʱŵ
  */
 class KGE_API SoundPlayer : public ObjectBase
 {
 public:
     using SoundList = List<RefPtr<Sound>>;
 
+    using PreloadFuture = std::shared_future<RefPtr<AudioData>>;
+
+    /// \~chinese
+    /// @brief ͳ
+    struct Stats
+    {
+        uint32_t active_voices   = 0;  ///< ڲŵƵ
+        uint32_t pooled_voices   = 0;  ///< ĿƵ
+        uint64_t created_voices  = 0;  ///< Դ
+        uint64_t reused_voices   = 0;  ///< õԴ
+        uint64_t stolen_voices   = 0;  ///< ռƵ
+        uint64_t rejected_voices = 0;  ///< ܾĲ
+    };
+
+    /// \~chinese
+    /// @brief Ƶͳ
+    struct CacheStats
+    {
+        size_t   budget_bytes     = 0;  ///< ݵڴԤ
+        size_t   decoded_bytes    = 0;  ///< פڴĽݴС
+        size_t   compressed_bytes = 0;  ///< ̭ƵѹݴС
+        size_t   saved_bytes      = 0;  ///< ̭ݽʡڴС
+        uint32_t entries          = 0;  ///< Ƶ
+        uint32_t evicted_entries  = 0;  ///< ǰ̭״̬Ƶ
+        uint64_t evictions        = 0;  ///< ̭
+        uint64_t redecodes        = 0;  ///< ½
+        uint64_t streams          = 0;  ///< ƵݵĴ
+    };
+
     SoundPlayer();
 
     ~SoundPlayer();
@@ -53,6 +100,22 @@ public:
     /// @brief ԤƵԴ
     RefPtr<AudioData> Preload(const Resource& res, StringView ext = "");
 
+    /// \~chinese
+    /// @brief ԤضƵ
+    /// @details ڹ߳нƵ߳м뻺档Ƶʱ Module õͳһʽ룬
+    /// ֮޸ͳһʽӰѿʼԤ
+    /// @param file_paths Ƶļ·
+    /// @param max_concurrency 󲢷߳0 ʾʹȫ
+    /// @return ļ·һһӦĽʧܵĽΪ
+    Vector<PreloadFuture> PreloadAsync(const Vector<String>& file_paths, uint32_t max_concurrency = 0);
+
+    /// \~chinese
+    /// @brief ԤضƵȴȫƵ
+    /// @param file_paths Ƶļ·
+    /// @param max_concurrency 󲢷߳0 ʾʹȫ
+    /// @return ļ·һһӦƵݣʧܵΪ
+    Vector<RefPtr<AudioData>> Preload(const Vector<String>& file_paths, uint32_t max_concurrency = 0);
+
     /// \~chinese
     /// @brief Ƶ
     /// @param sound Ƶ
@@ -71,6 +134,48 @@ public:
     /// @param loop_count ѭ -1 Ϊѭ
     RefPtr<Sound> Play(const Resource& res, int loop_count = 0);
 
+    /// \~chinese
+    /// @brief ƵвƵ
+    /// @param file_path Ƶļ·
+    /// @param group Ƶ
+    /// @param priority ȼﵽƵʱȼߵƵռȼ͵Ƶ
+    /// @param loop_count ѭ -1 Ϊѭ
+    /// @return Ƶ󱻾ܾʱؿ
+    RefPtr<Sound> Play(StringView file_path, StringView group, int priority = 0, int loop_count = 0);
+
+    /// \~chinese
+    /// @brief ƵвƵԴ
+    /// @param res ƵԴ
+    /// @param group Ƶ
+    /// @param priority ȼﵽƵʱȼߵƵռȼ͵Ƶ
+    /// @param loop_count ѭ -1 Ϊѭ
+    /// @return Ƶ󱻾ܾʱؿ
+    RefPtr<Sound> Play(const Resource& res, StringView group, int priority = 0, int loop_count = 0);
+
+    /// \~chinese
+    /// @brief Ƶ
+    /// @param group Ƶ
+    /// @param config 
+    void SetGroupConfig(StringView group, const SoundGroupConfig& config);
+
+    /// \~chinese
+    /// @brief ԤȴԴ
+    /// @param meta Ƶʽ
+    /// @param count 
+    void ReserveVoices(const AudioMeta& meta, uint32_t count);
+
+    /// \~chinese
+    /// @brief ÿƵʽƵĬΪ 16
+    void SetVoicePoolLimit(uint32_t limit);
+
+    /// \~chinese
+    /// @brief ջĿƵ
+    void ClearVoicePool();
+
+    /// \~chinese
+    /// @brief ȡͳ
+    Stats GetStats() const;
+
     /// \~chinese
     /// @brief ͣƵ
     void PauseAll();
@@ -100,6 +205,22 @@ public:
     /// @brief ջ
     void ClearCache();
 
+    /// \~chinese
+    /// @brief ýݵڴԤ
+    /// @details Ԥʱʹõ˳̭δʹеĽݣ̭Ƶֻѹݣ
+    /// ٴʹʱ½롣ԤΪ 0 ʱƣĬϣ
+    /// @param bytes Ԥֽ
+    void SetCacheBudget(size_t bytes);
+
+    /// \~chinese
+    /// @brief ṋ̃ƵǷƵķʽ
+    /// @details ̭Ƶ½룬ڲʱν
+    void SetStreamEvicted(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡƵͳ
+    CacheStats GetCacheStats() const;
+
 protected:
     void OnEnd(Sound* sound);
 
@@ -111,13 +232,110 @@ protected:
 
     void ClearTrash();
 
+    void PostClearTrash();
+
+    void RecycleVoice(RefPtr<Sound> sound, SoundList& released);
+
+    RefPtr<Sound> Play(size_t sound_key, RefPtr<AudioData> data, StringView group, int priority, int loop_count);
+
+    bool AcceptVoice(size_t sound_key, size_t group_key, int priority, RefPtr<Sound>& victim);
+
+    RefPtr<Sound> AcquireSound(RefPtr<AudioData> data);
+
+    void StopSound(RefPtr<Sound> sound);
+
+    struct CacheEntry;
+
+    struct PreloadBatch;
+
+    static void PreloadWorker(std::shared_ptr<PreloadBatch> batch);
+
+    std::shared_ptr<PreloadBatch> StartPreload(const Vector<String>& file_paths, uint32_t max_concurrency,
+                                               Vector<PreloadFuture>& futures);
+
+    void CollectPreloaded(PreloadBatch* batch);
+
+    RefPtr<AudioData> Reload(CacheEntry& entry);
+
+    void InsertCache(size_t key, CacheEntry&& entry);
+
+    void TrimCache(const CacheEntry* keep);
+
 protected:
+    struct CacheEntry
+    {
+        RefPtr<AudioData>      data;
+        size_t                 decoded_bytes = 0;
+        String                 file_path;
+        Resource               res;
+        String                 ext;
+        Vector<uint8_t>        compressed;
+        List<size_t>::iterator lru;
+    };
+
+    struct PreloadTask
+    {
+        size_t                          key;
+        String                          full_path;
+        std::promise<RefPtr<AudioData>> promise;
+    };
+
+    struct PreloadBatch
+    {
+        std::shared_ptr<SoundPlayer*> player;
+        bool                          normalize;
+        AudioMeta                     normalized_meta;
+        Vector<PreloadTask>           tasks;
+        Vector<std::thread>           threads;
+        std::atomic<size_t>           next_task;
+        std::atomic<uint32_t>         running;
+    };
+
+    struct DrainingVoice
+    {
+        RefPtr<Sound> sound;
+        Time          trashed_time;
+    };
+
+    struct PlayingInfo
+    {
+        size_t group;
+        int    priority;
+        Time   start_time;
+    };
+
+    struct SoundGroup
+    {
+        SoundGroupConfig           config;
+        UnorderedMap<size_t, Time> last_trigger_time;
+    };
+
     float                 volume_;
+    uint32_t              voice_pool_limit_;
     SoundList             sound_list_;
     SoundList             trash_;
+    List<DrainingVoice>   draining_voices_;
+    bool                  trash_retry_posted_;
     RefPtr<SoundCallback> callback_;
+    Stats                 stats_;
+    mutable std::mutex    mutex_;
+
+    bool                  stream_evicted_;
+    size_t                cache_budget_;
+    size_t                cache_bytes_;
+    List<size_t>          cache_lru_;
+    CacheStats            cache_stats_;
+
+    List<std::shared_ptr<PreloadBatch>> preload_batches_;
+    UnorderedMap<size_t, PreloadFuture> pending_preloads_;
+
+    // Ͷݵ̵߳ͨþʲٺÿ
+    std::shared_ptr<SoundPlayer*> handle_;
 
-    UnorderedMap<size_t, RefPtr<AudioData>> cache_;
+    UnorderedMap<size_t, CacheEntry>  cache_;
+    UnorderedMap<Sound*, PlayingInfo> playing_info_;
+    UnorderedMap<size_t, SoundGroup>  groups_;
+    UnorderedMap<uint64_t, SoundList> voice_pool_;
 };
 
 /** @} */
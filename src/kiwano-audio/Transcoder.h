@@ -20,7 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Resource.h>
-#include <kiwano-audio/AudioData.h>
+#include <kiwano-audio/AudioStream.h>
 
 namespace kiwano
 {
@@ -45,10 +45,48 @@ public:
 
     virtual RefPtr<AudioData> Decode(StringView file_path) = 0;
 
-    virtual RefPtr<AudioData> Decode(const Resource& res) = 0;
+    /// \~chinese
+    /// @brief ԴеƵĬϽԴĶ
+    virtual RefPtr<AudioData> Decode(const Resource& res);
+
+    /// \~chinese
+    /// @brief ڴеƵ
+    virtual RefPtr<AudioData> Decode(const BinaryData& data);
+
+    /// \~chinese
+    /// @brief Ƶ֧ʽʱؿ
+    virtual RefPtr<AudioStream> OpenStream(StringView file_path);
+
+    /// \~chinese
+    /// @brief ڴеƵ֧ʽʱؿ
+    /// @details ƵֱӶȡڴеݣƵǰݱ뱣Ч
+    virtual RefPtr<AudioStream> OpenStream(const BinaryData& data);
 };
 
 /** @} */
 
+inline RefPtr<AudioData> Transcoder::Decode(const Resource& res)
+{
+    return Decode(res.GetData());
+}
+
+inline RefPtr<AudioData> Transcoder::Decode(const BinaryData& data)
+{
+    KGE_NOT_USED(data);
+    return nullptr;
+}
+
+inline RefPtr<AudioStream> Transcoder::OpenStream(StringView file_path)
+{
+    KGE_NOT_USED(file_path);
+    return nullptr;
+}
+
+inline RefPtr<AudioStream> Transcoder::OpenStream(const BinaryData& data)
+{
+    KGE_NOT_USED(data);
+    return nullptr;
+}
+
 }  // namespace audio
 }  // namespace kiwano
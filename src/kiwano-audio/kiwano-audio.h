@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <kiwano-audio/AudioConverter.h>
+#include <kiwano-audio/Mixer.h>
 #include <kiwano-audio/Module.h>
 #include <kiwano-audio/Sound.h>
 #include <kiwano-audio/SoundPlayer.h>
@@ -0,0 +1,308 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+// Actor ֻ Windows Ϲﰴֶ˳ģǰ Actor ڴ沼֣
+// ִ Actor::Update / Actor::Render ֶͬηʣƽ̨϶Աȱ
+
+struct ModelMatrix
+{
+    float m[6];
+};
+
+struct ModelTransform
+{
+    float position[2];
+    float scale[2];
+    float skew[2];
+    float rotation;
+};
+
+const uint8_t kDirtyTransform = 1;
+
+// ǰǶ ComponentManager Уֶλڸ»ص֮
+struct LegacyActorLayout
+{
+    // ObjectBaseAnimatorTaskSchedulerEventDispatcher
+    void* object_base[9];
+    void* animations[2];
+    void* tasks[2];
+    void* listeners[5];
+
+    // ComponentManager
+    std::unordered_map<size_t, void*> components;
+    void*                             component_target;
+
+    // IntrusiveListValue
+    LegacyActorLayout* prev;
+    LegacyActorLayout* next;
+
+    bool    visible;
+    bool    update_pausing;
+    bool    cascade_opacity;
+    bool    show_border;
+    bool    visible_in_rt;
+    uint8_t dirty_flag;
+
+    int                z_order;
+    float              opacity;
+    float              displayed_opacity;
+    LegacyActorLayout* parent;
+    void*              stage;
+    size_t             hash_name;
+    float              anchor[2];
+    float              size[2];
+    LegacyActorLayout* first_child;
+    LegacyActorLayout* last_child;
+    void*              cb_update;
+    ModelTransform     transform;
+
+    ModelMatrix transform_matrix;
+    ModelMatrix transform_matrix_inverse;
+    ModelMatrix transform_matrix_to_parent;
+
+    bool HasComponents() const
+    {
+        return !components.empty();
+    }
+
+    bool HasUpdateCallback() const
+    {
+        return cb_update != nullptr;
+    }
+};
+
+// ͸»صƵ贴ⲿ洢ºȾʵֶΰ˳
+struct ActorLayout
+{
+    void* object_base[9];
+    void* animations[2];
+    void* tasks[2];
+    void* listeners[5];
+
+    void* components;
+    void* component_target;
+
+    ActorLayout* prev;
+    ActorLayout* next;
+
+    bool         visible;
+    bool         update_pausing;
+    bool         cascade_opacity;
+    bool         show_border;
+    bool         visible_in_rt;
+    uint8_t      dirty_flag;
+    int          z_order;
+    float        opacity;
+    ActorLayout* first_child;
+    ActorLayout* last_child;
+    void*        extra;
+
+    ActorLayout*   parent;
+    ModelTransform transform;
+    float          anchor[2];
+    float          size[2];
+    float          displayed_opacity;
+    ModelMatrix    transform_matrix;
+    ModelMatrix    transform_matrix_to_parent;
+
+    void*  stage;
+    size_t hash_name;
+
+    bool HasComponents() const
+    {
+        return components != nullptr;
+    }
+
+    bool HasUpdateCallback() const
+    {
+        return extra != nullptr;
+    }
+};
+
+template <typename _Node>
+void AddChild(_Node* parent, _Node* child)
+{
+    child->parent = parent;
+    child->prev   = parent->last_child;
+    if (parent->last_child)
+        parent->last_child->next = child;
+    else
+        parent->first_child = child;
+    parent->last_child = child;
+}
+
+//  CreateActorTree ͬ㴴ÿڵ 10 ӽڵ
+template <typename _Node>
+std::vector<std::unique_ptr<_Node>> CreateLayoutTree(int count)
+{
+    std::vector<std::unique_ptr<_Node>> nodes;
+    nodes.reserve(size_t(count));
+
+    size_t level_begin = 0;
+    size_t level_end   = 1;
+
+    nodes.emplace_back(new _Node());
+    while (int(nodes.size()) < count)
+    {
+        for (size_t p = level_begin; p < level_end && int(nodes.size()) < count; ++p)
+        {
+            for (int i = 0; i < 10 && int(nodes.size()) < count; ++i)
+            {
+                _Node* child = new _Node();
+                child->transform.position[0] = float(i);
+                child->transform.position[1] = 1.0f;
+                child->transform.rotation    = float(i);
+                AddChild(nodes[p].get(), child);
+                nodes.emplace_back(child);
+            }
+        }
+        level_begin = level_end;
+        level_end   = nodes.size();
+    }
+
+    for (auto& node : nodes)
+    {
+        node->visible            = true;
+        node->cascade_opacity    = true;
+        node->opacity            = 1.0f;
+        node->transform.scale[0] = 1.0f;
+        node->transform.scale[1] = 1.0f;
+    }
+    return nodes;
+}
+
+// Ӧ Actor::UpdateSelf
+template <typename _Node>
+void UpdateNode(_Node* node, float dt)
+{
+    for (_Node* child = node->first_child; child; child = child->next)
+        UpdateNode(child, dt);
+
+    int work = 0;
+    if (node->animations[0])
+        ++work;
+    if (node->tasks[0])
+        ++work;
+    if (node->HasComponents())
+        ++work;
+    if (!node->update_pausing && node->HasUpdateCallback())
+        ++work;
+    if (node->listeners[0])
+        ++work;
+    DoNotOptimize(work);
+
+    // ģÿ֡ƶĽɫ
+    node->transform.position[0] += dt;
+    node->dirty_flag |= kDirtyTransform;
+}
+
+// Ӧ Actor::Render е UpdateTransform  UpdateOpacity
+template <typename _Node>
+void RenderNode(_Node* node)
+{
+    if (!node->visible)
+        return;
+
+    if (node->dirty_flag & kDirtyTransform)
+    {
+        node->dirty_flag &= ~kDirtyTransform;
+
+        const ModelTransform& t = node->transform;
+
+        const float c = std::cos(t.rotation);
+        const float s = std::sin(t.rotation);
+
+        ModelMatrix& local = node->transform_matrix_to_parent;
+        local.m[0]         = c * t.scale[0];
+        local.m[1]         = s * t.scale[0];
+        local.m[2]         = -s * t.scale[1];
+        local.m[3]         = c * t.scale[1];
+        local.m[4]         = t.position[0] - node->size[0] * node->anchor[0];
+        local.m[5]         = t.position[1] - node->size[1] * node->anchor[1];
+
+        ModelMatrix& world = node->transform_matrix;
+        if (node->parent)
+        {
+            const ModelMatrix& p = node->parent->transform_matrix;
+
+            world.m[0] = local.m[0] * p.m[0] + local.m[1] * p.m[2];
+            world.m[1] = local.m[0] * p.m[1] + local.m[1] * p.m[3];
+            world.m[2] = local.m[2] * p.m[0] + local.m[3] * p.m[2];
+            world.m[3] = local.m[2] * p.m[1] + local.m[3] * p.m[3];
+            world.m[4] = local.m[4] * p.m[0] + local.m[5] * p.m[2] + p.m[4];
+            world.m[5] = local.m[4] * p.m[1] + local.m[5] * p.m[3] + p.m[5];
+        }
+        else
+        {
+            world = local;
+        }
+    }
+
+    node->displayed_opacity = node->opacity;
+    if (node->parent && node->parent->cascade_opacity)
+        node->displayed_opacity *= node->parent->displayed_opacity;
+
+    for (_Node* child = node->first_child; child; child = child->next)
+        RenderNode(child);
+}
+
+template <typename _Node>
+void RunLayoutTraversal(State& state)
+{
+    auto nodes = CreateLayoutTree<_Node>(int(state.GetArg()));
+
+    while (state.KeepRunning())
+    {
+        UpdateNode(nodes[0].get(), 0.016f);
+        RenderNode(nodes[0].get());
+    }
+    state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+    state.SetBytesProcessed(state.GetIterations() * state.GetArg() * int64_t(sizeof(_Node)));
+    state.SetLabel("sizeof=" + std::to_string(sizeof(_Node)));
+}
+
+}  // namespace
+
+KGE_BENCHMARK(ActorLayout_TraversalLegacy, 10000, 200000)
+{
+    RunLayoutTraversal<LegacyActorLayout>(state);
+}
+
+KGE_BENCHMARK(ActorLayout_Traversal, 10000, 200000)
+{
+    RunLayoutTraversal<ActorLayout>(state);
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,395 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano-bench/OggClips.h>
+#include <3rd-party/vorbis/vorbisenc.h>
+#include <3rd-party/vorbis/vorbisfile.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+const int kSampleRate = 44100;
+const int kChannels   = 2;
+const int kSeconds    = 5;
+
+void AppendPage(std::vector<uint8_t>& data, const ogg_page& page)
+{
+    data.insert(data.end(), page.header, page.header + page.header_len);
+    data.insert(data.end(), page.body, page.body + page.body_len);
+}
+
+// ֿû ogg ԴļڴнһҲΪ ogg Ϊ
+std::vector<uint8_t> EncodeSineWave(float left_freq = 440.0f, float right_freq = 660.0f)
+{
+    std::vector<uint8_t> data;
+
+    vorbis_info info;
+    vorbis_info_init(&info);
+    if (vorbis_encode_init_vbr(&info, kChannels, kSampleRate, 0.4f) != 0)
+    {
+        vorbis_info_clear(&info);
+        return data;
+    }
+
+    vorbis_comment comment;
+    vorbis_comment_init(&comment);
+
+    vorbis_dsp_state dsp;
+    vorbis_block     block;
+    vorbis_analysis_init(&dsp, &info);
+    vorbis_block_init(&dsp, &block);
+
+    ogg_stream_state stream;
+    ogg_stream_init(&stream, 1);
+
+    ogg_packet header, header_comment, header_code;
+    vorbis_analysis_headerout(&dsp, &comment, &header, &header_comment, &header_code);
+    ogg_stream_packetin(&stream, &header);
+    ogg_stream_packetin(&stream, &header_comment);
+    ogg_stream_packetin(&stream, &header_code);
+
+    ogg_page page;
+    while (ogg_stream_flush(&stream, &page) != 0)
+        AppendPage(data, page);
+
+    const int total_frames = kSampleRate * kSeconds;
+    int       frame        = 0;
+    bool      eos          = false;
+    while (!eos)
+    {
+        int frames = (std::min)(1024, total_frames - frame);
+        if (frames > 0)
+        {
+            float** buffer = vorbis_analysis_buffer(&dsp, frames);
+            for (int i = 0; i < frames; ++i)
+            {
+                float t      = float(frame + i) / kSampleRate;
+                buffer[0][i] = 0.5f * std::sin(2.0f * 3.14159265f * left_freq * t);
+                buffer[1][i] = 0.5f * std::sin(2.0f * 3.14159265f * right_freq * t);
+            }
+            frame += frames;
+        }
+        vorbis_analysis_wrote(&dsp, frames);
+
+        while (vorbis_analysis_blockout(&dsp, &block) == 1)
+        {
+            vorbis_analysis(&block, nullptr);
+            vorbis_bitrate_addblock(&block);
+
+            ogg_packet packet;
+            while (vorbis_bitrate_flushpacket(&dsp, &packet))
+            {
+                ogg_stream_packetin(&stream, &packet);
+                while (ogg_stream_pageout(&stream, &page) != 0)
+                {
+                    AppendPage(data, page);
+                    if (ogg_page_eos(&page))
+                        eos = true;
+                }
+            }
+        }
+    }
+
+    ogg_stream_clear(&stream);
+    vorbis_block_clear(&block);
+    vorbis_dsp_clear(&dsp);
+    vorbis_comment_clear(&comment);
+    vorbis_info_clear(&info);
+    return data;
+}
+
+const std::vector<uint8_t>& GetOggData()
+{
+    static std::vector<uint8_t> data = EncodeSineWave();
+    return data;
+}
+
+struct MemorySource
+{
+    const uint8_t* data;
+    size_t         size;
+    size_t         pos;
+};
+
+size_t ReadMemory(void* ptr, size_t size, size_t nmemb, void* datasource)
+{
+    auto source = static_cast<MemorySource*>(datasource);
+
+    const size_t bytes = (std::min)(size * nmemb, source->size - source->pos);
+    if (bytes > 0)
+    {
+        std::memcpy(ptr, source->data + source->pos, bytes);
+        source->pos += bytes;
+    }
+    return size ? bytes / size : 0;
+}
+
+int SeekMemory(void* datasource, ogg_int64_t offset, int whence)
+{
+    auto source = static_cast<MemorySource*>(datasource);
+
+    ogg_int64_t pos = 0;
+    switch (whence)
+    {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = ogg_int64_t(source->pos) + offset;
+        break;
+    case SEEK_END:
+        pos = ogg_int64_t(source->size) + offset;
+        break;
+    default:
+        return -1;
+    }
+
+    if (pos < 0 || pos > ogg_int64_t(source->size))
+        return -1;
+
+    source->pos = size_t(pos);
+    return 0;
+}
+
+long TellMemory(void* datasource)
+{
+    return long(static_cast<MemorySource*>(datasource)->pos);
+}
+
+bool OpenMemory(MemorySource* source, OggVorbis_File* vf)
+{
+    const auto& data = GetOggData();
+
+    source->data = data.data();
+    source->size = data.size();
+    source->pos  = 0;
+
+    ov_callbacks callbacks = { ReadMemory, SeekMemory, nullptr, TellMemory };
+    return ov_open_callbacks(source, vf, nullptr, 0, callbacks) == 0;
+}
+
+std::vector<std::string> WriteOggClipFiles(size_t count)
+{
+    std::vector<std::string> files;
+
+    std::error_code       ec;
+    std::filesystem::path dir = std::filesystem::temp_directory_path(ec) / "kiwano-bench-ogg";
+    if (ec || (std::filesystem::create_directories(dir, ec), ec))
+        return files;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        // ÿļʹòͬƵʣȫͬ
+        const float freq = 220.0f + 55.0f * float(i);
+        const auto  data = EncodeSineWave(freq, freq * 1.5f);
+
+        const std::string path = (dir / ("clip_" + std::to_string(i) + ".ogg")).string();
+        std::FILE*        file = std::fopen(path.c_str(), "wb");
+        if (!file)
+            return {};
+
+        const bool written = !data.empty() && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        std::fclose(file);
+        if (!written)
+            return {};
+
+        files.push_back(path);
+    }
+    return files;
+}
+
+//  OggTranscoder::Decode ͬļ 4096 ֽڷֿ齫ƵΪ 16 λ PCM
+bool DecodeFileToPcm(const std::string& path, std::vector<char>& pcm)
+{
+    OggVorbis_File vf;
+    if (ov_fopen(path.c_str(), &vf) != 0)
+        return false;
+
+    const vorbis_info* info = ov_info(&vf, -1);
+    const size_t       step = 4096;
+
+    pcm.resize(size_t(ov_time_total(&vf, -1) * info->rate * info->channels * 2) + 1);
+
+    int    bitstream = 0;
+    long   read      = 0;
+    size_t offset    = 0;
+    while (true)
+    {
+        if (pcm.size() < offset + 1)
+            pcm.resize(offset + step);
+
+        read = ov_read(&vf, pcm.data() + offset, int((std::min)(step, pcm.size() - offset)), 0, 2, 1, &bitstream);
+        if (read <= 0)
+            break;
+        offset += size_t(read);
+    }
+    ov_clear(&vf);
+
+    pcm.resize(offset);
+    return read == 0;
+}
+
+}  // namespace
+
+const std::vector<std::string>& GetOggClipFiles()
+{
+    static std::vector<std::string> files = WriteOggClipFiles(16);
+    return files;
+}
+
+KGE_BENCHMARK(Ogg_Decode)
+{
+    if (GetOggData().empty())
+    {
+        state.SkipWithError("encode ogg data failed");
+        return;
+    }
+
+    std::vector<char> buffer(4096);
+    int64_t           bytes = 0;
+
+    while (state.KeepRunning())
+    {
+        MemorySource   source;
+        OggVorbis_File vf;
+        if (!OpenMemory(&source, &vf))
+        {
+            state.SkipWithError("open ogg data failed");
+            break;
+        }
+
+        int  bitstream = 0;
+        long read      = 0;
+        while ((read = ov_read(&vf, buffer.data(), int(buffer.size()), 0, 2, 1, &bitstream)) > 0)
+            bytes += read;
+        ov_clear(&vf);
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+KGE_BENCHMARK(Ogg_DecodeFloat)
+{
+    if (GetOggData().empty())
+    {
+        state.SkipWithError("encode ogg data failed");
+        return;
+    }
+
+    int64_t bytes = 0;
+
+    while (state.KeepRunning())
+    {
+        MemorySource   source;
+        OggVorbis_File vf;
+        if (!OpenMemory(&source, &vf))
+        {
+            state.SkipWithError("open ogg data failed");
+            break;
+        }
+
+        int     bitstream = 0;
+        long    frames    = 0;
+        float** pcm       = nullptr;
+        while ((frames = ov_read_float(&vf, &pcm, 1024, &bitstream)) > 0)
+        {
+            DoNotOptimize(pcm[0][0]);
+            bytes += frames * kChannels * int64_t(sizeof(float));
+        }
+        ov_clear(&vf);
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+// Ϊ߳ģ SoundPlayer::Preload Ḷ́߳ỵ̈߳ӹȡļ
+// ʱĿ¼ȡ롣Windows  SoundPlayer_Preload ֱӵԤؽӿ
+KGE_BENCHMARK(Ogg_PreloadBatch, 1, 2, 4, 8)
+{
+    const auto& files = GetOggClipFiles();
+    if (files.empty())
+    {
+        state.SkipWithError("write ogg files failed");
+        return;
+    }
+
+    const uint32_t worker_count = uint32_t(state.GetArg());
+
+    std::vector<std::vector<char>> clips(files.size());
+    int64_t                        bytes = 0;
+    bool                           ok    = true;
+
+    while (state.KeepRunning())
+    {
+        std::atomic<size_t> next_task(0);
+        std::atomic<bool>   failed(false);
+
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back([&]() {
+                size_t index = 0;
+                while ((index = next_task++) < files.size())
+                {
+                    if (!DecodeFileToPcm(files[index], clips[index]))
+                        failed = true;
+                }
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (failed)
+        {
+            ok = false;
+            break;
+        }
+
+        for (const auto& clip : clips)
+            bytes += int64_t(clip.size());
+    }
+
+    if (!ok)
+    {
+        state.SkipWithError("decode ogg files failed");
+        return;
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.GetIterations() * int64_t(files.size()));
+    state.SetLabel("workers=" + std::to_string(worker_count)
+                   + " cores=" + std::to_string(std::thread::hardware_concurrency()));
+}
+
+}  // namespace bench
+}  // namespace kiwano
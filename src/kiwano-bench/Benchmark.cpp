@@ -0,0 +1,488 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <thread>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+struct Benchmark
+{
+    std::string name;
+    Function    func;
+    int64_t     arg;
+};
+
+struct Result
+{
+    std::string name;
+    std::string run_name;
+    std::string label;
+    std::string error;
+    int         repetition;
+    int64_t     iterations;
+    double      real_time;  // ÿεĺʱ (ns)
+    double      cpu_time;   // ÿε CPU ʱ (ns)
+    double      items_per_second;
+    double      bytes_per_second;
+};
+
+struct Options
+{
+    std::string filter      = ".*";
+    std::string out;
+    std::string compare;
+    double      min_time    = 0.5;
+    int         repetitions = 3;
+    bool        list        = false;
+};
+
+std::vector<Benchmark>& GetBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+double GetRealTime()
+{
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+double GetCpuTime()
+{
+    return double(std::clock()) / CLOCKS_PER_SEC;
+}
+
+bool ParseOption(const char* arg, const char* name, std::string& value)
+{
+    size_t len = std::strlen(name);
+    if (std::strncmp(arg, name, len) != 0 || arg[len] != '=')
+        return false;
+    value = arg + len + 1;
+    return true;
+}
+
+}  // namespace
+
+State::State(int64_t iterations, int64_t arg)
+    : running_(false)
+    , started_(false)
+    , arg_(arg)
+    , iterations_(iterations)
+    , remaining_(iterations)
+    , items_(0)
+    , bytes_(0)
+    , real_time_(0)
+    , cpu_time_(0)
+    , real_start_(0)
+    , cpu_start_(0)
+{
+}
+
+bool State::KeepRunning()
+{
+    if (!started_)
+    {
+        started_ = true;
+        ResumeTiming();
+    }
+
+    if (remaining_ > 0 && error_.empty())
+    {
+        --remaining_;
+        return true;
+    }
+
+    PauseTiming();
+    return false;
+}
+
+void State::PauseTiming()
+{
+    if (running_)
+    {
+        real_time_ += GetRealTime() - real_start_;
+        cpu_time_ += GetCpuTime() - cpu_start_;
+        running_ = false;
+    }
+}
+
+void State::ResumeTiming()
+{
+    if (!running_)
+    {
+        real_start_ = GetRealTime();
+        cpu_start_  = GetCpuTime();
+        running_    = true;
+    }
+}
+
+void State::SkipWithError(const std::string& message)
+{
+    error_ = message;
+    PauseTiming();
+}
+
+void Register(const std::string& name, const Function& func, const std::vector<int64_t>& args)
+{
+    if (args.empty())
+    {
+        GetBenchmarks().push_back(Benchmark{ name, func, 0 });
+        return;
+    }
+
+    for (auto arg : args)
+    {
+        GetBenchmarks().push_back(Benchmark{ name + "/" + std::to_string(arg), func, arg });
+    }
+}
+
+class Runner
+{
+public:
+    explicit Runner(const Options& options)
+        : options_(options)
+    {
+    }
+
+    void Run(const Benchmark& benchmark)
+    {
+        // ӵֱеĺʱﵽ min_time
+        int64_t iterations = 1;
+        while (true)
+        {
+            State state = RunOnce(benchmark, iterations);
+            if (!state.error_.empty())
+            {
+                Report(benchmark, state, 0);
+                return;
+            }
+
+            if (state.real_time_ >= options_.min_time || iterations >= 1000000000)
+                break;
+
+            double  multiplier = options_.min_time * 1.4 / (std::max)(state.real_time_, 1e-9);
+            int64_t next       = int64_t(double(iterations) * (std::min)(multiplier, 100.0));
+            iterations         = (std::max)(next, iterations + 1);
+        }
+
+        for (int i = 0; i < options_.repetitions; ++i)
+        {
+            State state = RunOnce(benchmark, iterations);
+            Report(benchmark, state, i);
+            if (!state.error_.empty())
+                return;
+        }
+
+        if (options_.repetitions > 1)
+            ReportMedian(benchmark);
+    }
+
+    const std::vector<Result>& GetResults() const
+    {
+        return results_;
+    }
+
+private:
+    State RunOnce(const Benchmark& benchmark, int64_t iterations)
+    {
+        State state(iterations, benchmark.arg);
+        benchmark.func(state);
+        state.PauseTiming();
+        if (state.error_.empty() && state.remaining_ != 0)
+            state.SkipWithError("benchmark returned before KeepRunning() finished");
+        return state;
+    }
+
+    void Report(const Benchmark& benchmark, const State& state, int repetition)
+    {
+        Result result;
+        result.name             = benchmark.name;
+        result.run_name         = benchmark.name;
+        result.label            = state.label_;
+        result.error            = state.error_;
+        result.repetition       = repetition;
+        result.iterations       = state.iterations_;
+        result.real_time        = state.real_time_ * 1e9 / double(state.iterations_);
+        result.cpu_time         = state.cpu_time_ * 1e9 / double(state.iterations_);
+        result.items_per_second = state.real_time_ > 0 ? double(state.items_) / state.real_time_ : 0;
+        result.bytes_per_second = state.real_time_ > 0 ? double(state.bytes_) / state.real_time_ : 0;
+        Print(result);
+        results_.push_back(result);
+    }
+
+    void ReportMedian(const Benchmark& benchmark)
+    {
+        std::vector<Result> runs(results_.end() - options_.repetitions, results_.end());
+
+        auto median = [&](double Result::*field) {
+            std::vector<double> values;
+            for (const auto& r : runs)
+                values.push_back(r.*field);
+            std::sort(values.begin(), values.end());
+            size_t n = values.size();
+            return n % 2 ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+        };
+
+        Result result           = runs.front();
+        result.name             = benchmark.name + "_median";
+        result.repetition       = -1;
+        result.real_time        = median(&Result::real_time);
+        result.cpu_time         = median(&Result::cpu_time);
+        result.items_per_second = median(&Result::items_per_second);
+        result.bytes_per_second = median(&Result::bytes_per_second);
+        Print(result);
+        results_.push_back(result);
+    }
+
+    void Print(const Result& result)
+    {
+        if (!result.error.empty())
+        {
+            std::printf("%-48s ERROR: %s\n", result.name.c_str(), result.error.c_str());
+            return;
+        }
+
+        std::printf("%-48s %14.0f ns %14.0f ns %12lld", result.name.c_str(), result.real_time, result.cpu_time,
+                    (long long)result.iterations);
+        if (result.items_per_second > 0)
+            std::printf(" %12.4g items/s", result.items_per_second);
+        if (result.bytes_per_second > 0)
+            std::printf(" %12.4g B/s", result.bytes_per_second);
+        if (!result.label.empty())
+            std::printf(" %s", result.label.c_str());
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    const Options&      options_;
+    std::vector<Result> results_;
+};
+
+namespace
+{
+
+nlohmann::json MakeJson(const std::vector<Result>& results, const char* executable)
+{
+    char       date[64] = {};
+    std::time_t now      = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    // ʽ Google Benchmark һ£ֱʹ compare.py ԱȽ
+    nlohmann::json json;
+    json["context"]["date"]       = date;
+    json["context"]["executable"] = executable;
+    json["context"]["num_cpus"]   = std::thread::hardware_concurrency();
+#if defined(NDEBUG)
+    json["context"]["library_build_type"] = "release";
+#else
+    json["context"]["library_build_type"] = "debug";
+#endif
+
+    json["benchmarks"] = nlohmann::json::array();
+    for (const auto& result : results)
+    {
+        nlohmann::json item;
+        item["name"]     = result.name;
+        item["run_name"] = result.run_name;
+        if (result.repetition < 0)
+        {
+            item["run_type"]       = "aggregate";
+            item["aggregate_name"] = "median";
+        }
+        else
+        {
+            item["run_type"]         = "iteration";
+            item["repetition_index"] = result.repetition;
+        }
+        item["iterations"] = result.iterations;
+        item["real_time"]  = result.real_time;
+        item["cpu_time"]   = result.cpu_time;
+        item["time_unit"]  = "ns";
+        if (result.items_per_second > 0)
+            item["items_per_second"] = result.items_per_second;
+        if (result.bytes_per_second > 0)
+            item["bytes_per_second"] = result.bytes_per_second;
+        if (!result.label.empty())
+            item["label"] = result.label;
+        if (!result.error.empty())
+        {
+            item["error_occurred"] = true;
+            item["error_message"]  = result.error;
+        }
+        json["benchmarks"].push_back(item);
+    }
+    return json;
+}
+
+// ȡÿԵλûظʱȡΨһһν
+std::map<std::string, double> CollectTimes(const nlohmann::json& json)
+{
+    std::map<std::string, double> times;
+    for (const auto& item : json["benchmarks"])
+    {
+        if (item.value("error_occurred", false))
+            continue;
+
+        std::string run_name = item.value("run_name", item.value("name", std::string()));
+        if (item.value("run_type", std::string()) == "aggregate")
+        {
+            if (item.value("aggregate_name", std::string()) == "median")
+                times[run_name] = item["real_time"].get<double>();
+        }
+        else if (!times.count(run_name))
+        {
+            times[run_name] = item["real_time"].get<double>();
+        }
+    }
+    return times;
+}
+
+bool Compare(const std::string& baseline_file, const nlohmann::json& current)
+{
+    std::ifstream ifs(baseline_file);
+    if (!ifs)
+    {
+        std::fprintf(stderr, "Cannot open baseline file: %s\n", baseline_file.c_str());
+        return false;
+    }
+
+    nlohmann::json baseline;
+    try
+    {
+        ifs >> baseline;
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "Invalid baseline file %s: %s\n", baseline_file.c_str(), e.what());
+        return false;
+    }
+
+    auto old_times = CollectTimes(baseline);
+    auto new_times = CollectTimes(current);
+
+    std::printf("\n%-48s %14s %14s %9s\n", "Comparison", "Old (ns)", "New (ns)", "Change");
+    for (const auto& pair : new_times)
+    {
+        auto iter = old_times.find(pair.first);
+        if (iter == old_times.end() || iter->second <= 0)
+            continue;
+
+        double change = (pair.second - iter->second) / iter->second * 100.0;
+        std::printf("%-48s %14.0f %14.0f %+8.1f%%\n", pair.first.c_str(), iter->second, pair.second, change);
+    }
+    return true;
+}
+
+}  // namespace
+
+int Run(int argc, char** argv)
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string value;
+        if (ParseOption(argv[i], "--filter", value))
+            options.filter = value;
+        else if (ParseOption(argv[i], "--min-time", value))
+            options.min_time = std::atof(value.c_str());
+        else if (ParseOption(argv[i], "--repetitions", value))
+            options.repetitions = (std::max)(1, std::atoi(value.c_str()));
+        else if (ParseOption(argv[i], "--out", value))
+            options.out = value;
+        else if (ParseOption(argv[i], "--compare", value))
+            options.compare = value;
+        else if (std::strcmp(argv[i], "--list") == 0)
+            options.list = true;
+        else
+        {
+            std::fprintf(stderr,
+                         "Usage: %s [--filter=<regex>] [--min-time=<sec>] [--repetitions=<n>] [--out=<file>] "
+                         "[--compare=<file>] [--list]\n",
+                         argv[0]);
+            return 1;
+        }
+    }
+
+    std::regex filter;
+    try
+    {
+        filter = std::regex(options.filter);
+    }
+    catch (const std::regex_error&)
+    {
+        std::fprintf(stderr, "Invalid filter: %s\n", options.filter.c_str());
+        return 1;
+    }
+
+    Runner runner(options);
+    for (const auto& benchmark : GetBenchmarks())
+    {
+        if (!std::regex_search(benchmark.name, filter))
+            continue;
+
+        if (options.list)
+            std::printf("%s\n", benchmark.name.c_str());
+        else
+            runner.Run(benchmark);
+    }
+
+    if (options.list)
+        return 0;
+
+    nlohmann::json json = MakeJson(runner.GetResults(), argv[0]);
+    if (!options.out.empty())
+    {
+        std::ofstream ofs(options.out);
+        if (!ofs)
+        {
+            std::fprintf(stderr, "Cannot write results to %s\n", options.out.c_str());
+            return 1;
+        }
+        ofs << json.dump(2) << std::endl;
+    }
+
+    if (!options.compare.empty() && !Compare(options.compare, json))
+        return 1;
+
+    bool failed = std::any_of(runner.GetResults().begin(), runner.GetResults().end(),
+                              [](const Result& r) { return !r.error.empty(); });
+    return failed ? 1 : 0;
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,171 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace kiwano
+{
+namespace bench
+{
+
+/// \~chinese
+/// @brief ׼״̬
+/// @details Ժ KeepRunning  true ʱִһεѭ׼ʱ
+class State
+{
+public:
+    State(int64_t iterations, int64_t arg);
+
+    /// \~chinese
+    /// @brief Ƿһε
+    bool KeepRunning();
+
+    /// \~chinese
+    /// @brief ͣʱ
+    void PauseTiming();
+
+    /// \~chinese
+    /// @brief ָʱ
+    void ResumeTiming();
+
+    /// \~chinese
+    /// @brief ȡԲ
+    int64_t GetArg() const;
+
+    /// \~chinese
+    /// @brief ȡ
+    int64_t GetIterations() const;
+
+    /// \~chinese
+    /// @brief ôĿڼÿĿ
+    void SetItemsProcessed(int64_t items);
+
+    /// \~chinese
+    /// @brief ôֽڼÿֽ
+    void SetBytesProcessed(int64_t bytes);
+
+    /// \~chinese
+    /// @brief ø˵
+    void SetLabel(const std::string& label);
+
+    /// \~chinese
+    /// @brief Բ
+    void SkipWithError(const std::string& message);
+
+private:
+    friend class Runner;
+
+    bool    running_;
+    bool    started_;
+    int64_t arg_;
+    int64_t iterations_;
+    int64_t remaining_;
+    int64_t items_;
+    int64_t bytes_;
+    double  real_time_;
+    double  cpu_time_;
+    double  real_start_;
+    double  cpu_start_;
+
+    std::string label_;
+    std::string error_;
+};
+
+inline int64_t State::GetArg() const
+{
+    return arg_;
+}
+
+inline int64_t State::GetIterations() const
+{
+    return iterations_;
+}
+
+inline void State::SetItemsProcessed(int64_t items)
+{
+    items_ = items;
+}
+
+inline void State::SetBytesProcessed(int64_t bytes)
+{
+    bytes_ = bytes;
+}
+
+inline void State::SetLabel(const std::string& label)
+{
+    label_ = label;
+}
+
+/// \~chinese
+/// @brief ׼Ժ
+using Function = std::function<void(State&)>;
+
+/// \~chinese
+/// @brief ע׼
+/// @param name 
+/// @param func Ժ
+/// @param args ԲÿעΪһΪ name/arg Ĳ
+void Register(const std::string& name, const Function& func, const std::vector<int64_t>& args = {});
+
+/// \~chinese
+/// @brief ƥĻ׼
+/// @details ֵ֧в
+///   --filter=<regex>     ֻƥĲ
+///   --min-time=<sec>     ÿظ̺ʱĬ 0.5 
+///   --repetitions=<n>    ظĬ 3 Σλ
+///   --out=<file>          JSON ʽ
+///   --compare=<file>     ֮ǰ JSON Ա
+///   --list               ֻг
+int Run(int argc, char** argv);
+
+/// \~chinese
+/// @brief ֹŻ
+template <typename _Ty>
+inline void DoNotOptimize(const _Ty& value)
+{
+#if defined(_MSC_VER)
+    static const void* volatile sink;
+    sink = &value;
+#else
+    asm volatile("" : : "g"(&value) : "memory");
+#endif
+}
+
+struct Registrar
+{
+    Registrar(const char* name, const Function& func, const std::vector<int64_t>& args = {})
+    {
+        Register(name, func, args);
+    }
+};
+
+}  // namespace bench
+}  // namespace kiwano
+
+/// \~chinese
+/// @brief 岢ע׼ԣѡΪԲб
+#define KGE_BENCHMARK(NAME, ...)                                                                        \
+    static void                       NAME(::kiwano::bench::State&);                                    \
+    static ::kiwano::bench::Registrar NAME##_registrar(#NAME, NAME, std::vector<int64_t>{__VA_ARGS__}); \
+    static void                       NAME(::kiwano::bench::State& state)
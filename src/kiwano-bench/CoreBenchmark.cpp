@@ -0,0 +1,261 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano/2d/Actor.h>
+#include <kiwano/2d/ParticleSystem.h>
+#include <kiwano/2d/animation/TweenAnimation.h>
+#include <kiwano/core/Serializable.h>
+#include <kiwano/event/MouseEvent.h>
+#include <kiwano/utils/TaskScheduler.h>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+const Duration kFrameTime = Duration(16);
+
+// Actor::Update ܱģͨ Director 
+class RootActor : public Actor
+{
+public:
+    using Actor::Update;
+};
+
+// һÿڵ 10 ӽڵĽɫҶӽڵ
+RefPtr<RootActor> CreateActorTree(int count, Vector<Actor*>* leaves)
+{
+    RefPtr<RootActor>     root = MakePtr<RootActor>();
+    Vector<RefPtr<Actor>> level{ root };
+    int                   created = 1;
+
+    while (created < count)
+    {
+        Vector<RefPtr<Actor>> next;
+        for (auto& parent : level)
+        {
+            for (int i = 0; i < 10 && created < count; ++i, ++created)
+            {
+                RefPtr<Actor> child = MakePtr<Actor>();
+                child->SetPosition(float(i), 1.0f);
+                child->SetRotation(float(i));
+                parent->AddChild(child);
+                next.push_back(child);
+            }
+        }
+        level = std::move(next);
+    }
+
+    if (leaves)
+    {
+        for (auto& actor : level)
+            leaves->push_back(actor.Get());
+    }
+    return root;
+}
+
+}  // namespace
+
+KGE_BENCHMARK(Actor_TreeUpdate, 1000, 10000)
+{
+    RefPtr<RootActor> root = CreateActorTree(int(state.GetArg()), nullptr);
+
+    while (state.KeepRunning())
+    {
+        root->Update(kFrameTime);
+    }
+    state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+}
+
+KGE_BENCHMARK(Actor_TransformPropagation, 1000, 10000)
+{
+    Vector<Actor*>    leaves;
+    RefPtr<RootActor> root = CreateActorTree(int(state.GetArg()), &leaves);
+
+    float x = 0;
+    while (state.KeepRunning())
+    {
+        // ƶڵҶӽڵı任Ҫ¼
+        root->SetPosition(x, 0.0f);
+        x += 1.0f;
+
+        for (auto leaf : leaves)
+            DoNotOptimize(leaf->GetTransformMatrix());
+    }
+    state.SetItemsProcessed(state.GetIterations() * int64_t(leaves.size()));
+}
+
+KGE_BENCHMARK(EventDispatcher_DispatchEvent, 10, 100)
+{
+    EventDispatcher dispatcher;
+
+    int handled = 0;
+    for (int64_t i = 0; i < state.GetArg(); ++i)
+    {
+        dispatcher.AddListener<MouseMoveEvent>([&](Event*) { ++handled; });
+        dispatcher.AddListener<MouseDownEvent>([&](Event*) { ++handled; });
+    }
+
+    RefPtr<MouseMoveEvent> evt = MakePtr<MouseMoveEvent>();
+    while (state.KeepRunning())
+    {
+        dispatcher.DispatchEvent(evt.Get());
+    }
+    DoNotOptimize(handled);
+    state.SetItemsProcessed(state.GetIterations());
+}
+
+KGE_BENCHMARK(TaskScheduler_Update, 100, 1000)
+{
+    TaskScheduler scheduler;
+
+    int executed = 0;
+    for (int64_t i = 0; i < state.GetArg(); ++i)
+    {
+        scheduler.AddTask([&](Task*, Duration) { ++executed; }, kFrameTime);
+    }
+
+    while (state.KeepRunning())
+    {
+        scheduler.Update(kFrameTime);
+    }
+    DoNotOptimize(executed);
+    state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+}
+
+KGE_BENCHMARK(Animator_TweenUpdate, 100, 1000)
+{
+    RefPtr<RootActor> root = MakePtr<RootActor>();
+    for (int64_t i = 0; i < state.GetArg(); ++i)
+    {
+        RefPtr<Actor> child = MakePtr<Actor>();
+
+        // 㹻Ķ֤Թв
+        child->StartAnimation(MakePtr<MoveByAnimation>(Duration(1000000000), Vec2(100.0f, 0.0f)));
+        child->StartAnimation(MakePtr<ScaleByAnimation>(Duration(1000000000), Vec2(2.0f, 2.0f)));
+        root->AddChild(child);
+    }
+
+    while (state.KeepRunning())
+    {
+        root->Update(kFrameTime);
+    }
+    state.SetItemsProcessed(state.GetIterations() * state.GetArg() * 2);
+}
+
+KGE_BENCHMARK(ParticleSystem_Simulate, 10000, 100000)
+{
+    // 㹻Թֲ
+    ParticleEmitterConfig config;
+    config.max_particles = uint32_t(state.GetArg());
+    config.emission_rate = 0.0f;
+    config.life          = 1000000.0f;
+    config.angle_var     = 180.0f;
+    config.speed_var     = 50.0f;
+    config.gravity       = Vec2(0.0f, 98.0f);
+    config.end_scale     = 2.0f;
+    config.end_rotation  = 360.0f;
+
+    RefPtr<ParticleSystem> system = MakePtr<ParticleSystem>(nullptr, config);
+    system->Emit(config.max_particles);
+
+    while (state.KeepRunning())
+    {
+        system->Simulate(kFrameTime.GetSeconds());
+    }
+    DoNotOptimize(system->GetParticleCount());
+    state.SetItemsProcessed(state.GetIterations() * int64_t(system->GetParticleCount()));
+}
+
+KGE_BENCHMARK(ParticleSystem_SteadyState, 100000)
+{
+    // ÿ뷢԰ƳӵĿ
+    ParticleEmitterConfig config;
+    config.max_particles = uint32_t(state.GetArg());
+    config.life          = 1.0f;
+    config.emission_rate = float(state.GetArg());
+    config.angle_var     = 180.0f;
+    config.speed_var     = 50.0f;
+
+    RefPtr<ParticleSystem> system = MakePtr<ParticleSystem>(nullptr, config);
+    system->Start();
+    for (int i = 0; i < 60; ++i)
+        system->Simulate(kFrameTime.GetSeconds());
+
+    while (state.KeepRunning())
+    {
+        system->Simulate(kFrameTime.GetSeconds());
+    }
+    state.SetItemsProcessed(state.GetIterations() * int64_t(system->GetParticleCount()));
+}
+
+KGE_BENCHMARK(ByteSerializer_Write, 1000)
+{
+    Vector<uint8_t> bytes;
+    while (state.KeepRunning())
+    {
+        bytes.clear();
+
+        ByteSerializer serializer(bytes);
+        for (int64_t i = 0; i < state.GetArg(); ++i)
+        {
+            serializer << int32_t(i) << float(i) << Vec2(float(i), float(i));
+        }
+        serializer << "kiwano";
+    }
+    state.SetBytesProcessed(state.GetIterations() * int64_t(bytes.size()));
+}
+
+KGE_BENCHMARK(ByteSerializer_Read, 1000)
+{
+    Vector<uint8_t> bytes;
+    {
+        ByteSerializer serializer(bytes);
+        for (int64_t i = 0; i < state.GetArg(); ++i)
+        {
+            serializer << int32_t(i) << float(i) << Vec2(float(i), float(i));
+        }
+        serializer << "kiwano";
+    }
+
+    while (state.KeepRunning())
+    {
+        ByteDeserializer deserializer(bytes);
+
+        int32_t i32 = 0;
+        float   f   = 0;
+        Vec2    vec;
+        String  str;
+        for (int64_t i = 0; i < state.GetArg(); ++i)
+        {
+            deserializer >> i32 >> f >> vec;
+        }
+        deserializer >> str;
+        DoNotOptimize(vec);
+    }
+    state.SetBytesProcessed(state.GetIterations() * int64_t(bytes.size()));
+}
+
+}  // namespace bench
+}  // namespace kiwano
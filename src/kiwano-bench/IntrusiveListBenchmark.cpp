@@ -0,0 +1,71 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano/core/IntrusiveList.hpp>
+#include <vector>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+struct ListNode : public IntrusiveListValue<ListNode*>
+{
+    int value = 0;
+};
+
+}  // namespace
+
+KGE_BENCHMARK(IntrusiveList_Operations, 1000)
+{
+    std::vector<ListNode>    nodes(size_t(state.GetArg()));
+    std::vector<ListNode*>   pointers;
+    IntrusiveList<ListNode*> list;
+
+    for (auto& node : nodes)
+        pointers.push_back(&node);
+
+    while (state.KeepRunning())
+    {
+        for (auto& node : pointers)
+            list.PushBack(node);
+
+        // Ƴһڵٲ뵽ͷ
+        for (size_t i = 0; i < pointers.size(); i += 2)
+            list.Remove(pointers[i]);
+        for (size_t i = 0; i < pointers.size(); i += 2)
+            list.PushFront(pointers[i]);
+
+        int sum = 0;
+        for (auto node : list)
+            sum += node->value;
+        DoNotOptimize(sum);
+
+        list.Clear();
+    }
+    state.SetItemsProcessed(state.GetIterations() * state.GetArg());
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,180 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano/utils/Logger.h>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+const char* kLogFile = "kiwano-bench.log";
+
+// ־ֻͳдֽ
+class NullLogProvider : public LogProvider
+{
+public:
+    size_t bytes = 0;
+
+protected:
+    void WriteMessage(LogLevel level, const char* msg) override
+    {
+        bytes += ::strlen(msg);
+        DoNotOptimize(bytes);
+    }
+};
+
+// ڼø־滻ԭе־
+class LoggerScope
+{
+public:
+    LoggerScope(RefPtr<LogProvider> provider, bool async, size_t capacity = 4096)
+        : provider_(provider)
+        , saved_(Logger::GetInstance().GetProviders())
+    {
+        Logger& logger = Logger::GetInstance();
+        for (auto& p : saved_)
+            logger.RemoveProvider(p);
+        logger.AddProvider(provider_);
+
+        if (async)
+            logger.EnableAsync(capacity);
+    }
+
+    ~LoggerScope()
+    {
+        Logger& logger = Logger::GetInstance();
+        logger.DisableAsync();
+        logger.RemoveProvider(provider_);
+        for (auto& p : saved_)
+            logger.AddProvider(p);
+        provider_ = nullptr;
+
+        std::remove(kLogFile);
+    }
+
+private:
+    RefPtr<LogProvider>         provider_;
+    Vector<RefPtr<LogProvider>> saved_;
+};
+
+void SetDroppedLabel(State& state, uint64_t dropped_before)
+{
+    const uint64_t dropped = Logger::GetInstance().GetDroppedCount() - dropped_before;
+    state.SetLabel("dropped=" + std::to_string(dropped));
+}
+
+}  // namespace
+
+KGE_BENCHMARK(Logger_SyncNull)
+{
+    LoggerScope scope(MakePtr<NullLogProvider>(), false);
+
+    int64_t i = 0;
+    while (state.KeepRunning())
+    {
+        KGE_LOGF("Frame %lld: %d actors, %.2f ms", i++, 128, 16.6);
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+
+KGE_BENCHMARK(Logger_SyncFile)
+{
+    LoggerScope scope(MakePtr<FileLogProvider>(kLogFile), false);
+
+    int64_t i = 0;
+    while (state.KeepRunning())
+    {
+        KGE_LOGF("Frame %lld: %d actors, %.2f ms", i++, 128, 16.6);
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+
+// Ϊд־ᱻ¼˵
+KGE_BENCHMARK(Logger_AsyncFile, 1024, 65536)
+{
+    LoggerScope    scope(MakePtr<FileLogProvider>(kLogFile), true, size_t(state.GetArg()));
+    const uint64_t dropped = Logger::GetInstance().GetDroppedCount();
+
+    int64_t i = 0;
+    while (state.KeepRunning())
+    {
+        KGE_LOGF("Frame %lld: %d actors, %.2f ms", i++, 128, 16.6);
+    }
+    state.SetItemsProcessed(state.GetIterations());
+    SetDroppedLabel(state, dropped);
+}
+
+KGE_BENCHMARK(Logger_AsyncStream)
+{
+    LoggerScope    scope(MakePtr<FileLogProvider>(kLogFile), true);
+    const uint64_t dropped = Logger::GetInstance().GetDroppedCount();
+
+    int64_t i = 0;
+    while (state.KeepRunning())
+    {
+        KGE_LOG("Frame", i++, "actors", 128, "time", 16.6f);
+    }
+    state.SetItemsProcessed(state.GetIterations());
+    SetDroppedLabel(state, dropped);
+}
+
+// Ϊͬʱӡ־̣߳߳
+KGE_BENCHMARK(Logger_AsyncContended, 2, 4)
+{
+    LoggerScope    scope(MakePtr<NullLogProvider>(), true, 65536);
+    const uint64_t dropped = Logger::GetInstance().GetDroppedCount();
+
+    std::atomic<bool>        stop(false);
+    std::vector<std::thread> producers;
+    for (int64_t t = 1; t < state.GetArg(); ++t)
+    {
+        producers.emplace_back([&stop]() {
+            int64_t i = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                KGE_LOGF("Worker %lld", i++);
+            }
+        });
+    }
+
+    int64_t i = 0;
+    while (state.KeepRunning())
+    {
+        KGE_LOGF("Frame %lld: %d actors, %.2f ms", i++, 128, 16.6);
+    }
+
+    stop = true;
+    for (auto& producer : producers)
+        producer.join();
+
+    state.SetItemsProcessed(state.GetIterations());
+    SetDroppedLabel(state, dropped);
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,111 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano-bench/MixerReference.h>
+#include <kiwano-audio/Mixer.h>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+RefPtr<audio::MixerVoice> CreateVoice(audio::Mixer& mixer, VoiceDesc& desc)
+{
+    audio::AudioMeta meta;
+    meta.format          = audio::AudioFormat::IEEEFloat;
+    meta.channels        = desc.channels;
+    meta.samples_per_sec = desc.sample_rate;
+    meta.bits_per_sample = 32;
+    meta.block_align     = uint16_t(desc.channels * sizeof(float));
+
+    BinaryData data(desc.samples.data(), uint32_t(desc.samples.size() * sizeof(float)));
+    auto       voice = mixer.CreateVoice(MakePtr<audio::AudioData>(data, meta));
+    if (voice)
+    {
+        voice->SetVolume(desc.volume);
+        voice->SetPan(desc.pan);
+        voice->SetPitch(desc.pitch);
+    }
+    return voice;
+}
+
+}  // namespace
+
+// ΪͬʱŵԴÿεһ 512 ֡飬ÿ봦ĿΪԴ֡
+KGE_BENCHMARK(Mixer_Mix, 8, 32, 128)
+{
+    const int      voice_count = int(state.GetArg());
+    const uint32_t frames      = kMixerOutputRate;
+
+    Vector<VoiceDesc> descs;
+    for (int i = 0; i < voice_count; ++i)
+        descs.push_back(CreateVoiceDesc(i, frames));
+
+    // οȽϣԴ㹻ȽϷΧڲᷢѭ
+    {
+        audio::Mixer mixer(kMixerOutputRate);
+        mixer.SetMasterVolume(0.8f);
+        for (auto& desc : descs)
+        {
+            auto voice = CreateVoice(mixer, desc);
+            if (!voice)
+            {
+                state.SkipWithError("Failed to create mixer voice");
+                return;
+            }
+            voice->Play();
+        }
+
+        const uint32_t check_frames = kMixerBlockFrames * 8;
+        Vector<float>  mixed(check_frames * 2);
+        for (uint32_t offset = 0; offset < check_frames; offset += kMixerBlockFrames)
+            mixer.Mix(mixed.data() + offset * 2, kMixerBlockFrames);
+
+        Vector<double> reference;
+        ReferenceMix(descs, mixer.GetMasterVolume(), check_frames, reference);
+
+        const double max_error = MaxMixError(mixed.data(), reference);
+        if (max_error > 1e-4)
+        {
+            state.SkipWithError("Mixed output differs from the reference by " + std::to_string(max_error));
+            return;
+        }
+    }
+
+    audio::Mixer mixer(kMixerOutputRate);
+    for (auto& desc : descs)
+        CreateVoice(mixer, desc)->Play(-1);
+
+    Vector<float> output(kMixerBlockFrames * 2);
+    while (state.KeepRunning())
+    {
+        mixer.Mix(output.data(), kMixerBlockFrames);
+        DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.GetIterations() * voice_count * kMixerBlockFrames);
+    state.SetLabel("voices=" + std::to_string(voice_count) + " block=" + std::to_string(kMixerBlockFrames));
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,118 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano-bench/MixerReference.h>
+#include <kiwano-audio/MixerKernel.h>
+#include <string>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+//  MixerVoice::Mix ķʽֱʹûϣҪƵ
+struct KernelVoice
+{
+    const VoiceDesc* desc;
+    double           position;
+};
+
+void KernelMix(std::vector<KernelVoice>& voices, float master_volume, float* output, uint32_t frames, bool loop)
+{
+    std::fill(output, output + frames * 2, 0.f);
+
+    for (auto& voice : voices)
+    {
+        const VoiceDesc& desc       = *voice.desc;
+        const uint32_t   src_frames = uint32_t(desc.samples.size() / desc.channels);
+        const double     step       = double(desc.pitch) * desc.sample_rate / kMixerOutputRate;
+
+        float gain_l, gain_r;
+        audio::kernel::PanGains(desc.volume * master_volume, desc.pan, gain_l, gain_r);
+
+        uint32_t mixed = 0;
+        while (mixed < frames && voice.position < src_frames)
+        {
+            mixed += audio::kernel::MixFrames(output + mixed * 2, desc.samples.data(), src_frames, desc.channels,
+                                              voice.position, step, frames - mixed, gain_l, gain_r);
+
+            if (loop && voice.position >= src_frames)
+                voice.position -= src_frames;
+        }
+    }
+
+    audio::kernel::ClampOutput(output, frames * 2);
+}
+
+}  // namespace
+
+//  Mixer_Mix ͬԴãֱӲԻزûƵ豸ƽ̨
+KGE_BENCHMARK(MixerKernel_Mix, 8, 32, 128)
+{
+    const int      voice_count = int(state.GetArg());
+    const uint32_t frames      = kMixerOutputRate;
+
+    std::vector<VoiceDesc> descs;
+    for (int i = 0; i < voice_count; ++i)
+        descs.push_back(CreateVoiceDesc(i, frames));
+
+    std::vector<KernelVoice> voices;
+    for (const auto& desc : descs)
+        voices.push_back(KernelVoice{ &desc, 0.0 });
+
+    // οȽϣԴ㹻ȽϷΧڲᷢѭ
+    {
+        const float    master_volume = 0.8f;
+        const uint32_t check_frames  = kMixerBlockFrames * 8;
+
+        std::vector<float> mixed(check_frames * 2);
+        for (uint32_t offset = 0; offset < check_frames; offset += kMixerBlockFrames)
+            KernelMix(voices, master_volume, mixed.data() + offset * 2, kMixerBlockFrames, false);
+
+        std::vector<double> reference;
+        ReferenceMix(descs, master_volume, check_frames, reference);
+
+        const double max_error = MaxMixError(mixed.data(), reference);
+        if (max_error > 1e-4)
+        {
+            state.SkipWithError("Mixed output differs from the reference by " + std::to_string(max_error));
+            return;
+        }
+    }
+
+    for (auto& voice : voices)
+        voice.position = 0.0;
+
+    std::vector<float> output(kMixerBlockFrames * 2);
+    while (state.KeepRunning())
+    {
+        KernelMix(voices, 1.f, output.data(), kMixerBlockFrames, true);
+        DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.GetIterations() * voice_count * kMixerBlockFrames);
+    state.SetLabel("voices=" + std::to_string(voice_count) + " block=" + std::to_string(kMixerBlockFrames));
+}
+
+}  // namespace bench
+}  // namespace kiwano
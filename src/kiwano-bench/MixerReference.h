@@ -0,0 +1,115 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/math/Constants.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace kiwano
+{
+namespace bench
+{
+
+// ׼ԹõĲԴͲο
+
+const uint32_t kMixerOutputRate  = 44100;
+const uint32_t kMixerBlockFrames = 512;
+
+// Դǵز
+struct VoiceDesc
+{
+    uint16_t channels;
+    uint32_t sample_rate;
+    float    volume;
+    float    pan;
+    float    pitch;
+
+    std::vector<float> samples;
+};
+
+inline VoiceDesc CreateVoiceDesc(int index, uint32_t frames)
+{
+    VoiceDesc desc;
+    desc.channels    = (index % 2) ? 2 : 1;
+    desc.sample_rate = (index % 3 == 0) ? 22050 : kMixerOutputRate;
+    desc.volume      = 0.5f + 0.1f * float(index % 5);
+    desc.pan         = float(index % 5 - 2) * 0.5f;
+    desc.pitch       = (index % 4 == 3) ? 1.5f : 1.0f;
+
+    const double frequency = 220.0 + 7.0 * index;
+    desc.samples.resize(size_t(frames) * desc.channels);
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        const double t = double(i) / desc.sample_rate;
+        for (uint16_t c = 0; c < desc.channels; ++c)
+        {
+            desc.samples[i * desc.channels + c] = 0.25f * float(std::sin(2.0 * math::PI_D * frequency * t + c));
+        }
+    }
+    return desc;
+}
+
+// ֡ĲοʹͬԲֵ
+inline void ReferenceMix(const std::vector<VoiceDesc>& descs, float master_volume, uint32_t frames, std::vector<double>& output)
+{
+    output.assign(size_t(frames) * 2, 0.0);
+    for (const auto& desc : descs)
+    {
+        const uint32_t last   = uint32_t(desc.samples.size() / desc.channels) - 1;
+        const double   gain   = double(desc.volume) * master_volume;
+        const double   gain_l = gain * (desc.pan > 0.f ? 1.0 - desc.pan : 1.0);
+        const double   gain_r = gain * (desc.pan < 0.f ? 1.0 + desc.pan : 1.0);
+        const double   step   = double(desc.pitch) * desc.sample_rate / kMixerOutputRate;
+
+        for (uint32_t i = 0; i < frames; ++i)
+        {
+            const double   pos   = step * i;
+            const uint32_t index = std::min(uint32_t(pos), last);
+            const uint32_t next  = std::min(index + 1, last);
+            const double   t     = pos - index;
+
+            for (uint32_t c = 0; c < 2; ++c)
+            {
+                const uint32_t channel = (desc.channels == 2) ? c : 0;
+                const double   a       = desc.samples[index * desc.channels + channel];
+                const double   b       = desc.samples[next * desc.channels + channel];
+                output[i * 2 + c] += (a + (b - a) * t) * (c == 0 ? gain_l : gain_r);
+            }
+        }
+    }
+
+    for (auto& sample : output)
+        sample = std::min(std::max(sample, -1.0), 1.0);
+}
+
+// ػο
+inline double MaxMixError(const float* mixed, const std::vector<double>& reference)
+{
+    double max_error = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i)
+        max_error = std::max(max_error, std::abs(double(mixed[i]) - reference[i]));
+    return max_error;
+}
+
+}  // namespace bench
+}  // namespace kiwano
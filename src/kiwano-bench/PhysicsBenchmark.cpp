@@ -0,0 +1,555 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <Box2D/Box2D.h>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+const float32 kTimeStep           = 1.0f / 60.0f;
+const int32   kVelocityIterations = 8;
+const int32   kPositionIterations = 3;
+const int     kStepsPerIteration  = 60;
+
+// ÿεµ粢Ԥ warmup ֻ 60 ĺʱ
+// ߱ã֤ÿһĹȶ
+template <typename _BuildFunc>
+void RunScene(State& state, _BuildFunc build, int warmup)
+{
+    int64_t steps = 0;
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        {
+            b2World world(b2Vec2(0.0f, -10.0f));
+            world.SetAllowSleeping(false);
+            build(world);
+
+            for (int i = 0; i < warmup; ++i)
+                world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+
+            state.ResumeTiming();
+            for (int i = 0; i < kStepsPerIteration; ++i)
+                world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+        steps += kStepsPerIteration;
+    }
+    state.SetItemsProcessed(steps);
+}
+
+void CreateGround(b2World& world, float32 half_width)
+{
+    b2BodyDef def;
+    b2Body*   ground = world.CreateBody(&def);
+
+    b2EdgeShape floor;
+    floor.Set(b2Vec2(-half_width, 0.0f), b2Vec2(half_width, 0.0f));
+    ground->CreateFixture(&floor, 0.0f);
+
+    b2EdgeShape wall;
+    wall.Set(b2Vec2(-half_width, 0.0f), b2Vec2(-half_width, 4.0f * half_width));
+    ground->CreateFixture(&wall, 0.0f);
+    wall.Set(b2Vec2(half_width, 0.0f), b2Vec2(half_width, 4.0f * half_width));
+    ground->CreateFixture(&wall, 0.0f);
+}
+
+void CreatePyramid(b2World& world, int rows, float32 offset_x = 0.0f)
+{
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.5f);
+
+    b2Vec2 x(offset_x - 0.5625f * rows, 0.75f);
+    b2Vec2 delta_x(0.5625f, 1.25f);
+    b2Vec2 delta_y(1.125f, 0.0f);
+
+    for (int i = 0; i < rows; ++i)
+    {
+        b2Vec2 y = x;
+        for (int j = i; j < rows; ++j)
+        {
+            b2BodyDef def;
+            def.type     = b2_dynamicBody;
+            def.position = y;
+            world.CreateBody(&def)->CreateFixture(&box, 5.0f);
+            y += delta_y;
+        }
+        x += delta_x;
+    }
+}
+
+void CreateRandomBodies(b2World& world, int count, float32 half_width)
+{
+    std::mt19937                           rng(1);
+    std::uniform_real_distribution<float32> size(0.2f, 0.6f);
+    std::uniform_real_distribution<float32> pos_x(-half_width + 1.0f, half_width - 1.0f);
+
+    b2PolygonShape box;
+    b2CircleShape  circle;
+    for (int i = 0; i < count; ++i)
+    {
+        b2BodyDef def;
+        def.type = b2_dynamicBody;
+        def.position.Set(pos_x(rng), 1.0f + 1.5f * float32(i) / half_width);
+        b2Body* body = world.CreateBody(&def);
+
+        if (i % 2)
+        {
+            box.SetAsBox(size(rng), size(rng));
+            body->CreateFixture(&box, 1.0f);
+        }
+        else
+        {
+            circle.m_radius = size(rng);
+            body->CreateFixture(&circle, 1.0f);
+        }
+    }
+}
+
+//  x еķѣÿ 100  30 
+std::vector<b2Body*> CreatePiles(b2World& world, int piles)
+{
+    b2BodyDef      ground_def;
+    b2Body*        ground = world.CreateBody(&ground_def);
+    b2PolygonShape ground_box;
+    ground_box.SetAsBox(15.0f * piles + 15.0f, 1.0f, b2Vec2(15.0f * piles, -1.0f), 0.0f);
+    ground->CreateFixture(&ground_box, 0.0f);
+
+    b2PolygonShape box;
+    box.SetAsBox(0.5f, 0.5f);
+
+    std::vector<b2Body*> bodies;
+    for (int p = 0; p < piles; ++p)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            b2BodyDef def;
+            def.type = b2_dynamicBody;
+            def.position.Set(30.0f * p + 1.1f * (i % 10), 0.5f + 1.1f * (i / 10));
+            b2Body* body = world.CreateBody(&def);
+            body->CreateFixture(&box, 1.0f);
+            bodies.push_back(body);
+        }
+    }
+    return bodies;
+}
+
+std::vector<b2PolygonShape> CreateScatteredBoxes(int count)
+{
+    std::mt19937                           rng(7);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+    std::uniform_real_distribution<float32> size(0.5f, 1.5f);
+
+    std::vector<b2PolygonShape> shapes(count);
+    for (auto& shape : shapes)
+        shape.SetAsBox(size(rng), 0.5f, b2Vec2(pos_x(rng), pos_y(rng)), 0.0f);
+    return shapes;
+}
+
+// Ϊһ̬ļо߼
+void AddScatteredBoxes(b2World& world, const std::vector<b2PolygonShape>& shapes, bool bulk)
+{
+    b2BodyDef def;
+    b2Body*   body = world.CreateBody(&def);
+    if (bulk)
+    {
+        std::vector<b2FixtureDef> defs(shapes.size());
+        for (size_t i = 0; i < shapes.size(); ++i)
+            defs[i].shape = &shapes[i];
+        body->CreateFixtures(defs.data(), int32(defs.size()));
+    }
+    else
+    {
+        for (auto& shape : shapes)
+            body->CreateFixture(&shape, 0.0f);
+    }
+}
+
+std::string TreeQualityLabel(const b2World& world)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "tree quality %.1f", world.GetTreeQuality());
+    return buffer;
+}
+
+struct QueryCounter : public b2QueryCallback
+{
+    int32 count = 0;
+
+    bool ReportFixture(b2Fixture*) override
+    {
+        ++count;
+        return true;
+    }
+};
+
+struct ClosestRayCast : public b2RayCastCallback
+{
+    float32 fraction = 1.0f;
+
+    float32 ReportFixture(b2Fixture*, const b2Vec2&, const b2Vec2&, float32 f) override
+    {
+        fraction = f;
+        return f;
+    }
+};
+
+// ¼λúͽǶȣλȽ
+std::vector<float32> CaptureBodyStates(const b2World& world)
+{
+    std::vector<float32> states;
+    states.reserve(size_t(world.GetBodyCount()) * 3);
+    for (const b2Body* b = world.GetBodyList(); b; b = b->GetNext())
+    {
+        states.push_back(b->GetPosition().x);
+        states.push_back(b->GetPosition().y);
+        states.push_back(b->GetAngle());
+    }
+    return states;
+}
+
+// պģ steps ָģͬεĽӦλͬʱָ״̬
+bool CheckSnapshotDeterminism(b2World& world, b2WorldSnapshot& snapshot, int steps)
+{
+    snapshot.Save(&world);
+    for (int i = 0; i < steps; ++i)
+        world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+    const std::vector<float32> expected = CaptureBodyStates(world);
+
+    if (!snapshot.Restore(&world))
+        return false;
+    for (int i = 0; i < steps; ++i)
+        world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+    const std::vector<float32> actual = CaptureBodyStates(world);
+
+    if (!snapshot.Restore(&world))
+        return false;
+    return expected.size() == actual.size()
+           && std::memcmp(expected.data(), actual.data(), expected.size() * sizeof(float32)) == 0;
+}
+
+// ֱͬñͿģ steps ߵ״̬
+template <typename _BuildFunc>
+void SimulateBothSolvers(_BuildFunc build, int steps, std::vector<float32>& scalar, std::vector<float32>& wide)
+{
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        b2World world(b2Vec2(0.0f, -10.0f));
+        world.SetAllowSleeping(false);
+        world.SetWideContactSolver(pass == 1);
+        build(world);
+
+        for (int i = 0; i < steps; ++i)
+            world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+        (pass == 1 ? wide : scalar) = CaptureBodyStates(world);
+    }
+}
+
+// ĵӴֻͬ˳ͬ
+// ĽӴ˳޹أλͬ
+// еĽӴ໥ϣ˹-¶˳ͬʹƫ
+// 20  600 ߶ 1 ףײԵķƫԼ 0.1 ף
+// ֻ߶ȣݲΪ 2 
+bool CheckWideSolver(std::string& error)
+{
+    std::vector<float32> scalar, wide;
+    SimulateBothSolvers(
+        [](b2World& world) {
+            CreateGround(world, 40.0f);
+
+            b2PolygonShape box;
+            box.SetAsBox(0.5f, 0.5f);
+            for (int i = 0; i < 30; ++i)
+            {
+                b2BodyDef def;
+                def.type = b2_dynamicBody;
+                def.position.Set(-35.0f + 2.2f * float32(i), 0.6f + 0.01f * float32(i));
+                def.angle = 0.1f * float32(i % 5);
+                world.CreateBody(&def)->CreateFixture(&box, 5.0f);
+            }
+        },
+        kStepsPerIteration, scalar, wide);
+
+    if (scalar.size() != wide.size() || std::memcmp(scalar.data(), wide.data(), scalar.size() * sizeof(float32)) != 0)
+    {
+        error = "wide solver does not match the scalar solver on independent contacts";
+        return false;
+    }
+
+    SimulateBothSolvers(
+        [](b2World& world) {
+            CreateGround(world, 40.0f);
+            CreatePyramid(world, 20);
+        },
+        600, scalar, wide);
+
+    const float32 tolerance = 0.02f;
+
+    float32 max_y_scalar = -b2_maxFloat, max_y_wide = -b2_maxFloat, max_dy = 0.0f;
+    for (size_t i = 1; i < scalar.size(); i += 3)
+    {
+        max_y_scalar = b2Max(max_y_scalar, scalar[i]);
+        max_y_wide   = b2Max(max_y_wide, wide[i]);
+        max_dy       = b2Max(max_dy, b2Abs(scalar[i] - wide[i]));
+    }
+
+    if (max_dy > tolerance || b2Abs(max_y_scalar - max_y_wide) > tolerance)
+    {
+        char buffer[128];
+        std::snprintf(buffer, sizeof(buffer), "wide solver drifted: max y %.4f vs %.4f, max dy %.4f", max_y_scalar,
+                      max_y_wide, max_dy);
+        error = buffer;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+KGE_BENCHMARK(Box2D_Pyramid, 20, 40)
+{
+    int rows = int(state.GetArg());
+    RunScene(
+        state,
+        [=](b2World& world) {
+            CreateGround(world, 40.0f);
+            CreatePyramid(world, rows);
+        },
+        0);
+}
+
+KGE_BENCHMARK(Box2D_PyramidWideSolver, 20, 40)
+{
+    std::string error;
+    if (!CheckWideSolver(error))
+    {
+        state.SkipWithError(error);
+        return;
+    }
+
+    int rows = int(state.GetArg());
+    RunScene(
+        state,
+        [=](b2World& world) {
+            world.SetWideContactSolver(true);
+            CreateGround(world, 40.0f);
+            CreatePyramid(world, rows);
+        },
+        0);
+}
+
+KGE_BENCHMARK(Box2D_ManyBodies, 1000, 4000)
+{
+    int count = int(state.GetArg());
+    RunScene(
+        state,
+        [=](b2World& world) {
+            CreateGround(world, 50.0f);
+            CreateRandomBodies(world, count, 50.0f);
+        },
+        120);
+}
+
+KGE_BENCHMARK(Box2D_Piles, 20)
+{
+    int piles = int(state.GetArg());
+    RunScene(
+        state, [=](b2World& world) { CreatePiles(world, piles); }, 60);
+}
+
+//  Box2D_Piles ͬĳԭ㣺100 ȫģ⣬400 ÿ 4 ģһΣԶ
+KGE_BENCHMARK(Box2D_PilesRegionLOD, 20)
+{
+    int piles = int(state.GetArg());
+    RunScene(
+        state,
+        [=](b2World& world) {
+            for (b2Body* body : CreatePiles(world, piles))
+            {
+                float32 distance = b2Abs(body->GetPosition().x);
+                body->SetStepInterval(distance < 100.0f ? 1 : (distance < 400.0f ? 4 : 0));
+            }
+        },
+        60);
+}
+
+KGE_BENCHMARK(Box2D_CreateFixtures, 20000)
+{
+    auto shapes = CreateScatteredBoxes(int(state.GetArg()));
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        {
+            b2World   world(b2Vec2(0.0f, -10.0f));
+            b2BodyDef def;
+            state.ResumeTiming();
+
+            b2Body* body = world.CreateBody(&def);
+            for (auto& shape : shapes)
+                body->CreateFixture(&shape, 0.0f);
+            world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.GetIterations() * int64_t(shapes.size()));
+}
+
+KGE_BENCHMARK(Box2D_CreateFixturesBulk, 20000)
+{
+    auto shapes = CreateScatteredBoxes(int(state.GetArg()));
+
+    std::vector<b2FixtureDef> defs(shapes.size());
+    for (size_t i = 0; i < shapes.size(); ++i)
+        defs[i].shape = &shapes[i];
+
+    while (state.KeepRunning())
+    {
+        state.PauseTiming();
+        {
+            b2World   world(b2Vec2(0.0f, -10.0f));
+            b2BodyDef def;
+            state.ResumeTiming();
+
+            b2Body* body = world.CreateBody(&def);
+            body->CreateFixtures(defs.data(), int32(defs.size()));
+            world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.GetIterations() * int64_t(defs.size()));
+}
+
+//  bulk Ϊ true ʱ CreateFixtures һδмоߣ̬Զ° SAH 
+// оߣ̬롣ǩΪ̬нڵ֮ܳڵ֮ܳ
+void RunQueryAABB(State& state, bool bulk)
+{
+    auto shapes = CreateScatteredBoxes(int(state.GetArg()));
+
+    b2World world(b2Vec2(0.0f, -10.0f));
+    AddScatteredBoxes(world, shapes, bulk);
+
+    std::mt19937                           rng(3);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+
+    QueryCounter callback;
+    while (state.KeepRunning())
+    {
+        b2AABB aabb;
+        aabb.lowerBound.Set(pos_x(rng), pos_y(rng));
+        aabb.upperBound = aabb.lowerBound + b2Vec2(4.0f, 4.0f);
+        world.QueryAABB(&callback, aabb);
+    }
+    DoNotOptimize(callback.count);
+    state.SetItemsProcessed(state.GetIterations());
+    state.SetLabel(TreeQualityLabel(world));
+}
+
+void RunRayCast(State& state, bool bulk)
+{
+    auto shapes = CreateScatteredBoxes(int(state.GetArg()));
+
+    b2World world(b2Vec2(0.0f, -10.0f));
+    AddScatteredBoxes(world, shapes, bulk);
+
+    std::mt19937                           rng(5);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+
+    ClosestRayCast callback;
+    while (state.KeepRunning())
+    {
+        b2Vec2 p1(pos_x(rng), pos_y(rng));
+        b2Vec2 p2 = p1 + b2Vec2(50.0f, 0.0f);
+        callback.fraction = 1.0f;
+        world.RayCast(&callback, p1, p2);
+    }
+    DoNotOptimize(callback.fraction);
+    state.SetItemsProcessed(state.GetIterations());
+    state.SetLabel(TreeQualityLabel(world));
+}
+
+KGE_BENCHMARK(Box2D_QueryAABB, 20000)
+{
+    RunQueryAABB(state, false);
+}
+
+KGE_BENCHMARK(Box2D_QueryAABBBulk, 20000)
+{
+    RunQueryAABB(state, true);
+}
+
+KGE_BENCHMARK(Box2D_RayCast, 20000)
+{
+    RunRayCast(state, false);
+}
+
+KGE_BENCHMARK(Box2D_RayCastBulk, 20000)
+{
+    RunRayCast(state, true);
+}
+
+KGE_BENCHMARK(Box2D_SnapshotSaveRestore, 1000)
+{
+    b2World world(b2Vec2(0.0f, -10.0f));
+    world.SetAllowSleeping(false);
+    CreateGround(world, 50.0f);
+    CreateRandomBodies(world, int(state.GetArg()), 50.0f);
+    for (int i = 0; i < 120; ++i)
+        world.Step(kTimeStep, kVelocityIterations, kPositionIterations);
+
+    b2WorldSnapshot snapshot;
+    if (!CheckSnapshotDeterminism(world, snapshot, 60))
+    {
+        state.SkipWithError("simulation after restoring the snapshot is not bit-identical");
+        return;
+    }
+
+    while (state.KeepRunning())
+    {
+        snapshot.Save(&world);
+        if (!snapshot.Restore(&world))
+        {
+            state.SkipWithError("snapshot does not match the world");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.GetIterations() * int64_t(snapshot.GetSize()));
+}
+
+}  // namespace bench
+}  // namespace kiwano
@@ -0,0 +1,240 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano-physics/World.h>
+#include <random>
+
+namespace kiwano
+{
+namespace bench
+{
+
+namespace
+{
+
+const uint32_t kQueriesPerIteration = 1024;
+
+//  PhysicsBenchmark е Box2D_QueryAABBBox2D_RayCast ʹͬĳ
+RefPtr<physics::World> CreateScatteredWorld(int count)
+{
+    std::mt19937                           rng(7);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+    std::uniform_real_distribution<float32> size(0.5f, 1.5f);
+
+    RefPtr<physics::World> world = MakePtr<physics::World>(b2Vec2(0.0f, -10.0f));
+
+    b2BodyDef def;
+    b2Body*   body = world->GetB2World()->CreateBody(&def);
+    for (int i = 0; i < count; ++i)
+    {
+        b2PolygonShape shape;
+        shape.SetAsBox(size(rng), 0.5f, b2Vec2(pos_x(rng), pos_y(rng)), 0.0f);
+        body->CreateFixture(&shape, 0.0f);
+    }
+    return world;
+}
+
+std::vector<physics::RayCastQuery> CreateRays()
+{
+    std::mt19937                           rng(5);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+
+    std::vector<physics::RayCastQuery> queries(kQueriesPerIteration);
+    for (auto& query : queries)
+    {
+        query.p1 = b2Vec2(pos_x(rng), pos_y(rng));
+        query.p2 = query.p1 + b2Vec2(50.0f, 0.0f);
+    }
+    return queries;
+}
+
+std::vector<physics::AABBQuery> CreateBoxes()
+{
+    std::mt19937                           rng(3);
+    std::uniform_real_distribution<float32> pos_x(0.0f, 2000.0f);
+    std::uniform_real_distribution<float32> pos_y(0.0f, 200.0f);
+
+    std::vector<physics::AABBQuery> queries(kQueriesPerIteration);
+    for (auto& query : queries)
+    {
+        query.aabb.lowerBound.Set(pos_x(rng), pos_y(rng));
+        query.aabb.upperBound = query.aabb.lowerBound + b2Vec2(4.0f, 4.0f);
+    }
+    return queries;
+}
+
+struct ClosestRayCast : public b2RayCastCallback
+{
+    b2Fixture* fixture  = nullptr;
+    float32    fraction = 1.0f;
+
+    float32 ReportFixture(b2Fixture* f, const b2Vec2&, const b2Vec2&, float32 frac) override
+    {
+        fixture  = f;
+        fraction = frac;
+        return frac;
+    }
+};
+
+// ѯüоߵʵʰΧй˶̬еչΧУصͬļԱ֤һ
+struct TightQueryCounter : public b2QueryCallback
+{
+    const b2AABB* aabb  = nullptr;
+    uint32_t      count = 0;
+
+    bool ReportFixture(b2Fixture* fixture) override
+    {
+        if (b2TestOverlap(fixture->GetAABB(0), *aabb))
+            ++count;
+        return true;
+    }
+};
+
+// ûصӿڵõοӿڵĽȽ
+bool CheckRayCastBatch(physics::World* world, const std::vector<physics::RayCastQuery>& queries, uint32_t threads)
+{
+    std::vector<physics::RayCastHit> hits(queries.size());
+    world->RayCastBatch(queries.data(), hits.data(), uint32_t(queries.size()), threads);
+
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        ClosestRayCast callback;
+        world->GetB2World()->RayCast(&callback, queries[i].p1, queries[i].p2);
+        if (callback.fixture != hits[i].fixture || callback.fraction != hits[i].fraction)
+            return false;
+    }
+    return true;
+}
+
+bool CheckQueryAABBBatch(physics::World* world, const std::vector<physics::AABBQuery>& queries, uint32_t threads)
+{
+    std::vector<uint32_t> counts(queries.size());
+
+    physics::QueryResultBuffer results;
+    results.counts = counts.data();
+    world->QueryAABBBatch(queries.data(), uint32_t(queries.size()), results, threads);
+
+    for (size_t i = 0; i < queries.size(); ++i)
+    {
+        TightQueryCounter callback;
+        callback.aabb = &queries[i].aabb;
+        world->GetB2World()->QueryAABB(&callback, queries[i].aabb);
+        if (callback.count != counts[i])
+            return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+// »׼ÿεִ 1024 βѯصӿӿڵĽֱӶԱ
+
+KGE_BENCHMARK(Box2D_RayCastCallback)
+{
+    auto world   = CreateScatteredWorld(20000);
+    auto queries = CreateRays();
+
+    ClosestRayCast callback;
+    while (state.KeepRunning())
+    {
+        for (const auto& query : queries)
+        {
+            callback.fraction = 1.0f;
+            world->GetB2World()->RayCast(&callback, query.p1, query.p2);
+        }
+    }
+    DoNotOptimize(callback.fraction);
+    state.SetItemsProcessed(state.GetIterations() * int64_t(queries.size()));
+}
+
+// Ϊвѯ߳
+KGE_BENCHMARK(Box2D_RayCastBatch, 1, 4)
+{
+    auto           world   = CreateScatteredWorld(20000);
+    auto           queries = CreateRays();
+    const uint32_t threads = uint32_t(state.GetArg());
+
+    if (!CheckRayCastBatch(world.Get(), queries, threads))
+    {
+        state.SkipWithError("batch ray cast does not match the callback API");
+        return;
+    }
+
+    std::vector<physics::RayCastHit> hits(queries.size());
+    while (state.KeepRunning())
+    {
+        world->RayCastBatch(queries.data(), hits.data(), uint32_t(queries.size()), threads);
+    }
+    DoNotOptimize(hits.back().fraction);
+    state.SetItemsProcessed(state.GetIterations() * int64_t(queries.size()));
+}
+
+KGE_BENCHMARK(Box2D_QueryAABBCallback)
+{
+    auto world   = CreateScatteredWorld(20000);
+    auto queries = CreateBoxes();
+
+    TightQueryCounter callback;
+    while (state.KeepRunning())
+    {
+        for (const auto& query : queries)
+        {
+            callback.aabb = &query.aabb;
+            world->GetB2World()->QueryAABB(&callback, query.aabb);
+        }
+    }
+    DoNotOptimize(callback.count);
+    state.SetItemsProcessed(state.GetIterations() * int64_t(queries.size()));
+}
+
+// Ϊвѯ߳
+KGE_BENCHMARK(Box2D_QueryAABBBatch, 1, 4)
+{
+    auto           world   = CreateScatteredWorld(20000);
+    auto           queries = CreateBoxes();
+    const uint32_t threads = uint32_t(state.GetArg());
+
+    if (!CheckQueryAABBBatch(world.Get(), queries, threads))
+    {
+        state.SkipWithError("batch AABB query does not match the callback API");
+        return;
+    }
+
+    const uint32_t           max_results = 16;
+    std::vector<b2Fixture*> fixtures(queries.size() * max_results);
+    std::vector<uint32_t>   counts(queries.size());
+
+    physics::QueryResultBuffer results;
+    results.fixtures    = fixtures.data();
+    results.counts      = counts.data();
+    results.max_results = max_results;
+    while (state.KeepRunning())
+    {
+        world->QueryAABBBatch(queries.data(), uint32_t(queries.size()), results, threads);
+    }
+    DoNotOptimize(counts.back());
+    state.SetItemsProcessed(state.GetIterations() * int64_t(queries.size()));
+}
+
+}  // namespace bench
+}  // namespace kiwano
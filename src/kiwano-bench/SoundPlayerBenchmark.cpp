@@ -0,0 +1,76 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano-bench/Benchmark.h>
+#include <kiwano-bench/OggClips.h>
+#include <kiwano-audio/Module.h>
+#include <kiwano-audio/SoundPlayer.h>
+#include <mutex>
+#include <thread>
+
+namespace kiwano
+{
+namespace bench
+{
+
+// Ϊ߳ͨ SoundPlayer::Preload ʱĿ¼Ԥزͬ ogg ļ
+// ÿεʹµĲ֤ÿļ Module::Decode ¶ȡͽ
+KGE_BENCHMARK(SoundPlayer_Preload, 1, 2, 4, 8)
+{
+    const auto& files = GetOggClipFiles();
+    if (files.empty())
+    {
+        state.SkipWithError("write ogg files failed");
+        return;
+    }
+
+    //  SetupModule עᣬʼʧʱԤػ᷵ؿ
+    static std::once_flag setup_flag;
+    std::call_once(setup_flag, []() { audio::Module::GetInstance().SetupModule(); });
+
+    const uint32_t worker_count = uint32_t(state.GetArg());
+
+    Vector<String> paths(files.begin(), files.end());
+    int64_t        bytes = 0;
+
+    while (state.KeepRunning())
+    {
+        audio::SoundPlayer player;
+
+        auto clips = player.Preload(paths, worker_count);
+        for (const auto& clip : clips)
+        {
+            if (!clip)
+            {
+                state.SkipWithError("preload ogg files failed");
+                return;
+            }
+            bytes += int64_t(clip->GetData().size);
+        }
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.SetItemsProcessed(state.GetIterations() * int64_t(files.size()));
+    state.SetLabel("workers=" + std::to_string(worker_count)
+                   + " cores=" + std::to_string(std::thread::hardware_concurrency()));
+}
+
+}  // namespace bench
+}  // namespace kiwano
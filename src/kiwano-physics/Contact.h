@@ -31,12 +31,16 @@ namespace physics
  * @{
  */
 
+struct ContactRecord;
+
 /// \~chinese
 /// @brief Ӵʼ¼
+/// @details ¼ÿ b2World::Step 󰴽Ӵ¼ַ¼ᱻ
 class KGE_API ContactBeginEvent : public Event
 {
 public:
-    b2Contact* contact;  ///< ĽӴ
+    b2Contact*           contact;  ///< ĽӴӴͬһģѾʱΪ
+    const ContactRecord* record;   ///< Ӵ¼¼ַڼЧ
 
     ContactBeginEvent()
         : ContactBeginEvent(nullptr)
@@ -46,16 +50,20 @@ public:
     ContactBeginEvent(b2Contact* contact)
         : Event(KGE_EVENT(ContactBeginEvent))
         , contact(contact)
+        , record(nullptr)
     {
     }
 };
 
 /// \~chinese
 /// @brief Ӵ¼
+/// @details ģнĽӴ b2World::Step 󰴽Ӵ¼ַʱӴѱ٣
+/// ȲģĽӴַ
 class KGE_API ContactEndEvent : public Event
 {
 public:
-    b2Contact* contact;  ///< ĽӴ
+    b2Contact*           contact;  ///< ĽӴģַʱΪ
+    const ContactRecord* record;   ///< Ӵ¼¼ַڼЧ
 
     ContactEndEvent()
         : ContactEndEvent(nullptr)
@@ -65,10 +73,52 @@ public:
     ContactEndEvent(b2Contact* contact)
         : Event(KGE_EVENT(ContactEndEvent))
         , contact(contact)
+        , record(nullptr)
     {
     }
 };
 
+class Body;
+
+/// \~chinese
+/// @brief Ӵ¼
+enum class ContactRecordType
+{
+    Begin,  ///< Ӵʼ
+    End,    ///< Ӵ
+};
+
+/// \~chinese
+/// @brief Ӵ¼
+/// @details Ӵ¼ǲָȨļݣͼоָһ޸ǰЧ
+/// ٵ壬δַĽӴ¼ᱻ
+struct ContactRecord
+{
+    ContactRecordType type;             ///< ¼
+    Body*             body_a;           ///< A
+    Body*             body_b;           ///< B
+    b2Fixture*        fixture_a;        ///< оA
+    b2Fixture*        fixture_b;        ///< оB
+    uint16            category_a;       ///< ¼ʱоAײ
+    uint16            category_b;       ///< ¼ʱоBײ
+    b2Vec2            normal;           ///< ӴߣAָBӴʼʱЧ
+    b2Vec2            point;            ///< Ӵ㣬ӴʼʱЧ
+    int32             point_count;      ///< Ӵ
+    float32           normal_impulse;   ///< Ӵʼ
+    float32           tangent_impulse;  ///< Ӵʼ
+};
+
+/// \~chinese
+/// @brief Ӵ¼
+/// @details ײƥʱŴӴ¼˳Ի
+struct ContactFilter
+{
+    Body*  body_a     = nullptr;  ///< AΪʱƥ
+    Body*  body_b     = nullptr;  ///< BΪʱƥ
+    uint16 category_a = 0xFFFF;   ///< оAײ
+    uint16 category_b = 0xFFFF;   ///< оBײ
+};
+
 /// \~chinese
 /// @brief Ӵб
 class ContactList
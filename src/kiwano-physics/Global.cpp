@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano-physics/Global.h>
+#include <atomic>
 
 namespace kiwano
 {
@@ -28,6 +29,66 @@ namespace physics
 namespace
 {
 float global_scale = 100.f;  // 100 pixels per meters
+
+std::atomic<size_t> allocated_bytes(0);
+std::atomic<size_t> peak_bytes(0);
+std::atomic<size_t> allocation_count(0);
+
+// Keeps the size for the statistics and the allocator so memory is returned
+// to the same allocator even if memory::SetAllocator is called later
+struct alignas(16) AllocHeader
+{
+    size_t                   size;
+    memory::MemoryAllocator* allocator;
+};
+
+void* AllocForBox2D(int32 size, void*)
+{
+    memory::MemoryAllocator* allocator = memory::GetAllocator();
+
+    AllocHeader* header = static_cast<AllocHeader*>(allocator->Alloc(sizeof(AllocHeader) + size_t(size)));
+    if (!header)
+        return nullptr;
+
+    header->size      = size_t(size);
+    header->allocator = allocator;
+
+    size_t current = allocated_bytes.fetch_add(header->size) + header->size;
+    size_t peak    = peak_bytes.load();
+    while (current > peak && !peak_bytes.compare_exchange_weak(peak, current))
+    {
+    }
+    ++allocation_count;
+    return header + 1;
+}
+
+void FreeForBox2D(void* mem, void*)
+{
+    if (!mem)
+        return;
+
+    AllocHeader* header = static_cast<AllocHeader*>(mem) - 1;
+    allocated_bytes -= header->size;
+    header->allocator->Free(header);
+}
+
+// Installed during static initialization, before any world can allocate
+struct Box2DAllocatorInstaller
+{
+    Box2DAllocatorInstaller()
+    {
+        b2SetAllocator(AllocForBox2D, FreeForBox2D, nullptr);
+    }
+} box2d_allocator_installer;
+}  // namespace
+
+MemoryStats GetMemoryStats()
+{
+    MemoryStats stats;
+    stats.allocated_bytes  = allocated_bytes.load();
+    stats.peak_bytes       = peak_bytes.load();
+    stats.allocation_count = allocation_count.load();
+    return stats;
 }
 
 float GetScale()
@@ -69,5 +69,21 @@ b2Vec2 LocalToWorld(const Vec2& pos);
 /// @details ȫűصλתΪĵλ
 Vector<b2Vec2> LocalToWorld(const Vector<Vec2>& vertexs);
 
+/**
+ * \~chinese
+ * @brief ڴͳ
+ * @details Box2D ڴͨ memory::GetAllocator 䣬ͳڴ
+ */
+struct MemoryStats
+{
+    size_t allocated_bytes  = 0;  ///< ǰռõֽ
+    size_t peak_bytes       = 0;  ///< ռֽķֵ
+    size_t allocation_count = 0;  ///< ۼƷ
+};
+
+/// \~chinese
+/// @brief ȡڴͳ
+MemoryStats GetMemoryStats();
+
 }  // namespace physics
 }  // namespace kiwano
@@ -19,6 +19,12 @@
 // THE SOFTWARE.
 
 #include <kiwano-physics/World.h>
+#include <kiwano/utils/Profiler.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace kiwano
 {
@@ -27,145 +33,390 @@ namespace physics
 
 const float FIXED_TIMESTEP = 1.f / 60.f;
 
-class World::DebugDrawer : public b2Draw
+namespace
 {
-public:
-    DebugDrawer(const Size& size)
+
+// Broad-phase callbacks are templates, so these are called without virtual dispatch
+struct RayCastClosestCallback
+{
+    const b2BroadPhase* broad_phase;
+    const RayCastQuery* query;
+    RayCastHit*         hit;
+
+    float32 RayCastCallback(const b2RayCastInput& input, int32 proxy_id)
     {
-        canvas_ = MakePtr<Canvas>(size);
-        ctx_    = canvas_->GetContext2D();
+        auto       proxy   = static_cast<b2FixtureProxy*>(broad_phase->GetUserData(proxy_id));
+        b2Fixture* fixture = proxy->fixture;
+        if ((fixture->GetFilterData().categoryBits & query->mask_bits) == 0)
+            return input.maxFraction;
+
+        b2RayCastOutput output;
+        if (!fixture->RayCast(&output, input, proxy->childIndex))
+            return input.maxFraction;
 
-        b2Draw::SetFlags(b2Draw::e_shapeBit | b2Draw::e_jointBit | b2Draw::e_jointBit | b2Draw::e_centerOfMassBit);
+        hit->fixture  = fixture;
+        hit->fraction = output.fraction;
+        hit->normal   = output.normal;
+        hit->point    = (1.f - output.fraction) * input.p1 + output.fraction * input.p2;
+
+        // clip the ray to find the closest fixture
+        return output.fraction;
     }
+};
+
+struct QueryCollector
+{
+    const b2BroadPhase* broad_phase;
+    uint16              mask_bits;
+    b2Fixture**         fixtures;
+    uint32_t            max_results;
+    uint32_t            count;
 
-    void BeginDraw()
+    bool Collect(b2Fixture* fixture)
     {
-        ctx_->BeginDraw();
-        ctx_->Clear();
+        if (count < max_results)
+            fixtures[count] = fixture;
+        ++count;
+        return true;
     }
+};
 
-    void EndDraw()
+struct AABBQueryCallback : QueryCollector
+{
+    const b2AABB* aabb;
+
+    bool QueryCallback(int32 proxy_id)
     {
-        ctx_->EndDraw();
+        auto proxy = static_cast<b2FixtureProxy*>(broad_phase->GetUserData(proxy_id));
+        if ((proxy->fixture->GetFilterData().categoryBits & mask_bits) == 0)
+            return true;
+
+        // the tree stores fattened bounds
+        if (!b2TestOverlap(proxy->aabb, *aabb))
+            return true;
+        return Collect(proxy->fixture);
     }
+};
 
-    void Render(RenderContext& ctx)
+struct ShapeQueryCallback : QueryCollector
+{
+    const ShapeQuery* query;
+
+    bool QueryCallback(int32 proxy_id)
     {
-        canvas_->OnRender(ctx);
+        auto       proxy   = static_cast<b2FixtureProxy*>(broad_phase->GetUserData(proxy_id));
+        b2Fixture* fixture = proxy->fixture;
+        if ((fixture->GetFilterData().categoryBits & mask_bits) == 0)
+            return true;
+
+        if (!b2TestOverlap(query->shape, 0, fixture->GetShape(), proxy->childIndex, query->transform,
+                           fixture->GetBody()->GetTransform()))
+            return true;
+        return Collect(fixture);
     }
+};
+
+}  // namespace
 
-    void SetFillColor(const b2Color& color)
+class World::DebugDrawer : public b2Draw
+{
+public:
+    DebugDrawer()
+        : visible_aabb_()
     {
-        ctx_->SetFillColor(reinterpret_cast<const Color&>(color));
+        // Shapes are found through the broad-phase, Box2D only draws the joints
+        b2Draw::SetFlags(b2Draw::e_jointBit);
     }
 
-    void SetLineColor(const b2Color& color)
+    void Draw(b2World* world, RenderContext& ctx)
     {
-        ctx_->SetStrokeColor(reinterpret_cast<const Color&>(color));
+        for (auto& batch : batches_)
+        {
+            batch.lines.clear();
+            batch.triangles.clear();
+        }
+
+        // Visible rect in the coordinate system of the world actor
+        Matrix3x2 to_screen = ctx.GetTransform();
+        if (ctx.HasViewTransform())
+        {
+            to_screen = to_screen * ctx.GetViewTransform();
+        }
+
+        if (!to_screen.IsInvertible())
+            return;
+
+        const Rect visible_rect = to_screen.Invert().Transform(ctx.GetVisibleRect());
+        const b2Vec2 p1 = LocalToWorld(visible_rect.GetLeftTop());
+        const b2Vec2 p2 = LocalToWorld(visible_rect.GetRightBottom());
+        visible_aabb_.lowerBound = b2Min(p1, p2);
+        visible_aabb_.upperBound = b2Max(p1, p2);
+
+        broad_phase_ = &world->GetContactManager().m_broadPhase;
+        broad_phase_->Query(this, visible_aabb_);
+        broad_phase_ = nullptr;
+
+        world->DrawDebugData();
+
+        // Outlines and joints are drawn above the filled shapes
+        RefPtr<Brush> brush = ctx.GetCurrentBrush();
+        for (auto& batch : batches_)
+        {
+            if (!batch.triangles.empty())
+            {
+                ctx.SetCurrentBrush(GetBrush(batch));
+                ctx.FillTriangles(batch.triangles.data(), static_cast<uint32_t>(batch.triangles.size()));
+            }
+        }
+        for (auto& batch : batches_)
+        {
+            if (!batch.lines.empty())
+            {
+                ctx.SetCurrentBrush(GetBrush(batch));
+                ctx.DrawLines(batch.lines.data(), static_cast<uint32_t>(batch.lines.size()));
+            }
+        }
+        ctx.SetCurrentBrush(brush);
+    }
+
+    bool QueryCallback(int32 proxy_id)
+    {
+        b2FixtureProxy* proxy   = static_cast<b2FixtureProxy*>(broad_phase_->GetUserData(proxy_id));
+        b2Fixture*      fixture = proxy->fixture;
+        const b2Body*   body    = fixture->GetBody();
+
+        b2Color color(0.9f, 0.7f, 0.7f);
+        if (body->GetType() == b2_staticBody)
+            color.Set(0.5f, 0.9f, 0.5f);
+        else if (body->GetType() == b2_kinematicBody)
+            color.Set(0.5f, 0.5f, 0.9f);
+        else if (!body->IsAwake())
+            color.Set(0.6f, 0.6f, 0.6f);
+
+        DrawFixture(fixture, proxy->childIndex, body->GetTransform(), color);
+
+        // Draw the center of mass once per body
+        if (fixture == body->GetFixtureList())
+        {
+            b2Transform xf = body->GetTransform();
+            xf.p           = body->GetWorldCenter();
+            DrawTransform(xf);
+        }
+        return true;
     }
 
     void DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override
     {
-        SetLineColor(color);
+        Batch& batch = GetBatch(color);
 
         b2Vec2 p1 = vertices[vertexCount - 1];
         for (int32 i = 0; i < vertexCount; ++i)
         {
-            b2Vec2 p2 = vertices[i];
-            ctx_->DrawLine(WorldToLocal(p1), WorldToLocal(p2));
-            p1 = p2;
+            AddLine(batch, p1, vertices[i]);
+            p1 = vertices[i];
         }
     }
 
     void DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, const b2Color& color) override
     {
-        Vector<Point> local_vertices;
-        for (int32 i = 0; i < vertexCount; ++i)
+        Batch&      batch = GetBatch(color);
+        const Point p0    = WorldToLocal(vertices[0]);
+        for (int32 i = 1; i + 1 < vertexCount; ++i)
         {
-            local_vertices.push_back(WorldToLocal(vertices[i]));
+            batch.triangles.push_back(p0);
+            batch.triangles.push_back(WorldToLocal(vertices[i]));
+            batch.triangles.push_back(WorldToLocal(vertices[i + 1]));
         }
-        RefPtr<Shape> polygon = Shape::CreatePolygon(local_vertices);
-
-        SetFillColor(color);
-        ctx_->FillShape(polygon);
     }
 
     void DrawCircle(const b2Vec2& center, float32 radius, const b2Color& color) override
     {
-        SetLineColor(color);
-        ctx_->DrawCircle(WorldToLocal(center), WorldToLocal(radius));
+        Batch& batch = GetBatch(color);
+
+        b2Vec2 p1 = center + b2Vec2(radius, 0.0f);
+        for (int32 i = 1; i <= CIRCLE_SEGMENTS; ++i)
+        {
+            b2Vec2 p2 = center + radius * GetCircleVertex(i);
+            AddLine(batch, p1, p2);
+            p1 = p2;
+        }
     }
 
     void DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& color) override
     {
-        SetFillColor(color);
-        ctx_->FillCircle(WorldToLocal(center), WorldToLocal(radius));
+        KGE_NOT_USED(axis);
+
+        Batch&      batch = GetBatch(color);
+        const Point c     = WorldToLocal(center);
+
+        Point p1 = WorldToLocal(center + b2Vec2(radius, 0.0f));
+        for (int32 i = 1; i <= CIRCLE_SEGMENTS; ++i)
+        {
+            Point p2 = WorldToLocal(center + radius * GetCircleVertex(i));
+            batch.triangles.push_back(c);
+            batch.triangles.push_back(p1);
+            batch.triangles.push_back(p2);
+            p1 = p2;
+        }
     }
 
     void DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color) override
     {
-        SetLineColor(color);
-        ctx_->DrawLine(WorldToLocal(p1), WorldToLocal(p2));
+        AddLine(GetBatch(color), p1, p2);
     }
 
     void DrawTransform(const b2Transform& xf) override
     {
         const float k_axisScale = 0.4f;
 
-        b2Color red(1.0f, 0.0f, 0.0f);
-        b2Color green(0.0f, 1.0f, 0.0f);
-        b2Vec2  p1 = xf.p, p2;
+        AddLine(GetBatch(b2Color(1.0f, 0.0f, 0.0f)), xf.p, xf.p + k_axisScale * xf.q.GetXAxis());
+        AddLine(GetBatch(b2Color(0.0f, 1.0f, 0.0f)), xf.p, xf.p + k_axisScale * xf.q.GetYAxis());
+    }
 
-        p2 = p1 + k_axisScale * xf.q.GetXAxis();
+    void DrawPoint(const b2Vec2& p, float32 size, const b2Color& color) override
+    {
+        if (!IsVisible(p, p))
+            return;
 
-        SetLineColor(red);
-        ctx_->DrawLine(WorldToLocal(p1), WorldToLocal(p2));
+        // The size is in pixels
+        Batch&      batch = GetBatch(color);
+        const Point c     = WorldToLocal(p);
+        const float h     = size * 0.5f;
+        const Point lt(c.x - h, c.y - h), rt(c.x + h, c.y - h), rb(c.x + h, c.y + h), lb(c.x - h, c.y + h);
 
-        p2 = p1 + k_axisScale * xf.q.GetYAxis();
+        batch.triangles.insert(batch.triangles.end(), { lt, rt, rb, lt, rb, lb });
+    }
 
-        SetLineColor(green);
-        ctx_->DrawLine(WorldToLocal(p1), WorldToLocal(p2));
+private:
+    static const int32 CIRCLE_SEGMENTS = 16;
+
+    struct Batch
+    {
+        b2Color       color;
+        RefPtr<Brush> brush;
+        Vector<Point> lines;
+        Vector<Point> triangles;
+    };
+
+    Batch& GetBatch(const b2Color& color)
+    {
+        // Box2D only uses a handful of colors
+        for (auto& batch : batches_)
+        {
+            if (batch.color.r == color.r && batch.color.g == color.g && batch.color.b == color.b
+                && batch.color.a == color.a)
+            {
+                return batch;
+            }
+        }
+        batches_.push_back(Batch{ color, nullptr, {}, {} });
+        return batches_.back();
     }
 
-    void DrawPoint(const b2Vec2& p, float32 size, const b2Color& color) override
+    RefPtr<Brush> GetBrush(Batch& batch)
+    {
+        if (!batch.brush)
+        {
+            batch.brush = MakePtr<Brush>(reinterpret_cast<const Color&>(batch.color));
+        }
+        return batch.brush;
+    }
+
+    static b2Vec2 GetCircleVertex(int32 i)
+    {
+        // Unit circle computed once, shared by all circles
+        static const Vector<b2Vec2> vertices = []() {
+            Vector<b2Vec2> v(CIRCLE_SEGMENTS + 1);
+            for (int32 i = 0; i <= CIRCLE_SEGMENTS; ++i)
+            {
+                const float angle = 2.0f * b2_pi * i / CIRCLE_SEGMENTS;
+                v[i].Set(std::cos(angle), std::sin(angle));
+            }
+            return v;
+        }();
+        return vertices[i];
+    }
+
+    bool IsVisible(const b2Vec2& lower, const b2Vec2& upper) const
     {
-        SetFillColor(color);
-        ctx_->FillCircle(WorldToLocal(p), WorldToLocal(size));
+        return lower.x <= visible_aabb_.upperBound.x && lower.y <= visible_aabb_.upperBound.y
+               && upper.x >= visible_aabb_.lowerBound.x && upper.y >= visible_aabb_.lowerBound.y;
+    }
+
+    void AddLine(Batch& batch, const b2Vec2& p1, const b2Vec2& p2)
+    {
+        if (IsVisible(b2Min(p1, p2), b2Max(p1, p2)))
+        {
+            batch.lines.push_back(WorldToLocal(p1));
+            batch.lines.push_back(WorldToLocal(p2));
+        }
+    }
+
+    void DrawFixture(b2Fixture* fixture, int32 child_index, const b2Transform& xf, const b2Color& color)
+    {
+        switch (fixture->GetType())
+        {
+        case b2Shape::e_circle:
+        {
+            b2CircleShape* circle = static_cast<b2CircleShape*>(fixture->GetShape());
+            DrawSolidCircle(b2Mul(xf, circle->m_p), circle->m_radius, b2Mul(xf.q, b2Vec2(1.0f, 0.0f)), color);
+            break;
+        }
+        case b2Shape::e_edge:
+        {
+            b2EdgeShape* edge = static_cast<b2EdgeShape*>(fixture->GetShape());
+            DrawSegment(b2Mul(xf, edge->m_vertex1), b2Mul(xf, edge->m_vertex2), color);
+            break;
+        }
+        case b2Shape::e_chain:
+        {
+            // Each edge of a chain has its own proxy, draw only the visible ones
+            b2ChainShape* chain = static_cast<b2ChainShape*>(fixture->GetShape());
+            b2EdgeShape   edge;
+            chain->GetChildEdge(&edge, child_index);
+            DrawSegment(b2Mul(xf, edge.m_vertex1), b2Mul(xf, edge.m_vertex2), color);
+            break;
+        }
+        case b2Shape::e_polygon:
+        {
+            b2PolygonShape* poly = static_cast<b2PolygonShape*>(fixture->GetShape());
+            b2Vec2          vertices[b2_maxPolygonVertices];
+            for (int32 i = 0; i < poly->m_count; ++i)
+            {
+                vertices[i] = b2Mul(xf, poly->m_vertices[i]);
+            }
+            DrawSolidPolygon(vertices, poly->m_count, color);
+            break;
+        }
+        default:
+            break;
+        }
     }
 
 private:
-    RefPtr<Canvas>              canvas_;
-    RefPtr<CanvasRenderContext> ctx_;
+    b2AABB              visible_aabb_;
+    const b2BroadPhase* broad_phase_ = nullptr;
+    Vector<Batch>       batches_;
 };
 
 class ContactListener : public b2ContactListener
 {
-    Function<void(Event*)> dispatcher_;
+    World* world_;
 
 public:
-    ContactListener(Function<void(Event*)> dispatcher)
-        : dispatcher_(dispatcher)
+    ContactListener(World* world)
+        : world_(world)
     {
     }
 
     void BeginContact(b2Contact* b2contact) override
     {
-        RefPtr<ContactBeginEvent> evt = new ContactBeginEvent(b2contact);
-        dispatcher_(evt.Get());
+        world_->OnContactBegin(b2contact);
     }
 
     void EndContact(b2Contact* b2contact) override
     {
-        Body* body_a = static_cast<Body*>(b2contact->GetFixtureA()->GetBody()->GetUserData());
-        Body* body_b = static_cast<Body*>(b2contact->GetFixtureB()->GetBody()->GetUserData());
-        if (!body_a || !body_b || !body_a->GetBoundActor() || !body_b->GetBoundActor())
-        {
-            // Don't dispatch contact event after the body has been detached
-            return;
-        }
-
-        RefPtr<ContactEndEvent> evt = new ContactEndEvent(b2contact);
-        dispatcher_(evt.Get());
+        world_->OnContactEnd(b2contact);
     }
 
     void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override
@@ -176,26 +427,200 @@ public:
 
     void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override
     {
-        KGE_NOT_USED(contact);
-        KGE_NOT_USED(impulse);
+        world_->OnContactPostSolve(contact, impulse);
     }
 };
 
+class DestructionListener : public b2DestructionListener
+{
+    World* world_;
+
+public:
+    DestructionListener(World* world)
+        : world_(world)
+    {
+    }
+
+    void SayGoodbye(b2Joint* joint) override
+    {
+        KGE_NOT_USED(joint);
+    }
+
+    void SayGoodbye(b2Fixture* fixture) override
+    {
+        world_->OnFixtureDestroyed(fixture);
+    }
+};
+
+// Query threads are started on first use and kept until the world is destroyed.
+// Each call splits [0, count) into contiguous ranges and the calling thread takes part in the work.
+class World::QueryWorkers
+{
+public:
+    using RangeFunc = Function<void(uint32_t, uint32_t)>;
+
+    QueryWorkers()
+        : func_(nullptr)
+        , count_(0)
+        , chunk_(0)
+        , chunks_(0)
+        , next_chunk_(0)
+        , pending_(0)
+        , active_(0)
+        , job_id_(0)
+        , exiting_(false)
+    {
+    }
+
+    ~QueryWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            exiting_ = true;
+        }
+        job_cv_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    void Run(uint32_t count, uint32_t threads, const RangeFunc& func)
+    {
+        threads = std::max(1u, std::min(threads, count));
+        if (threads <= 1)
+        {
+            func(0, count);
+            return;
+        }
+
+        // Batches issued from different threads run one after another
+        std::lock_guard<std::mutex> run_lock(run_mutex_);
+
+        const uint32_t max_workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+        while (workers_.size() < std::min(threads - 1, max_workers))
+        {
+            workers_.emplace_back(&QueryWorkers::WorkerLoop, this);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            func_    = &func;
+            count_   = count;
+            chunk_   = (count + threads - 1) / threads;
+            chunks_  = (count + chunk_ - 1) / chunk_;
+            pending_ = chunks_;
+            next_chunk_.store(0, std::memory_order_relaxed);
+            ++job_id_;
+        }
+        job_cv_.notify_all();
+
+        RunChunks();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this]() { return pending_ == 0 && active_ == 0; });
+        func_ = nullptr;
+    }
+
+private:
+    void RunChunks()
+    {
+        uint32_t index = 0;
+        while ((index = next_chunk_.fetch_add(1, std::memory_order_relaxed)) < chunks_)
+        {
+            const uint32_t begin = index * chunk_;
+            (*func_)(begin, std::min(begin + chunk_, count_));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+                done_cv_.notify_all();
+        }
+    }
+
+    void WorkerLoop()
+    {
+        uint64_t seen_job = 0;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            job_cv_.wait(lock, [&]() { return exiting_ || job_id_ != seen_job; });
+            if (exiting_)
+                break;
+
+            seen_job = job_id_;
+            if (!func_)
+                continue;
+
+            // The caller waits for active workers, so the job stays valid until we leave it
+            ++active_;
+            lock.unlock();
+
+            RunChunks();
+
+            lock.lock();
+            if (--active_ == 0 && pending_ == 0)
+                done_cv_.notify_all();
+        }
+    }
+
+private:
+    std::mutex              run_mutex_;
+    std::mutex              mutex_;
+    std::condition_variable job_cv_;
+    std::condition_variable done_cv_;
+    Vector<std::thread>     workers_;
+
+    const RangeFunc*      func_;
+    uint32_t              count_;
+    uint32_t              chunk_;
+    uint32_t              chunks_;
+    std::atomic<uint32_t> next_chunk_;
+    uint32_t              pending_;
+    uint32_t              active_;
+    uint64_t              job_id_;
+    bool                  exiting_;
+};
+
 World::World(const b2Vec2& gravity)
     : world_(gravity)
     , vel_iter_(6)
     , pos_iter_(2)
     , fixed_acc_(0.f)
+    , contact_events_enabled_(true)
+    , dispatching_contacts_(false)
+    , began_contacts_sorted_(true)
+    , next_contact_handler_id_(0)
+    , debug_info_id_(0)
+    , next_region_id_(0)
 {
     SetName(KGE_COMP_PHYSIC_WORLD);
 
-    contact_listener_ = std::make_unique<ContactListener>(Closure(this, &World::DispatchEvent));
+    contact_listener_     = std::make_unique<ContactListener>(this);
+    destruction_listener_ = std::make_unique<DestructionListener>(this);
+    query_workers_        = std::unique_ptr<QueryWorkers>(new QueryWorkers);
     world_.SetContactListener(contact_listener_.get());
+    world_.SetDestructionListener(destruction_listener_.get());
+
+    debug_info_id_ = DebugActor::AddDebugInfo([=](StringStream& ss) {
+        const auto precision = ss.precision(2);
+        ss << std::fixed << "Physics: " << profile_.update.smoothed << "ms (max " << profile_.update.max
+           << "ms) Steps: " << profile_.steps << std::endl;
+        ss << "  Collide: " << profile_.collide.smoothed << "ms Solve: " << profile_.solve.smoothed
+           << "ms Sync: " << profile_.before_simulation.smoothed + profile_.after_simulation.smoothed << "ms"
+           << std::endl;
+        ss << "  Bodies: " << profile_.body_count << " Contacts: " << profile_.contact_count
+           << " Islands: " << profile_.island_count << " Skipped: " << profile_.skipped_island_count;
+        ss.precision(precision);
+    });
 }
 
 World::~World()
 {
+    DebugActor::RemoveDebugInfo(debug_info_id_);
     world_.SetContactListener(nullptr);
+    world_.SetDestructionListener(nullptr);
 }
 
 RefPtr<Body> World::AddBody(b2BodyDef* def)
@@ -204,6 +629,13 @@ RefPtr<Body> World::AddBody(b2BodyDef* def)
     return MakePtr<Body>(body, &world_);
 }
 
+RefPtr<Body> World::AddBody(b2BodyDef* def, const b2FixtureDef* fixture_defs, uint32_t count)
+{
+    b2Body* body = world_.CreateBody(def);
+    body->CreateFixtures(fixture_defs, static_cast<int32>(count));
+    return MakePtr<Body>(body, &world_);
+}
+
 b2Joint* World::AddJoint(b2JointDef* def)
 {
     return world_.CreateJoint(def);
@@ -219,6 +651,148 @@ const b2World* World::GetB2World() const
     return &world_;
 }
 
+void World::SaveSnapshot(WorldSnapshot& snapshot) const
+{
+    snapshot.state.Save(&world_);
+    snapshot.fixed_acc = fixed_acc_;
+}
+
+bool World::RestoreSnapshot(const WorldSnapshot& snapshot)
+{
+    if (!snapshot.state.Restore(&world_))
+    {
+        KGE_ERROR("Physics world snapshot does not match the world");
+        return false;
+    }
+
+    fixed_acc_ = snapshot.fixed_acc;
+
+    // Contacts are recreated, so the recorded contacts and records are stale
+    began_contacts_.clear();
+    ended_contacts_.clear();
+    contact_records_.clear();
+    record_contacts_.clear();
+
+    if (Actor* world_actor = GetBoundActor())
+    {
+        AfterSimulation(world_actor, Matrix3x2(), 0.0f);
+    }
+    return true;
+}
+
+void World::DoSerialize(Serializer* serializer) const
+{
+    Component::DoSerialize(serializer);
+
+    WorldSnapshot snapshot;
+    SaveSnapshot(snapshot);
+
+    const uint32_t size = static_cast<uint32_t>(snapshot.state.GetSize());
+    (*serializer) << snapshot.fixed_acc << size;
+    serializer->WriteBytes(snapshot.state.GetData(), size);
+}
+
+void World::DoDeserialize(Deserializer* deserializer)
+{
+    Component::DoDeserialize(deserializer);
+
+    WorldSnapshot snapshot;
+    uint32_t      size = 0;
+    (*deserializer) >> snapshot.fixed_acc >> size;
+
+    Vector<uint8_t> data(size);
+    if (size)
+    {
+        deserializer->ReadBytes(data.data(), size);
+    }
+    snapshot.state.SetData(data.data(), static_cast<int32>(size));
+
+    RestoreSnapshot(snapshot);
+}
+
+void World::RayCastBatch(const RayCastQuery* queries, RayCastHit* hits, uint32_t count, uint32_t threads) const
+{
+    KGE_ASSERT((queries && hits) || count == 0);
+
+    const b2BroadPhase* broad_phase = &world_.GetContactManager().m_broadPhase;
+    query_workers_->Run(count, threads,
+                        [=](uint32_t begin, uint32_t end)
+                        {
+                            for (uint32_t i = begin; i < end; ++i)
+                            {
+                                hits[i] = RayCastHit();
+
+                                RayCastClosestCallback callback = { broad_phase, &queries[i], &hits[i] };
+
+                                b2RayCastInput input;
+                                input.p1          = queries[i].p1;
+                                input.p2          = queries[i].p2;
+                                input.maxFraction = 1.f;
+                                broad_phase->RayCast(&callback, input);
+                            }
+                        });
+}
+
+void World::QueryAABBBatch(const AABBQuery* queries, uint32_t count, const QueryResultBuffer& results,
+                           uint32_t threads) const
+{
+    KGE_ASSERT((queries && results.counts) || count == 0);
+    KGE_ASSERT(results.fixtures || results.max_results == 0);
+
+    const b2BroadPhase* broad_phase = &world_.GetContactManager().m_broadPhase;
+    query_workers_->Run(count, threads,
+                        [=](uint32_t begin, uint32_t end)
+                        {
+                            for (uint32_t i = begin; i < end; ++i)
+                            {
+                                AABBQueryCallback callback;
+                                callback.broad_phase = broad_phase;
+                                callback.mask_bits   = queries[i].mask_bits;
+                                callback.fixtures    = results.fixtures + size_t(i) * results.max_results;
+                                callback.max_results = results.max_results;
+                                callback.count       = 0;
+                                callback.aabb        = &queries[i].aabb;
+
+                                broad_phase->Query(&callback, queries[i].aabb);
+                                results.counts[i] = callback.count;
+                            }
+                        });
+}
+
+void World::OverlapShapeBatch(const ShapeQuery* queries, uint32_t count, const QueryResultBuffer& results,
+                              uint32_t threads) const
+{
+    KGE_ASSERT((queries && results.counts) || count == 0);
+    KGE_ASSERT(results.fixtures || results.max_results == 0);
+
+    const b2BroadPhase* broad_phase = &world_.GetContactManager().m_broadPhase;
+    query_workers_->Run(count, threads,
+                        [=](uint32_t begin, uint32_t end)
+                        {
+                            for (uint32_t i = begin; i < end; ++i)
+                            {
+                                const ShapeQuery& query = queries[i];
+
+                                results.counts[i] = 0;
+                                if (!query.shape)
+                                    continue;
+
+                                ShapeQueryCallback callback;
+                                callback.broad_phase = broad_phase;
+                                callback.mask_bits   = query.mask_bits;
+                                callback.fixtures    = results.fixtures + size_t(i) * results.max_results;
+                                callback.max_results = results.max_results;
+                                callback.count       = 0;
+                                callback.query       = &query;
+
+                                b2AABB aabb;
+                                query.shape->ComputeAABB(&aabb, query.transform, 0);
+                                broad_phase->Query(&callback, aabb);
+                                results.counts[i] = callback.count;
+                            }
+                        });
+}
+
 ContactList World::GetContactList()
 {
     return ContactList(world_.GetContactList());
@@ -235,9 +809,22 @@ void World::InitComponent(Actor* actor)
 
 void World::OnUpdate(Duration dt)
 {
+    KGE_PROFILE_SCOPE("physics::World::OnUpdate");
+
     Actor* world_actor = GetBoundActor();
 
+    b2Timer update_timer;
+    b2Timer timer;
+
     BeforeSimulation(world_actor, Matrix3x2(), 0.0f);
+    profile_.before_simulation.Record(timer.GetMilliseconds());
+
+    // Buffers keep their capacity between frames
+    contact_records_.clear();
+    record_contacts_.clear();
+    destroyed_fixtures_.clear();
+
+    UpdateRegions();
 
     // Update physic world
     // The implementation referenced this article. https://www.unagames.com/blog/daniele/2010/06/fixed-time-step-implementation-box2d
@@ -250,24 +837,85 @@ void World::OnUpdate(Duration dt)
         fixed_acc_ -= steps * FIXED_TIMESTEP;
     }
 
+    // Box2D resets its profile every step, so sum up the steps of this frame
+    b2Profile step_profile = {};
+
     const int steps_clamped = std::min(steps, MAX_STEPS);
     for (int i = 0; i < steps_clamped; ++i)
     {
+        KGE_PROFILE_SCOPE("physics::World::Step");
+
+        began_contacts_.clear();
+        ended_contacts_.clear();
+
+        const size_t first_record = contact_records_.size();
         world_.Step(FIXED_TIMESTEP, vel_iter_, pos_iter_);
+
+        const b2Profile& p = world_.GetProfile();
+        step_profile.step += p.step;
+        step_profile.collide += p.collide;
+        step_profile.solve += p.solve;
+        step_profile.solveInit += p.solveInit;
+        step_profile.solveVelocity += p.solveVelocity;
+        step_profile.solvePosition += p.solvePosition;
+        step_profile.broadphase += p.broadphase;
+        step_profile.solveTOI += p.solveTOI;
+
+        // Contacts begun in this step may end in the next one, so their events are dispatched here
+        DispatchContactEvents(first_record);
     }
+    began_contacts_.clear();
+    ended_contacts_.clear();
 
+    profile_.step.Record(step_profile.step);
+    profile_.collide.Record(step_profile.collide);
+    profile_.solve.Record(step_profile.solve);
+    profile_.solve_init.Record(step_profile.solveInit);
+    profile_.solve_velocity.Record(step_profile.solveVelocity);
+    profile_.solve_position.Record(step_profile.solvePosition);
+    profile_.broadphase.Record(step_profile.broadphase);
+    profile_.solve_toi.Record(step_profile.solveTOI);
+
+    profile_.steps                = static_cast<uint32_t>(steps_clamped);
+    profile_.body_count           = static_cast<uint32_t>(world_.GetBodyCount());
+    profile_.joint_count          = static_cast<uint32_t>(world_.GetJointCount());
+    profile_.contact_count        = static_cast<uint32_t>(world_.GetContactCount());
+    profile_.island_count         = static_cast<uint32_t>(world_.GetIslandCount());
+    profile_.skipped_island_count = static_cast<uint32_t>(world_.GetSkippedIslandCount());
+
+    timer.Reset();
     AfterSimulation(world_actor, Matrix3x2(), 0.0f);
+    profile_.after_simulation.Record(timer.GetMilliseconds());
+
+    DispatchContactRecords();
+
+    profile_.update.Record(update_timer.GetMilliseconds());
+}
+
+void World::ResetProfile()
+{
+    profile_ = WorldProfile();
+}
+
+WorldMemoryStats World::GetMemoryStats() const
+{
+    const b2StackAllocator& stack = world_.GetStackAllocator();
+    const b2BlockAllocator& block = world_.GetBlockAllocator();
+
+    WorldMemoryStats stats;
+    stats.stack_capacity  = stack.GetCapacity();
+    stats.stack_peak      = stack.GetMaxAllocation();
+    stats.stack_overflows = stack.GetOverflowCount();
+    stats.block_chunks    = block.GetChunkCount();
+    stats.block_bytes     = block.GetChunkCount() * b2_chunkSize;
+    return stats;
 }
 
 void World::OnRender(RenderContext& ctx)
 {
     if (drawer_)
     {
-        drawer_->BeginDraw();
-        world_.DrawDebugData();
-        drawer_->EndDraw();
-
-        drawer_->Render(ctx);
+        drawer_->Draw(&world_, ctx);
     }
 }
 
@@ -313,14 +961,340 @@ void World::AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, flo
     }
 }
 
+uint32_t World::AddContactHandler(const ContactFilter& filter, const ContactHandler& handler)
+{
+    const uint32_t id = ++next_contact_handler_id_;
+    contact_handlers_.push_back(ContactHandlerEntry{ id, filter, handler });
+    return id;
+}
+
+void World::RemoveContactHandler(uint32_t id)
+{
+    auto iter = std::find_if(contact_handlers_.begin(), contact_handlers_.end(),
+                             [=](const ContactHandlerEntry& entry) { return entry.id == id; });
+    if (iter != contact_handlers_.end())
+    {
+        contact_handlers_.erase(iter);
+    }
+}
+
+uint32_t World::AddRegion(const Rect& bounds)
+{
+    const uint32_t id = ++next_region_id_;
+    regions_.push_back(RegionEntry{ id, bounds, RegionLOD::Full });
+    return id;
+}
+
+void World::RemoveRegion(uint32_t id)
+{
+    auto iter = std::find_if(regions_.begin(), regions_.end(),
+                             [=](const RegionEntry& entry) { return entry.id == id; });
+    if (iter != regions_.end())
+    {
+        regions_.erase(iter);
+    }
+
+    if (regions_.empty())
+    {
+        // UpdateRegions does nothing without regions, restore the full rate here
+        for (b2Body* b = world_.GetBodyList(); b; b = b->GetNext())
+        {
+            b->SetStepInterval(1);
+        }
+    }
+}
+
+RegionLOD World::GetRegionLOD(uint32_t id) const
+{
+    auto iter = std::find_if(regions_.begin(), regions_.end(),
+                             [=](const RegionEntry& entry) { return entry.id == id; });
+    if (iter != regions_.end())
+    {
+        return iter->lod;
+    }
+    return RegionLOD::Full;
+}
+
+void World::UpdateRegions()
+{
+    if (regions_.empty())
+        return;
+
+    for (auto& region : regions_)
+    {
+        // Distance from the focus to the nearest point of the region
+        const Rect& bounds   = region.bounds;
+        const float dx       = std::max(std::max(bounds.GetLeft() - focus_.x, focus_.x - bounds.GetRight()), 0.f);
+        const float dy       = std::max(std::max(bounds.GetTop() - focus_.y, focus_.y - bounds.GetBottom()), 0.f);
+        const float distance = std::sqrt(dx * dx + dy * dy);
+
+        if (distance > region_lod_settings_.frozen_distance)
+            region.lod = RegionLOD::Frozen;
+        else if (distance > region_lod_settings_.reduced_distance)
+            region.lod = RegionLOD::Reduced;
+        else
+            region.lod = RegionLOD::Full;
+    }
+
+    const int reduced_interval = std::max(region_lod_settings_.reduced_interval, 1);
+    for (b2Body* b = world_.GetBodyList(); b; b = b->GetNext())
+    {
+        // Sleeping bodies are not simulated anyway, they are updated once awake
+        if (b->GetType() == b2_staticBody || !b->IsAwake())
+            continue;
+
+        int         interval = 1;
+        const Point position = WorldToLocal(b->GetPosition());
+        for (const auto& region : regions_)
+        {
+            if (region.bounds.ContainsPoint(position))
+            {
+                if (region.lod == RegionLOD::Reduced)
+                    interval = reduced_interval;
+                else if (region.lod == RegionLOD::Frozen)
+                    interval = 0;
+                break;
+            }
+        }
+        b->SetStepInterval(interval);
+    }
+}
+
+namespace
+{
+
+bool MatchContactFilter(const ContactFilter& filter, const ContactRecord& record, bool swapped)
+{
+    Body*  body_a     = swapped ? record.body_b : record.body_a;
+    Body*  body_b     = swapped ? record.body_a : record.body_b;
+    uint16 category_a = swapped ? record.category_b : record.category_a;
+    uint16 category_b = swapped ? record.category_a : record.category_b;
+
+    if (filter.body_a && filter.body_a != body_a)
+        return false;
+    if (filter.body_b && filter.body_b != body_b)
+        return false;
+    if ((category_a & filter.category_a) == 0)
+        return false;
+    if ((category_b & filter.category_b) == 0)
+        return false;
+    return true;
+}
+
+}  // namespace
+
+void World::DispatchContactRecords()
+{
+    if (contact_handlers_.empty())
+    {
+        return;
+    }
+
+    // Handlers may destroy bodies and append end records, so the buffer is indexed.
+    // Fixtures destroyed by a handler or an event listener are collected and their remaining records are skipped
+    dispatching_contacts_ = true;
+
+    for (size_t i = 0; i < contact_records_.size(); ++i)
+    {
+        const ContactRecord record = contact_records_[i];
+        for (size_t j = 0; j < contact_handlers_.size(); ++j)
+        {
+            if (!destroyed_fixtures_.empty()
+                && (destroyed_fixtures_.count(record.fixture_a) || destroyed_fixtures_.count(record.fixture_b)))
+            {
+                break;
+            }
+
+            const auto& entry = contact_handlers_[j];
+            if (MatchContactFilter(entry.filter, record, false) || MatchContactFilter(entry.filter, record, true))
+            {
+                ContactHandler handler = entry.handler;
+                handler(record);
+            }
+        }
+    }
+
+    dispatching_contacts_ = false;
+    destroyed_fixtures_.clear();
+}
+
+void World::DispatchContactEvents(size_t first_record)
+{
+    const size_t last_record = contact_records_.size();
+    if (!contact_events_enabled_ || first_record == last_record || !GetBoundActor())
+    {
+        return;
+    }
+
+    if (!contact_begin_event_)
+    {
+        contact_begin_event_ = new ContactBeginEvent;
+        contact_end_event_   = new ContactEndEvent;
+    }
+
+    // A begun contact is still alive unless it ended after its begin record.
+    // Listeners may deactivate or destroy bodies, which appends unsorted entries
+    std::sort(ended_contacts_.begin(), ended_contacts_.end());
+    const size_t sorted_count = ended_contacts_.size();
+
+    dispatching_contacts_ = true;
+
+    for (size_t i = first_record; i < last_record; ++i)
+    {
+        const ContactRecord record = contact_records_[i];
+        if (!destroyed_fixtures_.empty()
+            && (destroyed_fixtures_.count(record.fixture_a) || destroyed_fixtures_.count(record.fixture_b)))
+        {
+            continue;
+        }
+
+        if (record.type == ContactRecordType::End)
+        {
+            contact_end_event_->contact = nullptr;
+            contact_end_event_->record  = &record;
+            DispatchEvent(contact_end_event_.Get());
+            continue;
+        }
+
+        b2Contact* contact = record_contacts_[i];
+
+        auto iter = std::upper_bound(ended_contacts_.begin(), ended_contacts_.begin() + sorted_count,
+                                     std::make_pair(contact, i));
+        if (iter != ended_contacts_.begin() + sorted_count && iter->first == contact)
+        {
+            contact = nullptr;
+        }
+        for (size_t j = sorted_count; contact && j < ended_contacts_.size(); ++j)
+        {
+            if (ended_contacts_[j].first == contact)
+                contact = nullptr;
+        }
+
+        contact_begin_event_->contact = contact;
+        contact_begin_event_->record  = &record;
+        DispatchEvent(contact_begin_event_.Get());
+    }
+
+    contact_begin_event_->record = nullptr;
+    contact_end_event_->record   = nullptr;
+    dispatching_contacts_        = false;
+}
+
+void World::OnContactBegin(b2Contact* contact)
+{
+    b2Fixture* fixture_a = contact->GetFixtureA();
+    b2Fixture* fixture_b = contact->GetFixtureB();
+
+    ContactRecord record;
+    record.type            = ContactRecordType::Begin;
+    record.body_a          = static_cast<Body*>(fixture_a->GetBody()->GetUserData());
+    record.body_b          = static_cast<Body*>(fixture_b->GetBody()->GetUserData());
+    record.fixture_a       = fixture_a;
+    record.fixture_b       = fixture_b;
+    record.category_a      = fixture_a->GetFilterData().categoryBits;
+    record.category_b      = fixture_b->GetFilterData().categoryBits;
+    record.point_count     = contact->GetManifold()->pointCount;
+    record.normal_impulse  = 0.f;
+    record.tangent_impulse = 0.f;
+
+    b2WorldManifold manifold;
+    contact->GetWorldManifold(&manifold);
+    record.normal = manifold.normal;
+    record.point  = (record.point_count > 0) ? manifold.points[0] : b2Vec2_zero;
+
+    // the impulses of this contact are reported by the solver later in this step
+    began_contacts_.emplace_back(contact, contact_records_.size());
+    began_contacts_sorted_ = false;
+    contact_records_.push_back(record);
+    record_contacts_.push_back(contact);
+}
+
+void World::OnContactEnd(b2Contact* contact)
+{
+    // the contact is destroyed after this call, events of earlier begin records must not expose it
+    ended_contacts_.emplace_back(contact, contact_records_.size());
+
+    b2Fixture* fixture_a = contact->GetFixtureA();
+    b2Fixture* fixture_b = contact->GetFixtureB();
+
+    Body* body_a = static_cast<Body*>(fixture_a->GetBody()->GetUserData());
+    Body* body_b = static_cast<Body*>(fixture_b->GetBody()->GetUserData());
+    if (!body_a || !body_b || !body_a->GetBoundActor() || !body_b->GetBoundActor())
+    {
+        // Don't dispatch contact event after the body has been detached
+        return;
+    }
+
+    ContactRecord record;
+    record.type            = ContactRecordType::End;
+    record.body_a          = body_a;
+    record.body_b          = body_b;
+    record.fixture_a       = fixture_a;
+    record.fixture_b       = fixture_b;
+    record.category_a      = fixture_a->GetFilterData().categoryBits;
+    record.category_b      = fixture_b->GetFilterData().categoryBits;
+    record.normal          = b2Vec2_zero;
+    record.point           = b2Vec2_zero;
+    record.point_count     = 0;
+    record.normal_impulse  = 0.f;
+    record.tangent_impulse = 0.f;
+    contact_records_.push_back(record);
+    record_contacts_.push_back(contact);
+
+    // contacts ended outside of the simulation, e.g. by destroying a body, are dispatched while still valid
+    if (contact_events_enabled_ && !world_.IsLocked())
+    {
+        RefPtr<ContactEndEvent> evt = new ContactEndEvent(contact);
+        evt->record                 = &record;
+        DispatchEvent(evt.Get());
+    }
+}
+
+void World::OnContactPostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    if (began_contacts_.empty())
+    {
+        return;
+    }
+
+    // begin callbacks of the collide and TOI phases append unsorted entries
+    if (!began_contacts_sorted_)
+    {
+        std::sort(began_contacts_.begin(), began_contacts_.end());
+        began_contacts_sorted_ = true;
+    }
+
+    // a contact may end in the same step as it began and its memory be reused by a new contact,
+    // the latest entry of an address belongs to the living contact
+    auto iter = std::upper_bound(began_contacts_.begin(), began_contacts_.end(), std::make_pair(contact, SIZE_MAX));
+    if (iter == began_contacts_.begin() || (--iter)->first != contact)
+    {
+        return;
+    }
+
+    ContactRecord& record = contact_records_[iter->second];
+    for (int32 i = 0; i < impulse->count; ++i)
+    {
+        record.normal_impulse  = std::max(record.normal_impulse, impulse->normalImpulses[i]);
+        record.tangent_impulse = std::max(record.tangent_impulse, std::abs(impulse->tangentImpulses[i]));
+    }
+}
+
+void World::OnFixtureDestroyed(b2Fixture* fixture)
+{
+    if (dispatching_contacts_)
+    {
+        destroyed_fixtures_.insert(fixture);
+    }
+}
+
 void World::ShowDebugInfo(bool show)
 {
     if (show)
     {
         if (!drawer_)
         {
-            Size size = Renderer::GetInstance().GetOutputSize();
-            drawer_   = std::unique_ptr<DebugDrawer>(new DebugDrawer(size));
+            drawer_ = std::unique_ptr<DebugDrawer>(new DebugDrawer);
 
             world_.SetDebugDraw(drawer_.get());
         }
@@ -21,6 +21,7 @@
 #pragma once
 #include <kiwano-physics/Body.h>
 #include <kiwano-physics/Contact.h>
+#include <kiwano/utils/Profiler.h>
 
 #define KGE_COMP_PHYSIC_WORLD "__KGE_PHYSIC_WORLD__"
 
@@ -39,6 +40,136 @@ namespace physics
  * @{
  */
 
+/**
+ * \~chinese
+ * @brief ߼
+ */
+struct RayCastQuery
+{
+    b2Vec2 p1;                  ///< 
+    b2Vec2 p2;                  ///< յ
+    uint16 mask_bits = 0xFFFF;  ///< 룬ײཻļо
+};
+
+/**
+ * \~chinese
+ * @brief ߼
+ */
+struct RayCastHit
+{
+    b2Fixture* fixture = nullptr;   ///< ļоߣδʱΪ
+    b2Vec2     point{ 0.f, 0.f };   ///< е㣬δʱΪ
+    b2Vec2     normal{ 0.f, 0.f };  ///< еı淨ߣδʱΪ
+    float32    fraction = 1.f;      ///< еϵı
+};
+
+/**
+ * \~chinese
+ * @brief Χвѯ
+ */
+struct AABBQuery
+{
+    b2AABB aabb;                ///< Χ
+    uint16 mask_bits = 0xFFFF;  ///< 룬ײཻļо
+};
+
+/**
+ * \~chinese
+ * @brief ״صѯ
+ * @details ״һ
+ */
+struct ShapeQuery
+{
+    const b2Shape* shape     = nullptr;  ///< ״
+    b2Transform    transform;            ///< ״ı任
+    uint16         mask_bits = 0xFFFF;   ///< 룬ײཻļо
+};
+
+/**
+ * \~chinese
+ * @brief ѯ
+ * @details  i ѯĽд fixtures[i * max_results] ʼλãcounts[i] ¼ѯļо
+ *  max_results ļо߲ᱻд
+ */
+struct QueryResultBuffer
+{
+    b2Fixture** fixtures    = nullptr;  ///< о߻СΪѯ * max_results
+    uint32_t*   counts      = nullptr;  ///< оСΪѯ
+    uint32_t    max_results = 0;        ///< ÿѯдļо
+};
+
+/**
+ * \~chinese
+ * @brief ͳ
+ * @details ÿ֡ģʱΪ֡ģⲽĺʱ֮
+ */
+struct WorldProfile
+{
+    ProfileTiming update;             ///< ܺʱ
+    ProfileTiming before_simulation;  ///< ģǰɫͬĺʱ
+    ProfileTiming after_simulation;   ///< ģͬɫĺʱ
+    ProfileTiming step;               ///< ģⲽʱ
+    ProfileTiming collide;            ///< խײʱ
+    ProfileTiming solve;              ///< Լʱ
+    ProfileTiming solve_init;         ///< Լʼʱ
+    ProfileTiming solve_velocity;     ///< ٶԼʱ
+    ProfileTiming solve_position;     ///< λԼʱ
+    ProfileTiming broadphase;         ///< ײʱ
+    ProfileTiming solve_toi;          ///< ײʱ
+
+    uint32_t body_count           = 0;  ///< 
+    uint32_t joint_count          = 0;  ///< ؽ
+    uint32_t contact_count        = 0;  ///< Ӵ
+    uint32_t island_count         = 0;  ///< һģⲽĵ
+    uint32_t skipped_island_count = 0;  ///< һģⲽϸڲĵ
+    uint32_t steps                = 0;  ///< һ֡ģⲽ
+};
+
+/// \~chinese
+/// @brief ϸڲ
+enum class RegionLOD
+{
+    Full,     ///< ÿģⲽģ
+    Reduced,  ///< ģƵ
+    Frozen    ///< 
+};
+
+/**
+ * \~chinese
+ * @brief ϸڲ
+ * @details 򵽽ľϸڲΣʱΪ 0
+ */
+struct RegionLODSettings
+{
+    float reduced_distance = 1000.f;  ///< 볬ֵʱģƵ
+    float frozen_distance  = 3000.f;  ///< 볬ֵʱ
+    int   reduced_interval = 2;       ///< ƵÿٸģⲽģһΣÿģӦʱ
+};
+
+/**
+ * \~chinese
+ * @brief ڴͳ
+ */
+struct WorldMemoryStats
+{
+    int32_t stack_capacity  = 0;  ///< ģⲽջ
+    int32_t stack_peak      = 0;  ///< ģⲽջķֵռ
+    int32_t stack_overflows = 0;  ///< ջʱöѷĴģⲽ֮Զ
+    int32_t block_chunks    = 0;  ///< Сڴ
+    int32_t block_bytes     = 0;  ///< Сռõֽ
+};
+
+/**
+ * \~chinese
+ * @brief ״̬
+ * @details յĻڶα֮临ãʺڻعͻطƵͻָ
+ */
+struct WorldSnapshot
+{
+    b2WorldSnapshot state;            ///< ״̬
+    float           fixed_acc = 0.f;  ///< ̶ۼʱ
+};
+
 /**
  * \~chinese
  * @brief 
@@ -47,8 +178,14 @@ class KGE_API World : public Component
 {
     friend class Body;
     friend class Joint;
+    friend class ContactListener;
+    friend class DestructionListener;
 
 public:
+    /// \~chinese
+    /// @brief Ӵ¼
+    using ContactHandler = Function<void(const ContactRecord&)>;
+
     /// \~chinese
     /// @brief 
     /// @param gravity 
@@ -60,6 +197,14 @@ public:
     /// @brief 
     RefPtr<Body> AddBody(b2BodyDef* def);
 
+    /// \~chinese
+    /// @brief 岢о
+    /// @details моߵĿһԶ¹о߸죬ʺϼش̬
+    /// @param def 嶨
+    /// @param fixture_defs о߶
+    /// @param count о
+    RefPtr<Body> AddBody(b2BodyDef* def, const b2FixtureDef* fixture_defs, uint32_t count);
+
     /// \~chinese
     /// @brief ӹؽ
     b2Joint* AddJoint(b2JointDef* def);
@@ -68,6 +213,56 @@ public:
     /// @brief ȡӴб
     ContactList GetContactList();
 
+    /// \~chinese
+    /// @brief ǷַӴ¼
+    /// @details Ӵ¼ÿ b2World::Step 󰴽Ӵ¼ַеü
+    /// رպֻ¼ӴģӴ¼ͨӴ¼ĬϿ
+    void SetContactEventsEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡ֡ĽӴ¼
+    /// @details ¼ÿθǰգᱻ
+    const Vector<ContactRecord>& GetContactRecords() const;
+
+    /// \~chinese
+    /// @brief ӽӴ¼
+    /// @details ڱ֡ģȫ󰴼¼˳򱻵
+    /// @param filter 
+    /// @param handler 
+    /// @return ID
+    uint32_t AddContactHandler(const ContactFilter& filter, const ContactHandler& handler);
+
+    /// \~chinese
+    /// @brief ƳӴ¼
+    /// @param id ID
+    void RemoveContactHandler(uint32_t id);
+
+    /// \~chinese
+    /// @brief ģ
+    /// @details ڵ尴ϸڲģ⣬κڵģ⡣λû
+    /// Խ߽һ֡ģ⡣໥Ӵɹؽӵ尴ߵƵһģ⣬
+    /// ˿Խ߽Աһ¡Ƶģ⾫൱Ը͵Ĺ̶Ƶģ⣬ѿܲȶ
+    /// @param bounds Χʹڽɫϵ
+    /// @return ID
+    uint32_t AddRegion(const Rect& bounds);
+
+    /// \~chinese
+    /// @brief Ƴģ
+    /// @param id ID
+    void RemoveRegion(uint32_t id);
+
+    /// \~chinese
+    /// @brief ϸڲεĽ㣬ͨΪһλ
+    void SetFocus(const Point& focus);
+
+    /// \~chinese
+    /// @brief ϸڲ
+    void SetRegionLODSettings(const RegionLODSettings& settings);
+
+    /// \~chinese
+    /// @brief ȡǰϸڲ
+    RegionLOD GetRegionLOD(uint32_t id) const;
+
     /// \~chinese
     /// @brief ٶȵ, ĬΪ 6
     void SetVelocityIterations(int vel_iter);
@@ -76,10 +271,76 @@ public:
     /// @brief λõ, ĬΪ 2
     void SetPositionIterations(int pos_iter);
 
+    /// \~chinese
+    /// @brief ǷʹÿӴ
+    /// @details ӴԽӴͼɫʹ SIMD ͬʱ⻥̬ĶӴٶԼ
+    /// ˳ͬ΢С졣֧ SSE2 ƽ̨ϸЧĬϹر
+    void SetWideContactSolver(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡͳ
+    const WorldProfile& GetProfile() const;
+
+    /// \~chinese
+    /// @brief ͳ
+    void ResetProfile();
+
+    /// \~chinese
+    /// @brief ȡڴͳ
+    WorldMemoryStats GetMemoryStats() const;
+
     /// \~chinese
     /// @brief ǷƵϢ
+    /// @details ֻƿɼڵ״ͬɫͼԪϲΪһ
     void ShowDebugInfo(bool show);
 
+    /// \~chinese
+    /// @brief ߼
+    /// @details ֱӱ̬Ϊÿоߵ麯صѯڼֻڶ߳ввѯ
+    /// @param queries ߼
+    /// @param hits ߼һһӦ
+    /// @param count 
+    /// @param threads вѯ߳
+    void RayCastBatch(const RayCastQuery* queries, RayCastHit* hits, uint32_t count, uint32_t threads = 1) const;
+
+    /// \~chinese
+    /// @brief ѯΧཻļо
+    /// @param queries Χвѯ
+    /// @param count 
+    /// @param results ѯ
+    /// @param threads вѯ߳
+    void QueryAABBBatch(const AABBQuery* queries, uint32_t count, const QueryResultBuffer& results,
+                        uint32_t threads = 1) const;
+
+    /// \~chinese
+    /// @brief ѯ״صļо
+    /// @param queries ״صѯ
+    /// @param count 
+    /// @param results ѯ
+    /// @param threads вѯ߳
+    void OverlapShapeBatch(const ShapeQuery* queries, uint32_t count, const QueryResultBuffer& results,
+                           uint32_t threads = 1) const;
+
+    /// \~chinese
+    /// @brief ״̬
+    /// @details հ˶״̬ӴԤȳ͹ؽ״̬״ȶ
+    void SaveSnapshot(WorldSnapshot& snapshot) const;
+
+    /// \~chinese
+    /// @brief ָ״̬
+    /// @details е塢оߺ͹ؽڱ뱣ʱͬҴ˳һ¡ָвַӴ¼
+    /// ָλͬɫձ֡ĽӴ¼
+    /// @return 粻ƥʱ false
+    bool RestoreSnapshot(const WorldSnapshot& snapshot);
+
+    /// \~chinese
+    /// @brief л
+    void DoSerialize(Serializer* serializer) const override;
+
+    /// \~chinese
+    /// @brief л
+    void DoDeserialize(Deserializer* deserializer) override;
+
     /// \~chinese
     /// @brief ȡb2World
     b2World* GetB2World();
@@ -113,6 +374,28 @@ protected:
     /// @brief 
     void AfterSimulation(Actor* parent, const Matrix3x2& parent_to_world, float parent_rotation);
 
+    /// \~chinese
+    /// @brief Ӵ¼ַһģвĽӴ¼
+    /// @param first_record ģĵһӴ¼
+    void DispatchContactEvents(size_t first_record);
+
+    /// \~chinese
+    /// @brief ýӴ¼
+    void DispatchContactRecords();
+
+    /// \~chinese
+    /// @brief ϸڲβģ
+    void UpdateRegions();
+
+private:
+    void OnContactBegin(b2Contact* contact);
+
+    void OnContactEnd(b2Contact* contact);
+
+    void OnContactPostSolve(b2Contact* contact, const b2ContactImpulse* impulse);
+
+    void OnFixtureDestroyed(b2Fixture* fixture);
+
 private:
     int     vel_iter_;
     int     pos_iter_;
@@ -122,11 +405,75 @@ private:
     class DebugDrawer;
     std::unique_ptr<DebugDrawer> drawer_;
 
-    std::unique_ptr<b2ContactListener> contact_listener_;
+    std::unique_ptr<b2ContactListener>     contact_listener_;
+    std::unique_ptr<b2DestructionListener> destruction_listener_;
+
+    class QueryWorkers;
+    std::unique_ptr<QueryWorkers> query_workers_;
+
+    struct ContactHandlerEntry
+    {
+        uint32_t       id;
+        ContactFilter  filter;
+        ContactHandler handler;
+    };
+
+    struct RegionEntry
+    {
+        uint32_t  id;
+        Rect      bounds;
+        RegionLOD lod;
+    };
+
+    WorldProfile profile_;
+    uint32_t     debug_info_id_;
+
+    uint32_t            next_region_id_;
+    Point               focus_;
+    RegionLODSettings   region_lod_settings_;
+    Vector<RegionEntry> regions_;
+
+    bool                                  contact_events_enabled_;
+    bool                                  dispatching_contacts_;
+    bool                                  began_contacts_sorted_;
+    uint32_t                              next_contact_handler_id_;
+    Vector<ContactRecord>                 contact_records_;
+    Vector<b2Contact*>                    record_contacts_;
+    Vector<std::pair<b2Contact*, size_t>> began_contacts_;
+    Vector<std::pair<b2Contact*, size_t>> ended_contacts_;
+    RefPtr<ContactBeginEvent>             contact_begin_event_;
+    RefPtr<ContactEndEvent>               contact_end_event_;
+    UnorderedSet<b2Fixture*>              destroyed_fixtures_;
+    Vector<ContactHandlerEntry>           contact_handlers_;
 };
 
 /** @} */
 
+inline void World::SetContactEventsEnabled(bool enabled)
+{
+    contact_events_enabled_ = enabled;
+}
+
+inline const Vector<ContactRecord>& World::GetContactRecords() const
+{
+    return contact_records_;
+}
+
+inline const WorldProfile& World::GetProfile() const
+{
+    return profile_;
+}
+
+inline void World::SetFocus(const Point& focus)
+{
+    focus_ = focus;
+}
+
+inline void World::SetRegionLODSettings(const RegionLODSettings& settings)
+{
+    region_lod_settings_ = settings;
+}
+
 inline void World::SetVelocityIterations(int vel_iter)
 {
     vel_iter_ = vel_iter;
@@ -137,5 +484,10 @@ inline void World::SetPositionIterations(int pos_iter)
     pos_iter_ = pos_iter;
 }
 
+inline void World::SetWideContactSolver(bool enabled)
+{
+    world_.SetWideContactSolver(enabled);
+}
+
 }  // namespace physics
 }  // namespace kiwano
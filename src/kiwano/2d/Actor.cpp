@@ -22,6 +22,7 @@
 #include <kiwano/2d/Stage.h>
 #include <kiwano/base/Director.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/render/Renderer.h>
 
 namespace kiwano
@@ -34,27 +35,42 @@ float default_anchor_y = 0.f;
 
 }  // namespace
 
+struct Actor::ExtraData
+{
+    UpdateCallback cb_update;
+    Matrix3x2      transform_matrix_inverse;
+};
+
+// Actor ǳĶ󣬷ֹڴռ޸
+static_assert(sizeof(Actor) <= 352, "Actor is getting too large, consider moving cold data into Actor::ExtraData");
+
 void Actor::SetDefaultAnchor(float anchor_x, float anchor_y)
 {
     default_anchor_x = anchor_x;
     default_anchor_y = anchor_y;
 }
 
+Point Actor::GetDefaultAnchor()
+{
+    return Point(default_anchor_x, default_anchor_y);
+}
+
 Actor::Actor()
     : ComponentManager(this)
     , visible_(true)
-    , visible_in_rt_(true)
     , update_pausing_(false)
     , cascade_opacity_(true)
     , show_border_(false)
+    , visible_in_rt_(true)
     , dirty_flag_(DirtyFlag::DirtyVisibility)
-    , parent_(nullptr)
-    , stage_(nullptr)
-    , hash_name_(0)
     , z_order_(0)
     , opacity_(1.f)
-    , displayed_opacity_(1.f)
+    , extra_(nullptr)
+    , parent_(nullptr)
     , anchor_(default_anchor_x, default_anchor_y)
+    , displayed_opacity_(1.f)
+    , stage_(nullptr)
+    , hash_name_(0)
 {
 }
 
@@ -62,10 +78,28 @@ Actor::~Actor()
 {
     RemoveAllChildren();
     RemoveAllComponents();
+
+    if (extra_)
+    {
+        delete extra_;
+        extra_ = nullptr;
+    }
+}
+
+Actor::ExtraData& Actor::GetExtraData() const
+{
+    if (!extra_)
+    {
+        extra_ = new ExtraData;
+    }
+    return *extra_;
 }
 
 void Actor::Update(Duration dt)
 {
+    // ɫֻܶ࣬ڲ֡м¼
+    KGE_PROFILE_SCOPE_SAMPLED("Actor::Update");
+
     if (children_.IsEmpty())
     {
         UpdateSelf(dt);
@@ -100,8 +134,8 @@ void Actor::UpdateSelf(Duration dt)
 
     if (!update_pausing_)
     {
-        if (cb_update_)
-            cb_update_(dt);
+        if (extra_ && extra_->cb_update)
+            extra_->cb_update(dt);
 
         OnUpdate(dt);
     }
@@ -117,6 +151,8 @@ void Actor::Render(RenderContext& ctx)
     if (!visible_)
         return;
 
+    KGE_PROFILE_SCOPE_SAMPLED("Actor::Render");
+
     UpdateTransform();
     UpdateOpacity();
 
@@ -189,6 +225,12 @@ void Actor::RenderBorder(RenderContext& ctx)
 
 bool Actor::CheckVisibility(RenderContext& ctx) const
 {
+    if (ctx.HasViewTransform())
+    {
+        // ͼ任ƶ仯ͬһ̨ܱ֡Ⱦ˲
+        return !size_.IsOrigin() && ctx.CheckVisibility(GetBounds(), transform_matrix_);
+    }
+
     if (dirty_flag_.Has(DirtyFlag::DirtyVisibility))
     {
         dirty_flag_.Unset(DirtyFlag::DirtyVisibility);
@@ -237,9 +279,9 @@ const Matrix3x2& Actor::GetTransformInverseMatrix() const
     if (dirty_flag_.Has(DirtyFlag::DirtyTransformInverse))
     {
         dirty_flag_.Unset(DirtyFlag::DirtyTransformInverse);
-        transform_matrix_inverse_ = transform_matrix_.Invert();
+        GetExtraData().transform_matrix_inverse = transform_matrix_.Invert();
     }
-    return transform_matrix_inverse_;
+    return GetExtraData().transform_matrix_inverse;
 }
 
 const Matrix3x2& Actor::GetTransformMatrixToParent() const
@@ -411,6 +453,23 @@ void Actor::SetTransform(const Transform& transform)
     dirty_flag_.Set(DirtyFlag::DirtyTransform);
 }
 
+void Actor::SetCallbackOnUpdate(const UpdateCallback& cb)
+{
+    if (cb || extra_)
+    {
+        GetExtraData().cb_update = cb;
+    }
+}
+
+Actor::UpdateCallback Actor::GetCallbackOnUpdate() const
+{
+    if (extra_)
+    {
+        return extra_->cb_update;
+    }
+    return nullptr;
+}
+
 void Actor::SetVisible(bool val)
 {
     visible_ = val;
@@ -616,7 +675,10 @@ bool Actor::ContainsPoint(const Point& point) const
     if (size_.x == 0.f || size_.y == 0.f)
         return false;
 
-    Point local = ConvertToLocal(point);
+    Point local;
+    if (!ScreenToLocal(point, local))
+        return false;
+
     return local.x >= 0 && local.y >= 0 && local.x <= size_.x && local.y <= size_.y;
 }
 
@@ -626,6 +688,16 @@ Point Actor::ConvertToLocal(const Point& point) const
     return local;
 }
 
+bool Actor::ScreenToLocal(const Point& point, Point& local) const
+{
+    Point stage_point = point;
+    if (stage_ && !stage_->ConvertToStage(point, stage_point))
+        return false;
+
+    local = ConvertToLocal(stage_point);
+    return true;
+}
+
 Point Actor::ConvertToWorld(const Point& point) const
 {
     Point world = GetTransformMatrix().Transform(point);
@@ -388,6 +388,7 @@ public:
 
     /// \~chinese
     /// @brief жϵǷڽɫ
+    /// @param point Ⱦ꣬λą̃ʱᾭͼ任
     virtual bool ContainsPoint(const Point& point) const;
 
     /// \~chinese
@@ -398,6 +399,14 @@ public:
     /// @brief ֲϵתΪϵ
     Point ConvertToWorld(const Point& point) const;
 
+    /// \~chinese
+    /// @brief ȾϵתΪֲϵ
+    /// @details ̨ʱȾͼ任 Stage::ConvertToStage
+    /// @param point Ⱦ꣬λ
+    /// @param[out] local ֲ
+    /// @return 㲻κõӿʱ false
+    bool ScreenToLocal(const Point& point, Point& local) const;
+
     /// \~chinese
     /// @brief Ⱦɫ߽
     void ShowBorder(bool show);
@@ -414,6 +423,10 @@ public:
     /// @brief Ĭê
     static void SetDefaultAnchor(float anchor_x, float anchor_y);
 
+    /// \~chinese
+    /// @brief ȡĬê
+    static Point GetDefaultAnchor();
+
 protected:
     /// \~chinese
     /// @brief ӽɫ
@@ -470,29 +483,39 @@ protected:
     Flag<uint8_t>& GetDirtyFlag() const;
 
 private:
-    bool         visible_;
-    bool         update_pausing_;
-    bool         cascade_opacity_;
-    bool         show_border_;
-    mutable bool visible_in_rt_;
-
-    mutable Flag<uint8_t> dirty_flag_;
+    /// \~chinese
+    /// @brief ɫݣʹõʱŴ
+    struct ExtraData;
 
-    int            z_order_;
-    float          opacity_;
-    float          displayed_opacity_;
-    Actor*         parent_;
-    Stage*         stage_;
-    size_t         hash_name_;
-    Point          anchor_;
-    Size           size_;
-    ActorList      children_;
-    UpdateCallback cb_update_;
-    Transform      transform_;
+    /// \~chinese
+    /// @brief ȡݣʱ
+    ExtraData& GetExtraData() const;
 
+private:
+    // ±ʱʵݣڻڵ֮
+    bool                  visible_;
+    bool                  update_pausing_;
+    bool                  cascade_opacity_;
+    bool                  show_border_;
+    mutable bool          visible_in_rt_;
+    mutable Flag<uint8_t> dirty_flag_;
+    int                   z_order_;
+    float                 opacity_;
+    ActorList             children_;
+    mutable ExtraData*    extra_;
+
+    // Ⱦʱ任͸
+    Actor*            parent_;
+    Transform         transform_;
+    Point             anchor_;
+    Size              size_;
+    float             displayed_opacity_;
     mutable Matrix3x2 transform_matrix_;
-    mutable Matrix3x2 transform_matrix_inverse_;
     mutable Matrix3x2 transform_matrix_to_parent_;
+
+    // ٷʵ
+    Stage* stage_;
+    size_t hash_name_;
 };
 
 /** @} */
@@ -667,16 +690,6 @@ inline bool Actor::IsUpdatePausing() const
     return update_pausing_;
 }
 
-inline void Actor::SetCallbackOnUpdate(const UpdateCallback& cb)
-{
-    cb_update_ = cb;
-}
-
-inline Actor::UpdateCallback Actor::GetCallbackOnUpdate() const
-{
-    return cb_update_;
-}
-
 inline void Actor::ShowBorder(bool show)
 {
     show_border_ = show;
@@ -0,0 +1,317 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/2d/Actor.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ɫ
+ * @details
+ * ԤȴһɫظʹãӵҡӵƵٵĽɫ
+ * ʼճгнɫãɫӸɫƳûʱüʣһ
+ * ֮ȡɫʱԶաò·䣬ᱻ١
+ * ΪȡɫʱԶֻϴλպֻȡ㹻ĽɫʱŽ
+ */
+template <typename _Ty>
+class ActorPool : Noncopyable
+{
+    static_assert(std::is_base_of<Actor, _Ty>::value, "_Ty must be derived from Actor");
+
+public:
+    /// \~chinese
+    /// @brief ɫ
+    typedef Function<RefPtr<_Ty>()> Creator;
+
+    /// \~chinese
+    /// @brief ɫûص
+    typedef Function<void(_Ty*)> ResetCallback;
+
+    /// \~chinese
+    /// @brief 
+    /// @param capacity ԤȴĽɫ
+    /// @param creator ɫΪʱʹĬϹ캯
+    ActorPool(size_t capacity = 0, const Creator& creator = nullptr);
+
+    /// \~chinese
+    /// @brief ȡһɫ
+    /// @details ȸѻյĽɫûпнɫʱԻղʹõĽɫȻûʱ½ɫ
+    RefPtr<_Ty> Acquire();
+
+    /// \~chinese
+    /// @brief սɫ
+    /// @details ɫӸɫƳ
+    void Recycle(RefPtr<_Ty> actor);
+
+    /// \~chinese
+    /// @brief ѲٱʹõĽɫ
+    /// @return յĽɫ
+    size_t Collect();
+
+    /// \~chinese
+    /// @brief Ԥȴɫʹнɫ count
+    void Reserve(size_t count);
+
+    /// \~chinese
+    /// @brief пнɫ
+    void Shrink();
+
+    /// \~chinese
+    /// @brief ýɫ
+    void SetCreator(const Creator& creator);
+
+    /// \~chinese
+    /// @brief ýɫûص
+    /// @details Ĭã ResetActor֮ãڻָԶ״̬
+    void SetResetCallback(const ResetCallback& cb);
+
+    /// \~chinese
+    /// @brief ȡеĽɫ
+    size_t GetSize() const;
+
+    /// \~chinese
+    /// @brief ȡʹõĽɫ
+    size_t GetUsedCount() const;
+
+    /// \~chinese
+    /// @brief ȡнɫ
+    size_t GetFreeCount() const;
+
+    /// \~chinese
+    /// @brief ȡͬʱʹõĽɫֵ
+    size_t GetPeakUsedCount() const;
+
+    /// \~chinese
+    /// @brief ȡغľⴴĽɫ
+    size_t GetGrowthCount() const;
+
+    /// \~chinese
+    /// @brief ɫָΪĬ״̬
+    /// @details öά任ê㡢͸ȡɼԡZ ˳򡢸״̬͸»صƳж
+    static void ResetActor(Actor* actor);
+
+private:
+    RefPtr<_Ty> Create();
+
+    void Reset(_Ty* actor);
+
+private:
+    size_t              peak_used_count_;
+    size_t              growth_count_;
+    size_t              acquired_since_collect_;
+    Creator             creator_;
+    ResetCallback       reset_cb_;
+    Vector<RefPtr<_Ty>> free_actors_;
+    Vector<RefPtr<_Ty>> used_actors_;
+};
+
+/** @} */
+
+template <typename _Ty>
+ActorPool<_Ty>::ActorPool(size_t capacity, const Creator& creator)
+    : peak_used_count_(0)
+    , growth_count_(0)
+    , acquired_since_collect_(0)
+    , creator_(creator)
+{
+    Reserve(capacity);
+}
+
+template <typename _Ty>
+RefPtr<_Ty> ActorPool<_Ty>::Acquire()
+{
+    // ÿλյĿʹеĽɫȣϴλպȡĽɫﵽķ֮һʱٴλգ
+    // ʹȡɫʱľ̯Ϊ
+    if (free_actors_.empty() && acquired_since_collect_ * 4 >= used_actors_.size())
+    {
+        Collect();
+    }
+
+    RefPtr<_Ty> actor;
+    if (free_actors_.empty())
+    {
+        actor = Create();
+        ++growth_count_;
+    }
+    else
+    {
+        actor = free_actors_.back();
+        free_actors_.pop_back();
+    }
+
+    if (actor)
+    {
+        ++acquired_since_collect_;
+        used_actors_.push_back(actor);
+        peak_used_count_ = std::max(peak_used_count_, used_actors_.size());
+    }
+    return actor;
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::Recycle(RefPtr<_Ty> actor)
+{
+    if (!actor)
+        return;
+
+    auto iter = std::find(used_actors_.begin(), used_actors_.end(), actor);
+    if (iter != used_actors_.end())
+    {
+        std::iter_swap(iter, used_actors_.end() - 1);
+        used_actors_.pop_back();
+
+        actor->RemoveFromParent();
+        Reset(actor.Get());
+        free_actors_.push_back(actor);
+    }
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::Collect()
+{
+    acquired_since_collect_ = 0;
+
+    size_t count = 0;
+    for (size_t i = 0; i < used_actors_.size();)
+    {
+        // ʣسʱɫѲٱʹ
+        if (used_actors_[i]->GetRefCount() == 1)
+        {
+            Reset(used_actors_[i].Get());
+            free_actors_.push_back(used_actors_[i]);
+
+            used_actors_[i] = used_actors_.back();
+            used_actors_.pop_back();
+            ++count;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    return count;
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::Reserve(size_t count)
+{
+    free_actors_.reserve(count);
+    while (free_actors_.size() < count)
+    {
+        RefPtr<_Ty> actor = Create();
+        if (!actor)
+            break;
+        free_actors_.push_back(actor);
+    }
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::Shrink()
+{
+    free_actors_.clear();
+    free_actors_.shrink_to_fit();
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::SetCreator(const Creator& creator)
+{
+    creator_ = creator;
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::SetResetCallback(const ResetCallback& cb)
+{
+    reset_cb_ = cb;
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::GetSize() const
+{
+    return free_actors_.size() + used_actors_.size();
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::GetUsedCount() const
+{
+    return used_actors_.size();
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::GetFreeCount() const
+{
+    return free_actors_.size();
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::GetPeakUsedCount() const
+{
+    return peak_used_count_;
+}
+
+template <typename _Ty>
+size_t ActorPool<_Ty>::GetGrowthCount() const
+{
+    return growth_count_;
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::ResetActor(Actor* actor)
+{
+    actor->RemoveAllAnimations();
+    actor->RemoveAllTasks();
+    actor->SetTransform(Transform());
+    actor->SetAnchor(Actor::GetDefaultAnchor());
+    actor->SetOpacity(1.f);
+    actor->SetVisible(true);
+    actor->SetZOrder(0);
+    actor->ResumeUpdating();
+    actor->SetCallbackOnUpdate(nullptr);
+}
+
+template <typename _Ty>
+RefPtr<_Ty> ActorPool<_Ty>::Create()
+{
+    if (creator_)
+    {
+        return creator_();
+    }
+    return MakePtr<_Ty>();
+}
+
+template <typename _Ty>
+void ActorPool<_Ty>::Reset(_Ty* actor)
+{
+    ResetActor(actor);
+
+    if (reset_cb_)
+    {
+        reset_cb_(actor);
+    }
+}
+
+}  // namespace kiwano
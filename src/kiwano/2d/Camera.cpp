@@ -0,0 +1,170 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/Camera.h>
+#include <kiwano/render/Renderer.h>
+
+namespace kiwano
+{
+
+Camera::Camera()
+    : enabled_(true)
+    , dirty_(true)
+    , zoom_(1.f)
+    , rotation_(0.f)
+{
+    actual_viewport_ = Rect(Point(), Renderer::GetInstance().GetOutputSize());
+    position_        = actual_viewport_.GetCenter();
+}
+
+Camera::Camera(const Rect& viewport)
+    : Camera()
+{
+    SetViewport(viewport);
+}
+
+Camera::~Camera() {}
+
+void Camera::SetPosition(const Point& pos)
+{
+    if (position_ == pos)
+        return;
+
+    position_ = pos;
+    dirty_    = true;
+}
+
+void Camera::Move(const Vec2& offset)
+{
+    SetPosition(position_ + offset);
+}
+
+void Camera::SetZoom(float zoom)
+{
+    if (zoom_ == zoom)
+        return;
+
+    zoom_  = zoom;
+    dirty_ = true;
+}
+
+void Camera::SetRotation(float rotation)
+{
+    if (rotation_ == rotation)
+        return;
+
+    rotation_ = rotation;
+    dirty_    = true;
+}
+
+void Camera::SetViewport(const Rect& viewport)
+{
+    viewport_ = viewport;
+    if (!viewport.IsEmpty())
+    {
+        actual_viewport_ = viewport;
+    }
+    dirty_ = true;
+}
+
+const Matrix3x2& Camera::GetViewMatrix() const
+{
+    UpdateViewMatrix();
+    return view_matrix_;
+}
+
+const Matrix3x2& Camera::GetViewInverseMatrix() const
+{
+    UpdateViewMatrix();
+    return view_matrix_inverse_;
+}
+
+Rect Camera::GetViewRect() const
+{
+    return GetViewInverseMatrix().Transform(actual_viewport_);
+}
+
+Point Camera::ConvertToStage(const Point& point) const
+{
+    return GetViewInverseMatrix().Transform(point);
+}
+
+bool Camera::IsInViewport(const Point& point) const
+{
+    return actual_viewport_.ContainsPoint(point);
+}
+
+Point Camera::ConvertToViewport(const Point& point) const
+{
+    return GetViewMatrix().Transform(point);
+}
+
+void Camera::BeginRender(RenderContext& ctx)
+{
+    if (viewport_.IsEmpty())
+    {
+        Rect viewport(Point(), ctx.GetSize());
+        if (!(viewport == actual_viewport_))
+        {
+            actual_viewport_ = viewport;
+            dirty_           = true;
+        }
+    }
+
+    saved_view_matrix_  = ctx.GetViewTransform();
+    saved_visible_rect_ = ctx.GetVisibleRect();
+
+    // üҪûͼ任ϵ
+    ctx.ResetViewTransform();
+    ctx.SetTransform(Matrix3x2());
+    ctx.PushClipRect(actual_viewport_);
+
+    ctx.SetViewTransform(GetViewMatrix());
+    ctx.SetVisibleRect(actual_viewport_);
+}
+
+void Camera::EndRender(RenderContext& ctx)
+{
+    ctx.ResetViewTransform();
+    ctx.SetTransform(Matrix3x2());
+    ctx.PopClipRect();
+
+    ctx.SetViewTransform(saved_view_matrix_);
+    ctx.SetVisibleRect(saved_visible_rect_);
+}
+
+void Camera::UpdateViewMatrix() const
+{
+    if (!dirty_)
+        return;
+
+    dirty_ = false;
+
+    // Ƚλԭ㣬תţƶӿ
+    view_matrix_ = Matrix3x2::Translation(-position_) * Matrix3x2::Rotation(-rotation_)
+                   * Matrix3x2::Scaling(Vec2(zoom_, zoom_)) * Matrix3x2::Translation(actual_viewport_.GetCenter());
+
+    if (view_matrix_.IsInvertible())
+    {
+        view_matrix_inverse_ = view_matrix_.Invert();
+    }
+}
+
+}  // namespace kiwano
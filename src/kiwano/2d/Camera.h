@@ -0,0 +1,184 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/base/ObjectBase.h>
+#include <kiwano/math/Math.h>
+
+namespace kiwano
+{
+
+class RenderContext;
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief 
+ * @details
+ * ͼ任ȾʱɫĶά任ϣƶıɫı任
+ * ̨ӶÿȾԵӿУСͼ
+ * @see kiwano::Stage
+ */
+class KGE_API Camera : public ObjectBase
+{
+public:
+    Camera();
+
+    /// \~chinese
+    /// @brief 
+    /// @param viewport ӿڣΪʱʹȾ
+    Camera(const Rect& viewport);
+
+    virtual ~Camera();
+
+    /// \~chinese
+    /// @brief Ƿ
+    bool IsEnabled() const;
+
+    /// \~chinese
+    /// @brief Ƿ
+    void SetEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡλãӿĶӦ̨
+    const Point& GetPosition() const;
+
+    /// \~chinese
+    /// @brief λ
+    /// @param pos ӿĶӦ̨
+    void SetPosition(const Point& pos);
+
+    /// \~chinese
+    /// @brief ƶ
+    /// @param offset ̨ϵµƫ
+    void Move(const Vec2& offset);
+
+    /// \~chinese
+    /// @brief ȡű
+    float GetZoom() const;
+
+    /// \~chinese
+    /// @brief ű
+    void SetZoom(float zoom);
+
+    /// \~chinese
+    /// @brief ȡתǶ
+    float GetRotation() const;
+
+    /// \~chinese
+    /// @brief תǶ
+    void SetRotation(float rotation);
+
+    /// \~chinese
+    /// @brief ȡӿ
+    const Rect& GetViewport() const;
+
+    /// \~chinese
+    /// @brief ӿ
+    /// @param viewport ȾϵµӿڣΪʱʹȾ
+    void SetViewport(const Rect& viewport);
+
+    /// \~chinese
+    /// @brief ȡͼ
+    const Matrix3x2& GetViewMatrix() const;
+
+    /// \~chinese
+    /// @brief ȡͼ
+    const Matrix3x2& GetViewInverseMatrix() const;
+
+    /// \~chinese
+    /// @brief ȡӿ̨ϵµİΧ
+    Rect GetViewRect() const;
+
+    /// \~chinese
+    /// @brief ȾתΪ̨
+    Point ConvertToStage(const Point& point) const;
+
+    /// \~chinese
+    /// @brief жȾϵµĵǷӿ
+    bool IsInViewport(const Point& point) const;
+
+    /// \~chinese
+    /// @brief ̨תΪȾ
+    Point ConvertToViewport(const Point& point) const;
+
+    /// \~chinese
+    /// @brief ʼԸȾ
+    /// @details üӿڣȾĵͼ任ɼ
+    void BeginRender(RenderContext& ctx);
+
+    /// \~chinese
+    /// @brief ԸȾָȾ֮ǰ״̬
+    void EndRender(RenderContext& ctx);
+
+private:
+    void UpdateViewMatrix() const;
+
+private:
+    bool              enabled_;
+    mutable bool      dirty_;
+    float             zoom_;
+    float             rotation_;
+    Point             position_;
+    Rect              viewport_;
+    Rect              actual_viewport_;
+    Rect              saved_visible_rect_;
+    Matrix3x2         saved_view_matrix_;
+    mutable Matrix3x2 view_matrix_;
+    mutable Matrix3x2 view_matrix_inverse_;
+};
+
+/** @} */
+
+inline bool Camera::IsEnabled() const
+{
+    return enabled_;
+}
+
+inline void Camera::SetEnabled(bool enabled)
+{
+    enabled_ = enabled;
+}
+
+inline const Point& Camera::GetPosition() const
+{
+    return position_;
+}
+
+inline float Camera::GetZoom() const
+{
+    return zoom_;
+}
+
+inline float Camera::GetRotation() const
+{
+    return rotation_;
+}
+
+inline const Rect& Camera::GetViewport() const
+{
+    return viewport_;
+}
+
+}  // namespace kiwano
@@ -43,8 +43,28 @@ private:
         return "\03";
     }
 };
+
+uint32_t                                               next_debug_info_id = 0;
+Vector<std::pair<uint32_t, DebugActor::DebugInfoFunc>> debug_info_funcs;
 }  // namespace
 
+uint32_t DebugActor::AddDebugInfo(const DebugInfoFunc& func)
+{
+    const uint32_t id = ++next_debug_info_id;
+    debug_info_funcs.push_back(std::make_pair(id, func));
+    return id;
+}
+
+void DebugActor::RemoveDebugInfo(uint32_t id)
+{
+    auto iter = std::find_if(debug_info_funcs.begin(), debug_info_funcs.end(),
+                             [=](const std::pair<uint32_t, DebugInfoFunc>& pair) { return pair.first == id; });
+    if (iter != debug_info_funcs.end())
+    {
+        debug_info_funcs.erase(iter);
+    }
+}
+
 DebugActor::DebugActor()
     : frame_buffer_(70 /* pre-alloc for 70 frames */)
 {
@@ -122,6 +142,12 @@ void DebugActor::OnUpdate(Duration dt)
         ss << pmc.PrivateUsage / 1024 << "Kb";
     }
 
+    for (const auto& pair : debug_info_funcs)
+    {
+        ss << std::endl;
+        pair.second(ss);
+    }
+
     debug_text_.Reset(ss.str(), debug_text_style_);
 
     Size layout_size = debug_text_.GetSize();
@@ -128,10 +128,25 @@ private:
 class KGE_API DebugActor : public Actor
 {
 public:
+    /// \~chinese
+    /// @brief ϢıϢ
+    using DebugInfoFunc = Function<void(StringStream&)>;
+
     DebugActor();
 
     virtual ~DebugActor();
 
+    /// \~chinese
+    /// @brief ӵϢ
+    /// @details Խڵÿ֡еϢĬϢʾ
+    /// @return ϢID
+    static uint32_t AddDebugInfo(const DebugInfoFunc& func);
+
+    /// \~chinese
+    /// @brief ƳϢ
+    /// @param id ϢID
+    static void RemoveDebugInfo(uint32_t id);
+
     void OnRender(RenderContext& ctx) override;
 
     void OnUpdate(Duration dt) override;
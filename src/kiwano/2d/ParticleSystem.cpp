@@ -0,0 +1,360 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <fstream>
+#include <kiwano/2d/ParticleSystem.h>
+#include <kiwano/math/Random.h>
+#include <kiwano/render/RenderContext.h>
+#include <kiwano/utils/Json.h>
+#include <kiwano/utils/Logger.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define KGE_PARTICLE_USE_SSE
+#endif
+
+namespace kiwano
+{
+namespace
+{
+
+// v[i] += dv[i] * dt
+void Integrate(float* v, const float* dv, float dt, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef KGE_PARTICLE_USE_SSE
+    const __m128 dt4 = _mm_set1_ps(dt);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(v + i);
+        __m128 d = _mm_loadu_ps(dv + i);
+        _mm_storeu_ps(v + i, _mm_add_ps(x, _mm_mul_ps(d, dt4)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        v[i] += dv[i] * dt;
+    }
+}
+
+// v[i] += value
+void Accumulate(float* v, float value, uint32_t count)
+{
+    uint32_t i = 0;
+#ifdef KGE_PARTICLE_USE_SSE
+    const __m128 value4 = _mm_set1_ps(value);
+    for (; i + 4 <= count; i += 4)
+    {
+        _mm_storeu_ps(v + i, _mm_add_ps(_mm_loadu_ps(v + i), value4));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        v[i] += value;
+    }
+}
+
+inline float RandomVar(float value, float var)
+{
+    return var == 0.f ? value : value + var * math::Random(-1.f, 1.f);
+}
+
+template <typename _Ty>
+void ReadJsonValue(const Json& json, const char* key, _Ty& value)
+{
+    auto iter = json.find(key);
+    if (iter != json.end())
+    {
+        value = iter->get<_Ty>();
+    }
+}
+
+void ReadJsonValue(const Json& json, const char* key, Vec2& value)
+{
+    auto iter = json.find(key);
+    if (iter != json.end() && iter->is_array() && iter->size() == 2)
+    {
+        value = Vec2((*iter)[0].get<float>(), (*iter)[1].get<float>());
+    }
+}
+
+}  // namespace
+
+ParticleSystem::ParticleSystem()
+    : emitting_(true)
+    , count_(0)
+    , emit_counter_(0.f)
+    , elapsed_(0.f)
+{
+    ResizeBuffers(config_.max_particles);
+}
+
+ParticleSystem::ParticleSystem(RefPtr<Bitmap> bitmap, const ParticleEmitterConfig& config)
+    : ParticleSystem()
+{
+    SetBitmap(bitmap);
+    SetConfig(config);
+}
+
+ParticleSystem::~ParticleSystem() {}
+
+void ParticleSystem::SetBitmap(RefPtr<Bitmap> bitmap, const Rect& src_rect)
+{
+    bitmap_   = bitmap;
+    src_rect_ = src_rect;
+}
+
+void ParticleSystem::SetConfig(const ParticleEmitterConfig& config)
+{
+    config_ = config;
+    ResizeBuffers(config_.max_particles);
+}
+
+bool ParticleSystem::LoadConfig(StringView file_path)
+{
+    std::ifstream ifs(file_path);
+
+    if (ifs.is_open())
+    {
+        return LoadConfig(ifs);
+    }
+
+    Fail("ParticleSystem::LoadConfig failed");
+    return false;
+}
+
+bool ParticleSystem::LoadConfig(std::istream& istream)
+{
+    ParticleEmitterConfig config;
+    try
+    {
+        Json json = Json::parse(istream);
+
+        ReadJsonValue(json, "max_particles", config.max_particles);
+        ReadJsonValue(json, "emission_rate", config.emission_rate);
+        ReadJsonValue(json, "duration", config.duration);
+        ReadJsonValue(json, "life", config.life);
+        ReadJsonValue(json, "life_var", config.life_var);
+        ReadJsonValue(json, "position_var", config.position_var);
+        ReadJsonValue(json, "angle", config.angle);
+        ReadJsonValue(json, "angle_var", config.angle_var);
+        ReadJsonValue(json, "speed", config.speed);
+        ReadJsonValue(json, "speed_var", config.speed_var);
+        ReadJsonValue(json, "gravity", config.gravity);
+        ReadJsonValue(json, "start_scale", config.start_scale);
+        ReadJsonValue(json, "start_scale_var", config.start_scale_var);
+        ReadJsonValue(json, "end_scale", config.end_scale);
+        ReadJsonValue(json, "end_scale_var", config.end_scale_var);
+        ReadJsonValue(json, "start_rotation", config.start_rotation);
+        ReadJsonValue(json, "start_rotation_var", config.start_rotation_var);
+        ReadJsonValue(json, "end_rotation", config.end_rotation);
+        ReadJsonValue(json, "end_rotation_var", config.end_rotation_var);
+        ReadJsonValue(json, "start_opacity", config.start_opacity);
+        ReadJsonValue(json, "start_opacity_var", config.start_opacity_var);
+        ReadJsonValue(json, "end_opacity", config.end_opacity);
+        ReadJsonValue(json, "end_opacity_var", config.end_opacity_var);
+    }
+    catch (std::exception& e)
+    {
+        Fail(String("ParticleSystem::LoadConfig failed: ") + e.what());
+        return false;
+    }
+
+    SetConfig(config);
+    return true;
+}
+
+void ParticleSystem::Start()
+{
+    emitting_ = true;
+    elapsed_  = 0.f;
+}
+
+void ParticleSystem::Stop()
+{
+    emitting_     = false;
+    emit_counter_ = 0.f;
+}
+
+void ParticleSystem::Reset()
+{
+    count_        = 0;
+    emit_counter_ = 0.f;
+    elapsed_      = 0.f;
+}
+
+void ParticleSystem::Emit(uint32_t count)
+{
+    count = std::min(count, config_.max_particles - count_);
+
+    for (uint32_t n = 0; n < count; ++n)
+    {
+        const uint32_t i = count_++;
+
+        const float life  = std::max(RandomVar(config_.life, config_.life_var), 0.001f);
+        const float angle = RandomVar(config_.angle, config_.angle_var);
+        const float speed = RandomVar(config_.speed, config_.speed_var);
+
+        buffers_.life[i]  = life;
+        buffers_.pos_x[i] = RandomVar(0.f, config_.position_var.x);
+        buffers_.pos_y[i] = RandomVar(0.f, config_.position_var.y);
+        buffers_.vel_x[i] = math::Cos(angle) * speed;
+        buffers_.vel_y[i] = math::Sin(angle) * speed;
+
+        const float start_scale = std::max(RandomVar(config_.start_scale, config_.start_scale_var), 0.f);
+        const float end_scale   = std::max(RandomVar(config_.end_scale, config_.end_scale_var), 0.f);
+        buffers_.scale[i]       = start_scale;
+        buffers_.scale_delta[i] = (end_scale - start_scale) / life;
+
+        const float start_rotation = RandomVar(config_.start_rotation, config_.start_rotation_var);
+        const float end_rotation   = RandomVar(config_.end_rotation, config_.end_rotation_var);
+        buffers_.rotation[i]       = start_rotation;
+        buffers_.rotation_delta[i] = (end_rotation - start_rotation) / life;
+
+        const float start_opacity = RandomVar(config_.start_opacity, config_.start_opacity_var);
+        const float end_opacity   = RandomVar(config_.end_opacity, config_.end_opacity_var);
+        buffers_.opacity[i]       = start_opacity;
+        buffers_.opacity_delta[i] = (end_opacity - start_opacity) / life;
+    }
+}
+
+void ParticleSystem::Simulate(float dt)
+{
+    UpdateParticles(dt);
+
+    if (emitting_)
+    {
+        elapsed_ += dt;
+
+        if (config_.emission_rate > 0.f)
+        {
+            emit_counter_ += config_.emission_rate * dt;
+
+            const uint32_t count = static_cast<uint32_t>(emit_counter_);
+            emit_counter_ -= static_cast<float>(count);
+            Emit(count);
+        }
+
+        if (config_.duration >= 0.f && elapsed_ >= config_.duration)
+        {
+            Stop();
+        }
+    }
+}
+
+void ParticleSystem::OnUpdate(Duration dt)
+{
+    Simulate(dt.GetSeconds());
+}
+
+void ParticleSystem::OnRender(RenderContext& ctx)
+{
+    const Rect src_rect = src_rect_.IsEmpty() ? Rect(Point(), bitmap_->GetSize()) : src_rect_;
+    const Size half     = src_rect.GetSize() / 2;
+    const Rect dest_rect(-half.x, -half.y, half.x, half.y);
+
+    for (uint32_t i = 0; i < count_; ++i)
+    {
+        const float scale = buffers_.scale[i];
+
+        transforms_[i] = Matrix3x2::SRT(Point(buffers_.pos_x[i], buffers_.pos_y[i]), Vec2(scale, scale),
+                                        buffers_.rotation[i]);
+        opacities_[i]  = std::min(std::max(buffers_.opacity[i], 0.f), 1.f);
+    }
+
+    ctx.DrawBitmapBatch(*bitmap_, &src_rect, dest_rect, transforms_.data(), opacities_.data(), count_);
+}
+
+bool ParticleSystem::CheckVisibility(RenderContext& ctx) const
+{
+    KGE_NOT_USED(ctx);
+
+    // Particles may travel outside of the actor bounds, so the bounds are not checked here
+    return count_ > 0 && bitmap_ && bitmap_->IsValid();
+}
+
+void ParticleSystem::UpdateParticles(float dt)
+{
+    if (count_ == 0)
+        return;
+
+    Accumulate(buffers_.life.data(), -dt, count_);
+
+    // Remove dead particles by moving the last one into their slot
+    for (uint32_t i = count_; i > 0; --i)
+    {
+        if (buffers_.life[i - 1] <= 0.f)
+        {
+            RemoveParticle(i - 1);
+        }
+    }
+
+    if (config_.gravity.x != 0.f)
+        Accumulate(buffers_.vel_x.data(), config_.gravity.x * dt, count_);
+    if (config_.gravity.y != 0.f)
+        Accumulate(buffers_.vel_y.data(), config_.gravity.y * dt, count_);
+
+    Integrate(buffers_.pos_x.data(), buffers_.vel_x.data(), dt, count_);
+    Integrate(buffers_.pos_y.data(), buffers_.vel_y.data(), dt, count_);
+    Integrate(buffers_.scale.data(), buffers_.scale_delta.data(), dt, count_);
+    Integrate(buffers_.rotation.data(), buffers_.rotation_delta.data(), dt, count_);
+    Integrate(buffers_.opacity.data(), buffers_.opacity_delta.data(), dt, count_);
+}
+
+void ParticleSystem::RemoveParticle(uint32_t index)
+{
+    const uint32_t last = --count_;
+    if (index != last)
+    {
+        buffers_.pos_x[index]          = buffers_.pos_x[last];
+        buffers_.pos_y[index]          = buffers_.pos_y[last];
+        buffers_.vel_x[index]          = buffers_.vel_x[last];
+        buffers_.vel_y[index]          = buffers_.vel_y[last];
+        buffers_.life[index]           = buffers_.life[last];
+        buffers_.scale[index]          = buffers_.scale[last];
+        buffers_.scale_delta[index]    = buffers_.scale_delta[last];
+        buffers_.rotation[index]       = buffers_.rotation[last];
+        buffers_.rotation_delta[index] = buffers_.rotation_delta[last];
+        buffers_.opacity[index]        = buffers_.opacity[last];
+        buffers_.opacity_delta[index]  = buffers_.opacity_delta[last];
+    }
+}
+
+void ParticleSystem::ResizeBuffers(uint32_t capacity)
+{
+    buffers_.pos_x.resize(capacity);
+    buffers_.pos_y.resize(capacity);
+    buffers_.vel_x.resize(capacity);
+    buffers_.vel_y.resize(capacity);
+    buffers_.life.resize(capacity);
+    buffers_.scale.resize(capacity);
+    buffers_.scale_delta.resize(capacity);
+    buffers_.rotation.resize(capacity);
+    buffers_.rotation_delta.resize(capacity);
+    buffers_.opacity.resize(capacity);
+    buffers_.opacity_delta.resize(capacity);
+
+    transforms_.resize(capacity);
+    opacities_.resize(capacity);
+
+    count_ = std::min(count_, capacity);
+}
+
+}  // namespace kiwano
@@ -0,0 +1,211 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/2d/Actor.h>
+#include <kiwano/render/Bitmap.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief ӷ
+ * @details  _var ׺ĲʾΧӵʵֵ [value - var, value + var] ֮
+ */
+struct ParticleEmitterConfig
+{
+    uint32_t max_particles      = 500;           ///< 
+    float    emission_rate      = 100.f;         ///< ÿ뷢
+    float    duration           = -1.f;          ///< ʱ䣨룩С 0 ʱ
+    float    life               = 1.f;           ///< ڣ룩
+    float    life_var           = 0.f;           ///< Χ
+    Vec2     position_var       = { 0.f, 0.f };  ///< λΧ
+    float    angle              = -90.f;         ///< Ƕ
+    float    angle_var          = 0.f;           ///< ǶΧ
+    float    speed              = 100.f;         ///< ʼٶ
+    float    speed_var          = 0.f;           ///< ʼٶΧ
+    Vec2     gravity            = { 0.f, 0.f };  ///< ٶ
+    float    start_scale        = 1.f;           ///< ʼ
+    float    start_scale_var    = 0.f;           ///< ʼΧ
+    float    end_scale          = 1.f;           ///< ʱ
+    float    end_scale_var      = 0.f;           ///< ʱΧ
+    float    start_rotation     = 0.f;           ///< ʼתǶ
+    float    start_rotation_var = 0.f;           ///< ʼתǶΧ
+    float    end_rotation       = 0.f;           ///< ʱתǶ
+    float    end_rotation_var   = 0.f;           ///< ʱתǶΧ
+    float    start_opacity      = 1.f;           ///< ʼ͸
+    float    start_opacity_var  = 0.f;           ///< ʼ͸Χ
+    float    end_opacity        = 0.f;           ///< ʱ͸
+    float    end_opacity_var    = 0.f;           ///< ʱ͸Χ
+};
+
+/**
+ * \~chinese
+ * @brief ϵͳ
+ * @details
+ * ״̬Խṹ飨SoAʽ洢ÿ֡ʹ SIMD ָ£
+ * ӹһλͼͨ RenderContext::DrawBitmapBatch һύơ
+ * λϵͳľֲϵ
+ */
+class KGE_API ParticleSystem : public Actor
+{
+public:
+    ParticleSystem();
+
+    /// \~chinese
+    /// @brief ϵͳ
+    /// @param bitmap λͼ
+    /// @param config 
+    ParticleSystem(RefPtr<Bitmap> bitmap, const ParticleEmitterConfig& config);
+
+    virtual ~ParticleSystem();
+
+    /// \~chinese
+    /// @brief ȡλͼ
+    RefPtr<Bitmap> GetBitmap() const;
+
+    /// \~chinese
+    /// @brief λͼ
+    /// @param bitmap λͼ
+    /// @param src_rect ԴΣüΣ
+    void SetBitmap(RefPtr<Bitmap> bitmap, const Rect& src_rect = Rect());
+
+    /// \~chinese
+    /// @brief ȡ
+    const ParticleEmitterConfig& GetConfig() const;
+
+    /// \~chinese
+    /// @brief ÷
+    void SetConfig(const ParticleEmitterConfig& config);
+
+    /// \~chinese
+    /// @brief  JSON ļط
+    /// @param file_path ļ·
+    bool LoadConfig(StringView file_path);
+
+    /// \~chinese
+    /// @brief  JSON ط
+    /// @param istream 
+    bool LoadConfig(std::istream& istream);
+
+    /// \~chinese
+    /// @brief ʼ
+    void Start();
+
+    /// \~chinese
+    /// @brief ֹͣӣѴڵӼֱ
+    void Stop();
+
+    /// \~chinese
+    /// @brief Ӳ÷ʱ
+    void Reset();
+
+    /// \~chinese
+    /// @brief Ƿڷ
+    bool IsEmitting() const;
+
+    /// \~chinese
+    /// @brief ȡ
+    uint32_t GetParticleCount() const;
+
+    /// \~chinese
+    /// @brief 
+    /// @param count 
+    void Emit(uint32_t count);
+
+    /// \~chinese
+    /// @brief ģ
+    /// @details Ӳ´ӣȾ
+    /// @param dt ʱ룩
+    void Simulate(float dt);
+
+    void OnUpdate(Duration dt) override;
+
+    void OnRender(RenderContext& ctx) override;
+
+protected:
+    bool CheckVisibility(RenderContext& ctx) const override;
+
+private:
+    void UpdateParticles(float dt);
+
+    void RemoveParticle(uint32_t index);
+
+    void ResizeBuffers(uint32_t capacity);
+
+private:
+    /// \~chinese
+    /// @brief ״̬ÿԴ洢ڶ
+    struct Buffers
+    {
+        Vector<float> pos_x;
+        Vector<float> pos_y;
+        Vector<float> vel_x;
+        Vector<float> vel_y;
+        Vector<float> life;
+        Vector<float> scale;
+        Vector<float> scale_delta;
+        Vector<float> rotation;
+        Vector<float> rotation_delta;
+        Vector<float> opacity;
+        Vector<float> opacity_delta;
+    };
+
+    bool                  emitting_;
+    uint32_t              count_;
+    float                 emit_counter_;
+    float                 elapsed_;
+    ParticleEmitterConfig config_;
+    Buffers               buffers_;
+    RefPtr<Bitmap>        bitmap_;
+    Rect                  src_rect_;
+    Vector<Matrix3x2>     transforms_;
+    Vector<float>         opacities_;
+};
+
+/** @} */
+
+inline RefPtr<Bitmap> ParticleSystem::GetBitmap() const
+{
+    return bitmap_;
+}
+
+inline const ParticleEmitterConfig& ParticleSystem::GetConfig() const
+{
+    return config_;
+}
+
+inline bool ParticleSystem::IsEmitting() const
+{
+    return emitting_;
+}
+
+inline uint32_t ParticleSystem::GetParticleCount() const
+{
+    return count_;
+}
+
+}  // namespace kiwano
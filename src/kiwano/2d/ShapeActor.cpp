@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/2d/ShapeActor.h>
+#include <kiwano/2d/Stage.h>
 #include <kiwano/utils/Logger.h>
 #include <kiwano/render/Renderer.h>
 
@@ -66,7 +67,11 @@ bool ShapeActor::ContainsPoint(const Point& point) const
     if (!shape_)
         return false;
 
-    return shape_->ContainsPoint(point, &GetTransformMatrix());
+    Point stage_point = point;
+    if (GetStage() && !GetStage()->ConvertToStage(point, stage_point))
+        return false;
+
+    return shape_->ContainsPoint(stage_point, &GetTransformMatrix());
 }
 
 void ShapeActor::SetShape(RefPtr<Shape> shape)
@@ -45,6 +45,70 @@ void Stage::OnExit()
     KGE_DEBUG_LOGF("Stage exited");
 }
 
+void Stage::AddCamera(RefPtr<Camera> camera)
+{
+    KGE_ASSERT(camera && "Stage::AddCamera failed, NULL pointer exception");
+
+    if (camera)
+    {
+        cameras_.push_back(camera);
+    }
+}
+
+void Stage::RemoveCamera(RefPtr<Camera> camera)
+{
+    auto iter = std::find(cameras_.begin(), cameras_.end(), camera);
+    if (iter != cameras_.end())
+    {
+        cameras_.erase(iter);
+    }
+}
+
+void Stage::RemoveAllCameras()
+{
+    cameras_.clear();
+}
+
+bool Stage::ConvertToStage(const Point& point, Point& stage_point) const
+{
+    if (cameras_.empty())
+    {
+        stage_point = point;
+        return true;
+    }
+
+    // ȾȾ֮
+    for (auto iter = cameras_.rbegin(); iter != cameras_.rend(); ++iter)
+    {
+        const auto& camera = *iter;
+        if (camera->IsEnabled() && camera->IsInViewport(point))
+        {
+            stage_point = camera->ConvertToStage(point);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Stage::Render(RenderContext& ctx)
+{
+    if (cameras_.empty())
+    {
+        Actor::Render(ctx);
+        return;
+    }
+
+    for (auto& camera : cameras_)
+    {
+        if (camera->IsEnabled())
+        {
+            camera->BeginRender(ctx);
+            Actor::Render(ctx);
+            camera->EndRender(ctx);
+        }
+    }
+}
+
 void Stage::RenderBorder(RenderContext& ctx)
 {
     ctx.SetBrushOpacity(GetDisplayedOpacity());
@@ -61,7 +125,21 @@ void Stage::RenderBorder(RenderContext& ctx)
         border_stroke_brush_->SetColor(Color(Color::Red, .8f));
     }
 
-    Actor::RenderBorder(ctx);
+    if (cameras_.empty())
+    {
+        Actor::RenderBorder(ctx);
+        return;
+    }
+
+    for (auto& camera : cameras_)
+    {
+        if (camera->IsEnabled())
+        {
+            camera->BeginRender(ctx);
+            Actor::RenderBorder(ctx);
+            camera->EndRender(ctx);
+        }
+    }
 }
 
 }  // namespace kiwano
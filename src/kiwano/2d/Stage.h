@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/2d/Actor.h>
+#include <kiwano/2d/Camera.h>
 #include <kiwano/render/Brush.h>
 
 namespace kiwano
@@ -72,18 +73,51 @@ public:
     /// @brief ýɫ߽ˢ
     void SetBorderStrokeBrush(RefPtr<Brush> brush);
 
+    /// \~chinese
+    /// @brief 
+    /// @details ̨ûʱֱȾȾ򣬷ͨÿõȾ
+    void AddCamera(RefPtr<Camera> camera);
+
+    /// \~chinese
+    /// @brief Ƴ
+    void RemoveCamera(RefPtr<Camera> camera);
+
+    /// \~chinese
+    /// @brief Ƴ
+    void RemoveAllCameras();
+
+    /// \~chinese
+    /// @brief ȡ
+    const Vector<RefPtr<Camera>>& GetCameras() const;
+
+    /// \~chinese
+    /// @brief ȾתΪ̨
+    /// @details ̨ʱʹӿڰõġȾת
+    /// @param point Ⱦ꣬λ
+    /// @param[out] stage_point ̨
+    /// @return 㲻κõӿʱ false
+    bool ConvertToStage(const Point& point, Point& stage_point) const;
+
+    void Render(RenderContext& ctx) override;
+
 protected:
     /// \~chinese
     /// @brief ӽɫı߽
     void RenderBorder(RenderContext& ctx) override;
 
 private:
-    RefPtr<Brush> border_fill_brush_;
-    RefPtr<Brush> border_stroke_brush_;
+    RefPtr<Brush>          border_fill_brush_;
+    RefPtr<Brush>          border_stroke_brush_;
+    Vector<RefPtr<Camera>> cameras_;
 };
 
 /** @} */
 
+inline const Vector<RefPtr<Camera>>& Stage::GetCameras() const
+{
+    return cameras_;
+}
+
 inline RefPtr<Brush> Stage::GetBorderFillBrush() const
 {
     return border_fill_brush_;
@@ -0,0 +1,373 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/2d/TileMap.h>
+#include <kiwano/render/Renderer.h>
+#include <kiwano/utils/Xml.h>
+#include <fstream>  // std::ifstream
+#include <sstream>  // std::istringstream
+
+namespace kiwano
+{
+
+namespace
+{
+
+// 黺֡ɼͷ
+const uint32_t kChunkCacheMaxIdleFrames = 120;
+
+// TMX  gid ĸλΪת
+const uint32_t kTmxGidMask = 0x1FFFFFFF;
+
+}  // namespace
+
+TileMap::TileMap()
+    : chunk_caching_(true)
+    , cols_(0)
+    , rows_(0)
+    , chunk_size_(16)
+    , chunk_cols_(0)
+    , chunk_rows_(0)
+    , render_frame_(0)
+{
+}
+
+TileMap::TileMap(const Size& tile_size, uint32_t cols, uint32_t rows)
+    : TileMap()
+{
+    Reset(tile_size, cols, rows);
+}
+
+TileMap::~TileMap() {}
+
+bool TileMap::Load(StringView file_path)
+{
+    std::ifstream ifs(file_path);
+
+    if (ifs.is_open())
+    {
+        return Load(ifs);
+    }
+
+    Fail("TileMap::Load failed");
+    return false;
+}
+
+bool TileMap::Load(std::istream& istream)
+{
+    XmlDocument doc;
+    if (!doc.load(istream))
+    {
+        Fail("TileMap::Load failed: invalid xml");
+        return false;
+    }
+
+    XmlNode map = doc.child("map");
+    if (!map)
+    {
+        Fail("TileMap::Load failed: <map> node not found");
+        return false;
+    }
+
+    uint32_t cols   = map.attribute("width").as_uint();
+    uint32_t rows   = map.attribute("height").as_uint();
+    float    tile_w = map.attribute("tilewidth").as_float();
+    float    tile_h = map.attribute("tileheight").as_float();
+
+    uint32_t first_gid = 1;
+    if (XmlNode tileset = map.child("tileset"))
+    {
+        first_gid = tileset.attribute("firstgid").as_uint(1);
+    }
+
+    XmlNode data = map.child("layer").child("data");
+    if (!data || String(data.attribute("encoding").as_string()) != "csv")
+    {
+        Fail("TileMap::Load failed: only csv encoded layer data is supported");
+        return false;
+    }
+
+    Reset(Size(tile_w, tile_h), cols, rows);
+
+    std::istringstream iss(data.child_value());
+
+    uint32_t index = 0;
+    for (String value; std::getline(iss, value, ',') && index < cols * rows; ++index)
+    {
+        uint32_t gid = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10)) & kTmxGidMask;
+        if (gid >= first_gid)
+        {
+            SetTile(index % cols, index / cols, static_cast<int>(gid - first_gid));
+        }
+    }
+    return true;
+}
+
+void TileMap::Reset(const Size& tile_size, uint32_t cols, uint32_t rows)
+{
+    ReleaseChunkCaches();
+
+    tile_size_  = tile_size;
+    cols_       = cols;
+    rows_       = rows;
+    chunk_cols_ = (cols + chunk_size_ - 1) / chunk_size_;
+    chunk_rows_ = (rows + chunk_size_ - 1) / chunk_size_;
+
+    chunks_.clear();
+    chunks_.resize(chunk_cols_ * chunk_rows_);
+    pending_chunks_.clear();
+
+    SetSize(Size(tile_size.x * cols, tile_size.y * rows));
+}
+
+void TileMap::SetTileSet(const Vector<SpriteFrame>& frames)
+{
+    tile_set_ = frames;
+
+    for (auto& chunk : chunks_)
+    {
+        chunk.dirty = true;
+    }
+}
+
+int TileMap::GetTile(uint32_t col, uint32_t row) const
+{
+    const Chunk* chunk = GetChunk(col, row);
+    if (!chunk || chunk->tiles.empty())
+        return -1;
+    return chunk->tiles[(row % chunk_size_) * chunk_size_ + (col % chunk_size_)];
+}
+
+void TileMap::SetTile(uint32_t col, uint32_t row, int tile)
+{
+    Chunk* chunk = GetChunk(col, row);
+    if (!chunk)
+        return;
+
+    if (chunk->tiles.empty())
+    {
+        if (tile < 0)
+            return;
+        chunk->tiles.resize(chunk_size_ * chunk_size_, -1);
+    }
+
+    int& slot = chunk->tiles[(row % chunk_size_) * chunk_size_ + (col % chunk_size_)];
+    if (slot == tile)
+        return;
+
+    if (slot < 0)
+        ++chunk->tile_count;
+    else if (tile < 0)
+        --chunk->tile_count;
+
+    slot         = tile;
+    chunk->dirty = true;
+}
+
+void TileMap::SetChunkSize(uint32_t chunk_size)
+{
+    if (chunk_size == 0 || chunk_size == chunk_size_)
+        return;
+
+    chunk_size_ = chunk_size;
+    Reset(tile_size_, cols_, rows_);
+}
+
+void TileMap::SetChunkCachingEnabled(bool enabled)
+{
+    chunk_caching_ = enabled;
+    if (!enabled)
+    {
+        ReleaseChunkCaches();
+    }
+}
+
+void TileMap::OnUpdate(Duration dt)
+{
+    KGE_NOT_USED(dt);
+
+    for (auto index : pending_chunks_)
+    {
+        BuildChunkCache(index);
+    }
+    pending_chunks_.clear();
+
+    // ͷųʱ䲻ɼ黺
+    for (size_t i = 0; i < cached_chunks_.size();)
+    {
+        Chunk& chunk = chunks_[cached_chunks_[i]];
+        if (render_frame_ - chunk.last_visible_frame > kChunkCacheMaxIdleFrames)
+        {
+            chunk.cache.Reset();
+            cached_chunks_[i] = cached_chunks_.back();
+            cached_chunks_.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void TileMap::OnRender(RenderContext& ctx)
+{
+    ++render_frame_;
+
+    if (chunks_.empty() || tile_set_.empty())
+        return;
+
+    // ɼתͼϵ£ֻཻ֮
+    Rect view = ctx.GetVisibleRect();
+    if (ctx.HasViewTransform())
+    {
+        const Matrix3x2 to_view = GetTransformMatrix() * ctx.GetViewTransform();
+        if (!to_view.IsInvertible())
+            return;
+        view = to_view.Invert().Transform(view);
+    }
+    else
+    {
+        view = GetTransformInverseMatrix().Transform(view);
+    }
+
+    const float chunk_w = tile_size_.x * chunk_size_;
+    const float chunk_h = tile_size_.y * chunk_size_;
+    if (chunk_w <= 0 || chunk_h <= 0)
+        return;
+
+    int begin_x = std::max(static_cast<int>(std::floor(view.GetLeft() / chunk_w)), 0);
+    int begin_y = std::max(static_cast<int>(std::floor(view.GetTop() / chunk_h)), 0);
+    int end_x   = std::min(static_cast<int>(std::ceil(view.GetRight() / chunk_w)), static_cast<int>(chunk_cols_));
+    int end_y   = std::min(static_cast<int>(std::ceil(view.GetBottom() / chunk_h)), static_cast<int>(chunk_rows_));
+
+    for (int y = begin_y; y < end_y; ++y)
+    {
+        for (int x = begin_x; x < end_x; ++x)
+        {
+            uint32_t index = y * chunk_cols_ + x;
+            Chunk&   chunk = chunks_[index];
+            if (chunk.tile_count == 0)
+                continue;
+
+            chunk.last_visible_frame = render_frame_;
+
+            if (chunk.cache && !chunk.dirty)
+            {
+                Rect dest_rect = GetChunkRect(x, y);
+                ctx.DrawBitmap(*chunk.cache, nullptr, &dest_rect);
+                continue;
+            }
+
+            // δɻʧЧֱӻƬ´θʱɻ
+            DrawChunk(ctx, x, y, Point());
+
+            if (chunk_caching_ && !chunk.pending)
+            {
+                chunk.pending = true;
+                pending_chunks_.push_back(index);
+            }
+        }
+    }
+}
+
+TileMap::Chunk* TileMap::GetChunk(uint32_t col, uint32_t row)
+{
+    if (col >= cols_ || row >= rows_)
+        return nullptr;
+    return &chunks_[(row / chunk_size_) * chunk_cols_ + (col / chunk_size_)];
+}
+
+const TileMap::Chunk* TileMap::GetChunk(uint32_t col, uint32_t row) const
+{
+    if (col >= cols_ || row >= rows_)
+        return nullptr;
+    return &chunks_[(row / chunk_size_) * chunk_cols_ + (col / chunk_size_)];
+}
+
+Rect TileMap::GetChunkRect(uint32_t chunk_col, uint32_t chunk_row) const
+{
+    const Size chunk_size = tile_size_ * float(chunk_size_);
+    return Rect(Point(chunk_size.x * chunk_col, chunk_size.y * chunk_row), chunk_size);
+}
+
+void TileMap::DrawChunk(RenderContext& ctx, uint32_t chunk_col, uint32_t chunk_row, const Point& offset) const
+{
+    const Chunk& chunk  = chunks_[chunk_row * chunk_cols_ + chunk_col];
+    const Point  origin = GetChunkRect(chunk_col, chunk_row).GetLeftTop() - offset;
+
+    for (uint32_t y = 0; y < chunk_size_; ++y)
+    {
+        for (uint32_t x = 0; x < chunk_size_; ++x)
+        {
+            int tile = chunk.tiles[y * chunk_size_ + x];
+            if (tile < 0 || tile >= static_cast<int>(tile_set_.size()))
+                continue;
+
+            const SpriteFrame& frame = tile_set_[tile];
+            if (!frame.bitmap)
+                continue;
+
+            Rect dest_rect(origin + Point(tile_size_.x * x, tile_size_.y * y), tile_size_);
+            ctx.DrawBitmap(*frame.bitmap, frame.src_rect.IsEmpty() ? nullptr : &frame.src_rect, &dest_rect);
+        }
+    }
+}
+
+void TileMap::BuildChunkCache(uint32_t index)
+{
+    Chunk& chunk  = chunks_[index];
+    chunk.pending = false;
+
+    if (!chunk_caching_ || chunk.tile_count == 0)
+        return;
+
+    uint32_t chunk_col = index % chunk_cols_;
+    uint32_t chunk_row = index / chunk_cols_;
+    Rect     rect      = GetChunkRect(chunk_col, chunk_row);
+
+    // λͼǸþɵȾģÿ鶼һȾ
+    RefPtr<Bitmap>        bitmap = MakePtr<Bitmap>();
+    RefPtr<RenderContext> ctx    = Renderer::GetInstance().CreateContextForBitmap(bitmap, rect.GetSize());
+    if (!ctx)
+        return;
+
+    ctx->BeginDraw();
+    ctx->Clear();
+    DrawChunk(*ctx, chunk_col, chunk_row, rect.GetLeftTop());
+    ctx->EndDraw();
+
+    if (!chunk.cache)
+    {
+        cached_chunks_.push_back(index);
+    }
+    chunk.cache = bitmap;
+    chunk.dirty = false;
+}
+
+void TileMap::ReleaseChunkCaches()
+{
+    for (auto index : cached_chunks_)
+    {
+        chunks_[index].cache.Reset();
+    }
+    cached_chunks_.clear();
+}
+
+}  // namespace kiwano
@@ -0,0 +1,207 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <kiwano/2d/Actor.h>
+#include <kiwano/2d/animation/FrameAnimation.h>
+
+namespace kiwano
+{
+
+/**
+ * \addtogroup Actors
+ * @{
+ */
+
+/**
+ * \~chinese
+ * @brief Ƭͼ
+ * @details
+ * ͼ̶С洢ƬƬӦͼ鼯еľ֡-1 ʾƬ
+ * Ⱦʱӿཻ飬ÿɼᱻΪλͼеƬ仯ʱɻ棬
+ * ʱ䲻ɼ黺ᱻͷ
+ */
+class KGE_API TileMap : public Actor
+{
+public:
+    TileMap();
+
+    /// \~chinese
+    /// @brief Ƭͼ
+    /// @param tile_size ƬС
+    /// @param cols ͼ
+    /// @param rows ͼ
+    TileMap(const Size& tile_size, uint32_t cols, uint32_t rows);
+
+    virtual ~TileMap();
+
+    /// \~chinese
+    /// @brief  TMX ļصͼ
+    /// @details ȡһͼ CSV Ƭݣͼ鼯Ҫͨ SetTileSet 
+    /// @param file_path ļ·
+    bool Load(StringView file_path);
+
+    /// \~chinese
+    /// @brief  TMX صͼ
+    /// @param istream 
+    bool Load(std::istream& istream);
+
+    /// \~chinese
+    /// @brief õͼСƬ
+    /// @param tile_size ƬС
+    /// @param cols ͼ
+    /// @param rows ͼ
+    void Reset(const Size& tile_size, uint32_t cols, uint32_t rows);
+
+    /// \~chinese
+    /// @brief ȡƬС
+    Size GetTileSize() const;
+
+    /// \~chinese
+    /// @brief ȡͼ
+    uint32_t GetColumns() const;
+
+    /// \~chinese
+    /// @brief ȡͼ
+    uint32_t GetRows() const;
+
+    /// \~chinese
+    /// @brief ȡͼ鼯
+    const Vector<SpriteFrame>& GetTileSet() const;
+
+    /// \~chinese
+    /// @brief ͼ鼯
+    /// @param frames ֡ϣƬ֡ڼеλ
+    void SetTileSet(const Vector<SpriteFrame>& frames);
+
+    /// \~chinese
+    /// @brief ȡƬ
+    /// @param col 
+    /// @param row 
+    int GetTile(uint32_t col, uint32_t row) const;
+
+    /// \~chinese
+    /// @brief Ƭ
+    /// @param col 
+    /// @param row 
+    /// @param tile Ƭ-1 ʾƬ
+    void SetTile(uint32_t col, uint32_t row, int tile);
+
+    /// \~chinese
+    /// @brief ȡСƬ
+    uint32_t GetChunkSize() const;
+
+    /// \~chinese
+    /// @brief СƬĬΪ 16
+    /// @details ޸СƬ
+    void SetChunkSize(uint32_t chunk_size);
+
+    /// \~chinese
+    /// @brief Ƿ黺
+    bool IsChunkCachingEnabled() const;
+
+    /// \~chinese
+    /// @brief Ƿ黺棬Ĭ
+    void SetChunkCachingEnabled(bool enabled);
+
+    /// \~chinese
+    /// @brief ȡѻ
+    uint32_t GetCachedChunkCount() const;
+
+    void OnUpdate(Duration dt) override;
+
+    void OnRender(RenderContext& ctx) override;
+
+private:
+    struct Chunk
+    {
+        uint32_t       tile_count         = 0;
+        bool           dirty              = false;
+        bool           pending            = false;
+        uint32_t       last_visible_frame = 0;
+        Vector<int>    tiles;
+        RefPtr<Bitmap> cache;
+    };
+
+    Chunk* GetChunk(uint32_t col, uint32_t row);
+
+    const Chunk* GetChunk(uint32_t col, uint32_t row) const;
+
+    Rect GetChunkRect(uint32_t chunk_col, uint32_t chunk_row) const;
+
+    void DrawChunk(RenderContext& ctx, uint32_t chunk_col, uint32_t chunk_row, const Point& offset) const;
+
+    void BuildChunkCache(uint32_t index);
+
+    void ReleaseChunkCaches();
+
+private:
+    bool                chunk_caching_;
+    Size                tile_size_;
+    uint32_t            cols_;
+    uint32_t            rows_;
+    uint32_t            chunk_size_;
+    uint32_t            chunk_cols_;
+    uint32_t            chunk_rows_;
+    uint32_t            render_frame_;
+    Vector<Chunk>       chunks_;
+    Vector<uint32_t>    pending_chunks_;
+    Vector<uint32_t>    cached_chunks_;
+    Vector<SpriteFrame> tile_set_;
+};
+
+/** @} */
+
+inline Size TileMap::GetTileSize() const
+{
+    return tile_size_;
+}
+
+inline uint32_t TileMap::GetColumns() const
+{
+    return cols_;
+}
+
+inline uint32_t TileMap::GetRows() const
+{
+    return rows_;
+}
+
+inline const Vector<SpriteFrame>& TileMap::GetTileSet() const
+{
+    return tile_set_;
+}
+
+inline uint32_t TileMap::GetChunkSize() const
+{
+    return chunk_size_;
+}
+
+inline bool TileMap::IsChunkCachingEnabled() const
+{
+    return chunk_caching_;
+}
+
+inline uint32_t TileMap::GetCachedChunkCount() const
+{
+    return static_cast<uint32_t>(cached_chunks_.size());
+}
+
+}  // namespace kiwano
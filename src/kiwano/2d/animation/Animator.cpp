@@ -87,6 +87,11 @@ void Animator::StopAllAnimations()
     }
 }
 
+void Animator::RemoveAllAnimations()
+{
+    animations_.Clear();
+}
+
 Animation* Animator::GetAnimation(StringView name)
 {
     if (animations_.IsEmpty())
@@ -59,6 +59,10 @@ public:
     /// @brief ֹͣж
     void StopAllAnimations();
 
+    /// \~chinese
+    /// @brief Ƴж
+    void RemoveAllAnimations();
+
     /// \~chinese
     /// @brief ȡָƵĶ
     /// @param name 
@@ -22,6 +22,7 @@
 #include <kiwano/2d/DebugActor.h>
 #include <kiwano/2d/Stage.h>
 #include <kiwano/base/Director.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -130,6 +131,8 @@ void Director::PushEventDispatcher(EventDispatcher* dispatcher)
 
 void Director::OnUpdate(UpdateModuleContext& ctx)
 {
+    KGE_PROFILE_SCOPE("Director::OnUpdate");
+
     dispatcher_list_.Clear();
 
     if (transition_)
@@ -165,6 +168,8 @@ void Director::OnUpdate(UpdateModuleContext& ctx)
 
 void Director::OnRender(RenderModuleContext& ctx)
 {
+    KGE_PROFILE_SCOPE("Director::OnRender");
+
     if (transition_)
     {
         transition_->Render(ctx.render_ctx);
@@ -187,6 +192,8 @@ void Director::OnRender(RenderModuleContext& ctx)
 
 void Director::HandleEvent(EventModuleContext& ctx)
 {
+    KGE_PROFILE_SCOPE("Director::HandleEvent");
+
     for (auto dispatcher : dispatcher_list_)
     {
         dispatcher->DispatchEvent(ctx.evt);
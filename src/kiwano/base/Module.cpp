@@ -20,12 +20,41 @@
 
 #include <kiwano/base/Module.h>
 #include <kiwano/render/RenderContext.h>
+#include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
+#include <typeinfo>
 
 namespace kiwano
 {
 
-ModuleContext::ModuleContext(ModuleList& modules)
-    : index_(-1)
+namespace
+{
+
+const char* GetStageName(ModuleStage stage)
+{
+    switch (stage)
+    {
+    case ModuleStage::Update:
+        return "Update";
+    case ModuleStage::BeforeRender:
+        return "BeforeRender";
+    case ModuleStage::Render:
+        return "Render";
+    case ModuleStage::AfterRender:
+        return "AfterRender";
+    case ModuleStage::Event:
+        return "Event";
+    default:
+        return "Unknown";
+    }
+}
+
+}  // namespace
+
+ModuleContext::ModuleContext(ModuleList& modules, ModuleStage stage)
+    : stage_(stage)
+    , index_(-1)
+    , nested_time_(0)
     , modules_(modules)
 {
 }
@@ -42,42 +71,59 @@ void ModuleContext::Next()
     index_++;
     for (; index_ < (int)modules_.size(); index_++)
     {
-        this->Handle(modules_.at(index_));
+        Module* m = modules_.at(index_);
+
+        // ģڻصе Next ģ飬ⲿֺʱҪӸģĺʱп۳
+        const int64_t outer_nested = nested_time_;
+        nested_time_               = 0;
+
+        const int64_t start = Profiler::GetTimestamp();
+        this->Handle(m);
+        const int64_t elapsed = Profiler::GetTimestamp() - start;
+
+        m->RecordTiming(stage_, float(elapsed - nested_time_) / 1000000.0f);
+        nested_time_ = outer_nested + elapsed;
     }
 }
 
 RenderModuleContext::RenderModuleContext(ModuleList& modules, RenderContext& ctx)
-    : ModuleContext(modules)
-    , step_(Step::Before)
+    : ModuleContext(modules, ModuleStage::BeforeRender)
     , render_ctx(ctx)
 {
-    this->Next();
-    this->ResetIndex();
+    {
+        KGE_PROFILE_SCOPE("Module::BeforeRender");
+        this->Next();
+        this->ResetIndex();
+    }
 
     render_ctx.BeginDraw();
-    step_ = Step::Rendering;
+    stage_ = ModuleStage::Render;
 }
 
 RenderModuleContext::~RenderModuleContext()
 {
     render_ctx.EndDraw();
-    step_ = Step::After;
+    stage_ = ModuleStage::AfterRender;
 
+    KGE_PROFILE_SCOPE("Module::AfterRender");
     this->ResetIndex();
     this->Next();
 }
 
 void RenderModuleContext::Handle(Module* m)
 {
-    switch (step_)
+    // ģĺʱģǶȾ׶
+    KGE_PROFILE_SCOPE(typeid(*m).name());
+
+    switch (stage_)
     {
-    case RenderModuleContext::Step::Before:
+    case ModuleStage::BeforeRender:
         m->BeforeRender(*this);
         break;
-    case RenderModuleContext::Step::Rendering:
+    case ModuleStage::Render:
         m->OnRender(*this);
         break;
-    case RenderModuleContext::Step::After:
+    case ModuleStage::AfterRender:
         m->AfterRender(*this);
         break;
     default:
@@ -86,28 +132,34 @@ void RenderModuleContext::Handle(Module* m)
 }
 
 UpdateModuleContext::UpdateModuleContext(ModuleList& modules, Duration dt)
-    : ModuleContext(modules)
+    : ModuleContext(modules, ModuleStage::Update)
     , dt(dt)
 {
 }
 
 void UpdateModuleContext::Handle(Module* m)
 {
+    KGE_PROFILE_SCOPE(typeid(*m).name());
     m->OnUpdate(*this);
 }
 
 EventModuleContext::EventModuleContext(ModuleList& modules, Event* evt)
-    : ModuleContext(modules)
+    : ModuleContext(modules, ModuleStage::Event)
     , evt(evt)
 {
 }
 
 void EventModuleContext::Handle(Module* m)
 {
+    KGE_PROFILE_SCOPE(typeid(*m).name());
     m->HandleEvent(*this);
 }
 
-Module::Module() {}
+Module::Module()
+    : budgets_{}
+    , over_budget_{}
+{
+}
 
 void Module::SetupModule() {}
 
@@ -123,4 +175,53 @@ void Module::BeforeRender(RenderModuleContext& ctx) {}
 
 void Module::AfterRender(RenderModuleContext& ctx) {}
 
+void Module::ResetTimings()
+{
+    for (auto& timing : timings_)
+    {
+        timing = ModuleTiming();
+    }
+}
+
+void Module::SetBudget(ModuleStage stage, float ms)
+{
+    budgets_[int(stage)]     = std::max(ms, 0.0f);
+    over_budget_[int(stage)] = false;
+}
+
+void Module::SetBudgetCallback(const BudgetCallback& callback)
+{
+    budget_callback_ = callback;
+}
+
+void Module::RecordTiming(ModuleStage stage, float ms)
+{
+    const int index = int(stage);
+
+    ModuleTiming& timing = timings_[index];
+    timing.Record(ms);
+
+    const float budget = budgets_[index];
+    if (budget <= 0.0f)
+        return;
+
+    if (ms <= budget)
+    {
+        over_budget_[index] = false;
+        return;
+    }
+
+    ++timing.exceeded;
+    if (budget_callback_)
+    {
+        budget_callback_(this, stage, ms, budget);
+    }
+    else if (!over_budget_[index])
+    {
+        KGE_WARNF("Module %s exceeded its %s budget: %.3fms (budget %.3fms)", typeid(*this).name(),
+                  GetStageName(stage), ms, budget);
+    }
+    over_budget_[index] = true;
+}
+
 }  // namespace kiwano
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <kiwano/core/Time.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -31,6 +32,27 @@ class Module;
 /// @brief ģб
 typedef Vector<Module*> ModuleList;
 
+/// \~chinese
+/// @brief ģ鴦׶
+enum class ModuleStage
+{
+    Update,        ///< 
+    BeforeRender,  ///< Ⱦǰ
+    Render,        ///< Ⱦʱ
+    AfterRender,   ///< Ⱦ
+    Event,         ///< ¼
+
+    Last
+};
+
+/// \~chinese
+/// @brief ģʱͳƣλ룩
+/// @details ͳƵģĺʱڻصе ModuleContext::Next ʱģĺʱ
+struct KGE_API ModuleTiming : public ProfileTiming
+{
+    uint32_t exceeded = 0;  ///< ԤĴ
+};
+
 /// \~chinese
 /// @brief ģ
 class KGE_API ModuleContext
@@ -39,7 +61,7 @@ public:
     void Next();
 
 protected:
-    ModuleContext(ModuleList& modules);
+    ModuleContext(ModuleList& modules, ModuleStage stage);
 
     virtual ~ModuleContext();
 
@@ -47,8 +69,12 @@ protected:
 
     void ResetIndex();
 
+protected:
+    ModuleStage stage_;
+
 private:
     int         index_;
+    int64_t     nested_time_;
     ModuleList& modules_;
 };
 
@@ -65,16 +91,6 @@ public:
 
 protected:
     void Handle(Module* m) override;
-
-private:
-    enum class Step
-    {
-        Before,
-        Rendering,
-        After,
-    };
-
-    Step step_;
 };
 
 /// \~chinese
@@ -143,8 +159,58 @@ public:
     /// @param ctx Ⱦ
     virtual void AfterRender(RenderModuleContext& ctx);
 
+    /// \~chinese
+    /// @brief Ԥص
+    /// @details Ϊģ顢׶ΡκʱԤ㣨λ룩
+    using BudgetCallback = Function<void(Module*, ModuleStage, float, float)>;
+
+    /// \~chinese
+    /// @brief ȡģĳһ׶εĺʱͳ
+    /// @note ¼׶ΰ¼ַͳ
+    const ModuleTiming& GetTiming(ModuleStage stage) const;
+
+    /// \~chinese
+    /// @brief պʱͳ
+    void ResetTimings();
+
+    /// \~chinese
+    /// @brief ģĳһ׶εĺʱԤ
+    /// @param stage ׶
+    /// @param ms Ԥ㣨λ룩Ϊ 0 ʱ
+    void SetBudget(ModuleStage stage, float ms);
+
+    /// \~chinese
+    /// @brief ȡģĳһ׶εĺʱԤ
+    float GetBudget(ModuleStage stage) const;
+
+    /// \~chinese
+    /// @brief óԤص
+    /// @details ûصÿγԤ㶼ûصڿʼԤʱһ־
+    void SetBudgetCallback(const BudgetCallback& callback);
+
 protected:
     Module();
+
+private:
+    friend class ModuleContext;
+
+    void RecordTiming(ModuleStage stage, float ms);
+
+private:
+    ModuleTiming   timings_[int(ModuleStage::Last)];
+    float          budgets_[int(ModuleStage::Last)];
+    bool           over_budget_[int(ModuleStage::Last)];
+    BudgetCallback budget_callback_;
 };
 
+inline const ModuleTiming& Module::GetTiming(ModuleStage stage) const
+{
+    return timings_[int(stage)];
+}
+
+inline float Module::GetBudget(ModuleStage stage) const
+{
+    return budgets_[int(stage)];
+}
+
 }  // namespace kiwano
@@ -26,9 +26,19 @@ namespace kiwano
 
 ComponentManager::ComponentManager(Actor* target)
     : target_(target)
+    , components_(nullptr)
 {
 }
 
+ComponentManager::~ComponentManager()
+{
+    if (components_)
+    {
+        delete components_;
+        components_ = nullptr;
+    }
+}
+
 Component* ComponentManager::AddComponent(RefPtr<Component> component)
 {
     KGE_ASSERT(component && "AddComponent failed, NULL pointer exception");
@@ -49,7 +59,7 @@ Component* ComponentManager::AddComponent(size_t index, RefPtr<Component> compon
     {
         component->InitComponent(target_);
 
-        components_[index] = component;
+        GetAllComponents()[index] = component;
     }
     return component.Get();
 }
@@ -62,10 +72,10 @@ Component* ComponentManager::GetComponent(StringView name)
 
 Component* ComponentManager::GetComponent(size_t name_hash)
 {
-    if (!components_.empty())
+    if (components_ && !components_->empty())
     {
-        auto iter = components_.find(name_hash);
-        if (iter != components_.end())
+        auto iter = components_->find(name_hash);
+        if (iter != components_->end())
         {
             return iter->second.Get();
         }
@@ -75,12 +85,21 @@ Component* ComponentManager::GetComponent(size_t name_hash)
 
 ComponentMap& ComponentManager::GetAllComponents()
 {
-    return components_;
+    if (!components_)
+    {
+        components_ = new ComponentMap;
+    }
+    return *components_;
 }
 
 const ComponentMap& ComponentManager::GetAllComponents() const
 {
-    return components_;
+    if (!components_)
+    {
+        static const ComponentMap empty_components;
+        return empty_components;
+    }
+    return *components_;
 }
 
 void ComponentManager::RemoveComponent(RefPtr<Component> component)
@@ -96,35 +115,38 @@ void ComponentManager::RemoveComponent(StringView name)
 
 void ComponentManager::RemoveComponent(size_t name_hash)
 {
-    if (!components_.empty())
+    if (components_ && !components_->empty())
     {
-        auto iter = components_.find(name_hash);
-        if (iter != components_.end())
+        auto iter = components_->find(name_hash);
+        if (iter != components_->end())
         {
             iter->second->DestroyComponent();
-            components_.erase(iter);
+            components_->erase(iter);
         }
     }
 }
 
 void ComponentManager::RemoveAllComponents()
 {
+    if (!components_)
+        return;
+
     // Destroy all components
-    if (!components_.empty())
+    if (!components_->empty())
     {
-        for (auto& p : components_)
+        for (auto& p : *components_)
         {
             p.second->DestroyComponent();
         }
     }
-    components_.clear();
+    components_->clear();
 }
 
 void ComponentManager::Update(Duration dt)
 {
-    if (!components_.empty())
+    if (components_ && !components_->empty())
     {
-        for (auto& p : components_)
+        for (auto& p : *components_)
         {
             if (p.second->IsEnable())
             {
@@ -136,9 +158,9 @@ void ComponentManager::Update(Duration dt)
 
 void ComponentManager::Render(RenderContext& ctx)
 {
-    if (!components_.empty())
+    if (components_ && !components_->empty())
     {
-        for (auto& p : components_)
+        for (auto& p : *components_)
         {
             if (p.second->IsEnable())
             {
@@ -97,9 +97,11 @@ public:
 protected:
     ComponentManager(Actor* target);
 
+    ~ComponentManager();
+
 private:
-    Actor*       target_;
-    ComponentMap components_;
+    Actor*        target_;
+    ComponentMap* components_;  // 贴ɫû
 };
 
 /** @} */
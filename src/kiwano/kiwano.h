@@ -98,14 +98,18 @@
 //
 
 #include <kiwano/2d/Actor.h>
+#include <kiwano/2d/ActorPool.h>
+#include <kiwano/2d/Camera.h>
 #include <kiwano/2d/Canvas.h>
 #include <kiwano/2d/DebugActor.h>
 #include <kiwano/2d/GifSprite.h>
 #include <kiwano/2d/LayerActor.h>
+#include <kiwano/2d/ParticleSystem.h>
 #include <kiwano/2d/ShapeActor.h>
 #include <kiwano/2d/Sprite.h>
 #include <kiwano/2d/Stage.h>
 #include <kiwano/2d/TextActor.h>
+#include <kiwano/2d/TileMap.h>
 
 //
 // transition
@@ -145,6 +149,7 @@
 //
 
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/utils/UserData.h>
 #include <kiwano/utils/Timer.h>
 #include <kiwano/utils/Ticker.h>
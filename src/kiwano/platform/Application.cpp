@@ -23,6 +23,7 @@
 #include <kiwano/base/Director.h>
 #include <kiwano/render/Renderer.h>
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 
 namespace kiwano
 {
@@ -79,6 +80,8 @@ void Application::Run(RefPtr<Runner> runner)
     runner_    = runner;
     timer_     = MakePtr<Timer>();
 
+    Profiler::GetInstance().SetThreadName("Main");
+
     // Initialize runner
     runner->InitSettings();
 
@@ -134,6 +137,8 @@ void Application::Quit()
 
 void Application::UpdateFrame(Duration dt)
 {
+    Profiler::GetInstance().NewFrame();
+
     this->Render();
     this->Update(dt);
 }
@@ -184,6 +189,8 @@ void Application::DispatchEvent(Event* evt)
     if (!running_ /* Dispatch events even if application is paused */)
         return;
 
+    KGE_PROFILE_SCOPE("Application::DispatchEvent");
+
     auto ctx = EventModuleContext(modules_, evt);
     ctx.Next();
 }
@@ -193,6 +200,8 @@ void Application::Update(Duration dt)
     if (!running_ || is_paused_)
         return;
 
+    KGE_PROFILE_SCOPE("Application::Update");
+
     auto ctx = UpdateModuleContext(modules_, dt);
     ctx.Next();
 
@@ -220,6 +229,8 @@ void Application::Render()
     if (!running_ /* Render even if application is paused */)
         return;
 
+    KGE_PROFILE_SCOPE("Application::Render");
+
     Renderer& renderer = Renderer::GetInstance();
     renderer.Clear();
 
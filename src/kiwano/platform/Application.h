@@ -99,6 +99,13 @@ public:
      */
     void Use(Module& m);
 
+    /**
+     * \~chinese
+     * @brief ȡģ
+     * @details ڶȡģĺʱͳ
+     */
+    const ModuleList& GetModules() const;
+
     /**
      * \~chinese
      * @brief ȡ
@@ -199,4 +206,9 @@ inline bool Application::IsPaused() const
     return is_paused_;
 }
 
+inline const ModuleList& Application::GetModules() const
+{
+    return modules_;
+}
+
 }  // namespace kiwano
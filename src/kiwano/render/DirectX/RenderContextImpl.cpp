@@ -21,6 +21,8 @@
 #include <kiwano/render/DirectX/RenderContextImpl.h>
 #include <kiwano/render/Renderer.h>
 #include <kiwano/utils/Logger.h>
+#include <algorithm>
+#include <cstring>
 
 namespace kiwano
 {
@@ -28,7 +30,13 @@ namespace graphics
 {
 namespace directx
 {
-RenderContextImpl::RenderContextImpl() {}
+// Meshes not drawn for this many frames are released
+const uint32_t TRIANGLE_MESH_LIFETIME = 60;
+
+RenderContextImpl::RenderContextImpl()
+    : frame_(0)
+{
+}
 
 RenderContextImpl::~RenderContextImpl()
 {
@@ -43,6 +51,7 @@ HRESULT RenderContextImpl::CreateDeviceResources(ComPtr<ID2D1Factory> factory, C
     device_ctx_ = ctx;
     text_renderer_.Reset();
     current_brush_.Reset();
+    triangle_meshes_.clear();
 
     HRESULT hr = ITextRenderer::Create(&text_renderer_, device_ctx_.Get());
 
@@ -72,6 +81,7 @@ void RenderContextImpl::DiscardDeviceResources()
     text_renderer_.Reset();
     device_ctx_.Reset();
     current_brush_.Reset();
+    triangle_meshes_.clear();
 
     ComPolicy::Set(this, nullptr);
 }
@@ -105,6 +115,12 @@ void RenderContextImpl::BeginDraw()
 
     SaveDrawingState();
 
+    ++frame_;
+    triangle_meshes_.erase(std::remove_if(triangle_meshes_.begin(), triangle_meshes_.end(),
+                                          [=](const TriangleMesh& entry)
+                                          { return frame_ - entry.last_frame > TRIANGLE_MESH_LIFETIME; }),
+                           triangle_meshes_.end());
+
     RenderContext::BeginDraw();
     device_ctx_->BeginDraw();
 }
@@ -188,6 +204,47 @@ void RenderContextImpl::DrawBitmap(const Bitmap& bitmap, const Rect* src_rect, c
     }
 }
 
+void RenderContextImpl::DrawBitmapBatch(const Bitmap& bitmap, const Rect* src_rect, const Rect& dest_rect,
+                                        const Matrix3x2* transforms, const float* opacities, uint32_t count)
+{
+    KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
+
+    if (bitmap.IsValid() && count > 0)
+    {
+        D2D1_BITMAP_INTERPOLATION_MODE mode;
+        if (bitmap.GetInterpolationMode() == InterpolationMode::Linear)
+        {
+            mode = D2D1_BITMAP_INTERPOLATION_MODE_LINEAR;
+        }
+        else
+        {
+            mode = D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR;
+        }
+
+        // The state lookups are hoisted out of the loop, only the transform changes per primitive
+        auto               d2d_bitmap = ComPolicy::Get<ID2D1Bitmap>(bitmap);
+        const D2D1_RECT_F* d2d_src    = src_rect ? &DX::ConvertToRectF(*src_rect) : nullptr;
+        const D2D1_RECT_F& d2d_dest   = DX::ConvertToRectF(dest_rect);
+
+        Matrix3x2 transform;
+        device_ctx_->GetTransform(DX::ConvertToMatrix3x2F(&transform));
+
+        Matrix3x2 primitive_transform;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            primitive_transform = transforms[i] * transform;
+            device_ctx_->SetTransform(DX::ConvertToMatrix3x2F(primitive_transform));
+
+            const float opacity = opacities ? brush_opacity_ * opacities[i] : brush_opacity_;
+            device_ctx_->DrawBitmap(d2d_bitmap.Get(), d2d_dest, opacity, mode, d2d_src);
+        }
+
+        device_ctx_->SetTransform(DX::ConvertToMatrix3x2F(transform));
+
+        IncreasePrimitivesCount(count);
+    }
+}
+
 void RenderContextImpl::DrawTextLayout(const TextLayout& layout, const Point& offset,
                                        RefPtr<Brush> current_outline_brush)
 {
@@ -263,6 +320,55 @@ void RenderContextImpl::DrawLine(const Point& point1, const Point& point2)
     IncreasePrimitivesCount();
 }
 
+void RenderContextImpl::DrawLines(const Point* points, uint32_t count)
+{
+    KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    const uint32_t line_count = count / 2;
+    if (line_count == 0)
+        return;
+
+    // All segments go into one path geometry, so the batch is a single draw call
+    ComPtr<ID2D1Factory> factory;
+    device_ctx_->GetFactory(&factory);
+
+    ComPtr<ID2D1PathGeometry> geometry;
+    HRESULT                   hr = factory->CreatePathGeometry(&geometry);
+
+    ComPtr<ID2D1GeometrySink> sink;
+    if (SUCCEEDED(hr))
+    {
+        hr = geometry->Open(&sink);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        for (uint32_t i = 0; i < line_count; ++i)
+        {
+            sink->BeginFigure(DX::ConvertToPoint2F(points[i * 2]), D2D1_FIGURE_BEGIN_HOLLOW);
+            sink->AddLine(DX::ConvertToPoint2F(points[i * 2 + 1]));
+            sink->EndFigure(D2D1_FIGURE_END_OPEN);
+        }
+        hr = sink->Close();
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        auto  brush        = ComPolicy::Get<ID2D1Brush>(current_brush_);
+        auto  stroke_style = ComPolicy::Get<ID2D1StrokeStyle>(current_stroke_);
+        float stroke_width = current_stroke_ ? current_stroke_->GetWidth() : 1.0f;
+
+        device_ctx_->DrawGeometry(geometry.Get(), brush.Get(), stroke_width, stroke_style.Get());
+
+        IncreasePrimitivesCount();
+    }
+    else
+    {
+        KGE_ERRORF("Failed to draw lines with HRESULT of %08X", hr);
+    }
+}
+
 void RenderContextImpl::DrawRectangle(const Rect& rect)
 {
     KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
@@ -355,6 +461,78 @@ void RenderContextImpl::FillEllipse(const Point& center, const Vec2& radius)
     IncreasePrimitivesCount();
 }
 
+void RenderContextImpl::FillTriangles(const Point* vertices, uint32_t count)
+{
+    KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
+    KGE_ASSERT(current_brush_ && "The brush used for rendering has not been set!");
+
+    static_assert(sizeof(D2D1_TRIANGLE) == sizeof(Point) * 3, "Point must match D2D1_POINT_2F");
+
+    count -= count % 3;
+    if (count == 0)
+        return;
+
+    ComPtr<ID2D1Mesh> mesh = GetTriangleMesh(vertices, count);
+    if (mesh)
+    {
+        // Direct2D only fills meshes with antialiasing disabled
+        const D2D1_ANTIALIAS_MODE mode = device_ctx_->GetAntialiasMode();
+        device_ctx_->SetAntialiasMode(D2D1_ANTIALIAS_MODE_ALIASED);
+
+        auto brush = ComPolicy::Get<ID2D1Brush>(current_brush_);
+        device_ctx_->FillMesh(mesh.Get(), brush.Get());
+
+        device_ctx_->SetAntialiasMode(mode);
+
+        IncreasePrimitivesCount();
+    }
+}
+
+ComPtr<ID2D1Mesh> RenderContextImpl::GetTriangleMesh(const Point* vertices, uint32_t count)
+{
+    auto iter = std::find_if(triangle_meshes_.begin(), triangle_meshes_.end(),
+                             [=](const TriangleMesh& entry) { return entry.vertices == vertices; });
+    if (iter == triangle_meshes_.end())
+    {
+        triangle_meshes_.push_back(TriangleMesh{ vertices, {}, nullptr, 0 });
+        iter = triangle_meshes_.end() - 1;
+    }
+
+    iter->last_frame = frame_;
+    if (iter->mesh && iter->data.size() == count
+        && std::memcmp(iter->data.data(), vertices, sizeof(Point) * count) == 0)
+    {
+        return iter->mesh;
+    }
+
+    iter->mesh.Reset();
+    iter->data.assign(vertices, vertices + count);
+
+    ComPtr<ID2D1Mesh> mesh;
+    HRESULT           hr = device_ctx_->CreateMesh(&mesh);
+
+    ComPtr<ID2D1TessellationSink> sink;
+    if (SUCCEEDED(hr))
+    {
+        hr = mesh->Open(&sink);
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        sink->AddTriangles(reinterpret_cast<const D2D1_TRIANGLE*>(vertices), count / 3);
+        hr = sink->Close();
+    }
+
+    if (FAILED(hr))
+    {
+        KGE_ERRORF("Failed to fill triangles with HRESULT of %08X", hr);
+        return nullptr;
+    }
+
+    iter->mesh = mesh;
+    return mesh;
+}
+
 void RenderContextImpl::PushClipRect(const Rect& clip_rect)
 {
     KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
@@ -441,13 +619,37 @@ Matrix3x2 RenderContextImpl::GetTransform() const
 {
     Matrix3x2 transform;
     device_ctx_->GetTransform(reinterpret_cast<D2D1_MATRIX_3X2_F*>(&transform));
+
+    // 豸еı任Ѿͼ任
+    if (has_view_transform_)
+    {
+        transform = transform * view_matrix_inverse_;
+    }
     return std::move(transform);
 }
 
 void RenderContextImpl::SetTransform(const Matrix3x2& matrix)
 {
     KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
-    device_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&matrix));
+
+    if (has_view_transform_)
+    {
+        const Matrix3x2 transform = matrix * view_matrix_;
+        device_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&transform));
+    }
+    else
+    {
+        device_ctx_->SetTransform(DX::ConvertToMatrix3x2F(&matrix));
+    }
+}
+
+void RenderContextImpl::SetViewTransform(const Matrix3x2& matrix)
+{
+    KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
+
+    const Matrix3x2 transform = GetTransform();
+    RenderContext::SetViewTransform(matrix);
+    SetTransform(transform);
 }
 
 void RenderContextImpl::SetBlendMode(BlendMode blend)
@@ -494,6 +696,10 @@ void RenderContextImpl::SetTextAntialiasMode(TextAntialiasMode mode)
 bool RenderContextImpl::CheckVisibility(const Rect& bounds, const Matrix3x2& transform)
 {
     KGE_ASSERT(device_ctx_ && "Render target has not been initialized!");
+    if (has_view_transform_)
+    {
+        return visible_size_.Intersects((transform * view_matrix_).Transform(bounds));
+    }
     return visible_size_.Intersects(transform.Transform(bounds));
 }
 
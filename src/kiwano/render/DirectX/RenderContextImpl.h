@@ -48,12 +48,17 @@ public:
 
     void DrawBitmap(const Bitmap& bitmap, const Rect* src_rect, const Rect* dest_rect) override;
 
+    void DrawBitmapBatch(const Bitmap& bitmap, const Rect* src_rect, const Rect& dest_rect, const Matrix3x2* transforms,
+                         const float* opacities, uint32_t count) override;
+
     void DrawTextLayout(const TextLayout& layout, const Point& offset, RefPtr<Brush> outline_brush) override;
 
     void DrawShape(const Shape& shape) override;
 
     void DrawLine(const Point& point1, const Point& point2) override;
 
+    void DrawLines(const Point* points, uint32_t count) override;
+
     void DrawRectangle(const Rect& rect) override;
 
     void DrawRoundedRectangle(const Rect& rect, const Vec2& radius) override;
@@ -68,6 +73,8 @@ public:
 
     void FillEllipse(const Point& center, const Vec2& radius) override;
 
+    void FillTriangles(const Point* vertices, uint32_t count) override;
+
     void PushClipRect(const Rect& clip_rect) override;
 
     void PopClipRect() override;
@@ -90,6 +97,8 @@ public:
 
     void SetTransform(const Matrix3x2& matrix) override;
 
+    void SetViewTransform(const Matrix3x2& matrix) override;
+
     void SetBlendMode(BlendMode blend) override;
 
     void SetAntialiasMode(bool enabled) override;
@@ -111,10 +120,24 @@ protected:
 
     void RestoreDrawingState();
 
+    ComPtr<ID2D1Mesh> GetTriangleMesh(const Point* vertices, uint32_t count);
+
 protected:
     ComPtr<ITextRenderer>          text_renderer_;
     ComPtr<ID2D1DeviceContext>     device_ctx_;
     ComPtr<ID2D1DrawingStateBlock> drawing_state_;
+
+    // Meshes are keyed by the vertex buffer and rebuilt only when its contents change
+    struct TriangleMesh
+    {
+        const Point*      vertices;
+        Vector<Point>     data;
+        ComPtr<ID2D1Mesh> mesh;
+        uint32_t          last_frame;
+    };
+
+    uint32_t             frame_;
+    Vector<TriangleMesh> triangle_meshes_;
 };
 
 class KGE_API CommandListRenderContextImpl : public RenderContextImpl
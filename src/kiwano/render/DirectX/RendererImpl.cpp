@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/utils/Logger.h>
+#include <kiwano/utils/Profiler.h>
 #include <kiwano/event/Events.h>
 #include <kiwano/platform/NativeObject.hpp>
 #include <kiwano/platform/FileSystem.h>
@@ -234,6 +235,8 @@ void RendererImpl::Present()
 
 void RendererImpl::CreateBitmap(Bitmap& bitmap, StringView file_path)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateBitmap");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -288,6 +291,8 @@ void RendererImpl::CreateBitmap(Bitmap& bitmap, StringView file_path)
 
 void RendererImpl::CreateBitmap(Bitmap& bitmap, const BinaryData& data)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateBitmap");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -387,6 +392,8 @@ void RendererImpl::CreateBitmap(Bitmap& bitmap, const PixelSize& size, const Bin
 
 void RendererImpl::CreateGifImage(GifImage& gif, StringView file_path)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateGifImage");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -418,6 +425,8 @@ void RendererImpl::CreateGifImage(GifImage& gif, StringView file_path)
 
 void RendererImpl::CreateGifImage(GifImage& gif, const BinaryData& data)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateGifImage");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -607,6 +616,8 @@ void RendererImpl::CreateGifImageFrame(GifImage::Frame& frame, const GifImage& g
 void RendererImpl::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
                                         const Vector<String>& file_paths)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateFontCollection");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -649,6 +660,8 @@ void RendererImpl::CreateFontCollection(FontCollection& collection, Vector<Strin
 void RendererImpl::CreateFontCollection(FontCollection& collection, Vector<String>& family_names,
                                         const Vector<BinaryData>& datas)
 {
+    KGE_PROFILE_SCOPE("Renderer::CreateFontCollection");
+
     HRESULT hr = S_OK;
     if (!d2d_res_)
     {
@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 #include <kiwano/render/RenderContext.h>
+#include <kiwano/render/ShapeMaker.h>
 
 namespace kiwano
 {
@@ -27,6 +28,7 @@ RenderContext::RenderContext()
     : collecting_status_(false)
     , brush_opacity_(1.0f)
     , antialias_(true)
+    , has_view_transform_(false)
     , text_antialias_(TextAntialiasMode::GrayScale)
 {
 }
@@ -48,6 +50,23 @@ void RenderContext::EndDraw()
     }
 }
 
+void RenderContext::SetViewTransform(const Matrix3x2& matrix)
+{
+    view_matrix_        = matrix;
+    has_view_transform_ = !matrix.IsIdentity();
+
+    // ÿöά任ʱҪͼͼ任ıʱһ
+    if (has_view_transform_ && matrix.IsInvertible())
+        view_matrix_inverse_ = matrix.Invert();
+    else
+        view_matrix_inverse_ = Matrix3x2();
+}
+
+void RenderContext::ResetViewTransform()
+{
+    SetViewTransform(Matrix3x2());
+}
+
 void RenderContext::SetCollectingStatus(bool enable)
 {
     collecting_status_ = enable;
@@ -86,6 +105,55 @@ void RenderContext::SetCurrentStrokeStyle(RefPtr<StrokeStyle> stroke)
     current_stroke_ = stroke;
 }
 
+void RenderContext::DrawBitmapBatch(const Bitmap& bitmap, const Rect* src_rect, const Rect& dest_rect,
+                                    const Matrix3x2* transforms, const float* opacities, uint32_t count)
+{
+    const Matrix3x2 transform = this->GetTransform();
+    const float     opacity   = this->GetBrushOpacity();
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        this->SetTransform(transforms[i] * transform);
+        if (opacities)
+        {
+            this->SetBrushOpacity(opacity * opacities[i]);
+        }
+        this->DrawBitmap(bitmap, src_rect, &dest_rect);
+    }
+
+    this->SetTransform(transform);
+    this->SetBrushOpacity(opacity);
+}
+
+void RenderContext::DrawLines(const Point* points, uint32_t count)
+{
+    for (uint32_t i = 0; i + 1 < count; i += 2)
+    {
+        this->DrawLine(points[i], points[i + 1]);
+    }
+}
+
+void RenderContext::FillTriangles(const Point* vertices, uint32_t count)
+{
+    if (count < 3)
+        return;
+
+    ShapeMaker maker;
+    for (uint32_t i = 0; i + 2 < count; i += 3)
+    {
+        maker.BeginPath(vertices[i]);
+        maker.AddLine(vertices[i + 1]);
+        maker.AddLine(vertices[i + 2]);
+        maker.EndPath(true);
+    }
+
+    RefPtr<Shape> shape = maker.GetShape();
+    if (shape)
+    {
+        this->FillShape(*shape);
+    }
+}
+
 void RenderContext::DrawCircle(const Point& center, float radius)
 {
     this->DrawEllipse(center, Vec2(radius, radius));
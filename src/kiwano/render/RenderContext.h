@@ -83,6 +83,18 @@ public:
     virtual void DrawBitmap(const Bitmap& bitmap, const Rect* src_rect = nullptr,
                              const Rect* dest_rect = nullptr) = 0;
 
+    /// \~chinese
+    /// @brief λͼ
+    /// @details ʹͬһλͼƶͼԪÿͼԪӵжĶά任͸
+    /// @param bitmap λͼ
+    /// @param src_rect Դλͼü
+    /// @param dest_rect ͼԪϵеĿ
+    /// @param transforms ÿͼԪڵǰά任ı任
+    /// @param opacities ÿͼԪ͸ȣΪʱʹûˢ͸
+    /// @param count ͼԪ
+    virtual void DrawBitmapBatch(const Bitmap& bitmap, const Rect* src_rect, const Rect& dest_rect,
+                                 const Matrix3x2* transforms, const float* opacities, uint32_t count);
+
     /// \~chinese
     /// @brief ͼ
     /// @param image ͼ
@@ -107,6 +119,13 @@ public:
     /// @param point2 ߶յ
     virtual void DrawLine(const Point& point1, const Point& point2) = 0;
 
+    /// \~chinese
+    /// @brief ߶
+    /// @details ʹõǰˢʽƶ߶Σÿһ߶
+    /// @param points ߶ζ˵
+    /// @param count ˵
+    virtual void DrawLines(const Point* points, uint32_t count);
+
     /// \~chinese
     /// @brief ƾα߿
     /// @param rect 
@@ -158,6 +177,14 @@ public:
     /// @param radius Բ뾶
     virtual void FillEllipse(const Point& center, const Vec2& radius) = 0;
 
+    /// \~chinese
+    /// @brief 
+    /// @details ʹõǰˢһΣÿһΡεıԵûпݡ
+    /// 񰴶黺棬ͬһҶ㲻ʱ¹
+    /// @param vertices 
+    /// @param count 
+    virtual void FillTriangles(const Point* vertices, uint32_t count);
+
     /// \~chinese
     /// @brief ûƵĲü
     /// @param clip_rect ü
@@ -237,6 +264,31 @@ public:
     /// @brief ĵĶά任
     virtual void SetTransform(const Matrix3x2& matrix) = 0;
 
+    /// \~chinese
+    /// @brief ȡͼ任
+    const Matrix3x2& GetViewTransform() const;
+
+    /// \~chinese
+    /// @brief ͼ任
+    /// @details ͼ任ڶά任֮ͼԪƶͼʱ½ɫı任
+    virtual void SetViewTransform(const Matrix3x2& matrix);
+
+    /// \~chinese
+    /// @brief ͼ任
+    void ResetViewTransform();
+
+    /// \~chinese
+    /// @brief Ƿͼ任
+    bool HasViewTransform() const;
+
+    /// \~chinese
+    /// @brief ȡɼ
+    const Rect& GetVisibleRect() const;
+
+    /// \~chinese
+    /// @brief ÿɼ򣬿ɼĽɫᱻȾ
+    void SetVisibleRect(const Rect& rect);
+
     /// \~chinese
     /// @brief ȡȾĿ
     virtual RefPtr<Image> GetTarget() const = 0;
@@ -272,12 +324,15 @@ protected:
 
 protected:
     bool                antialias_;
+    bool                has_view_transform_;
     mutable bool        collecting_status_;
     float               brush_opacity_;
     TextAntialiasMode   text_antialias_;
     RefPtr<Brush>       current_brush_;
     RefPtr<StrokeStyle> current_stroke_;
     Rect                visible_size_;
+    Matrix3x2           view_matrix_;
+    Matrix3x2           view_matrix_inverse_;
     mutable Status      status_;
 };
 
@@ -293,4 +348,24 @@ inline const RenderContext::Status& RenderContext::GetStatus() const
     return status_;
 }
 
+inline const Matrix3x2& RenderContext::GetViewTransform() const
+{
+    return view_matrix_;
+}
+
+inline bool RenderContext::HasViewTransform() const
+{
+    return has_view_transform_;
+}
+
+inline const Rect& RenderContext::GetVisibleRect() const
+{
+    return visible_size_;
+}
+
+inline void RenderContext::SetVisibleRect(const Rect& rect)
+{
+    visible_size_ = rect;
+}
+
 }  // namespace kiwano
@@ -18,6 +18,8 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+#include <cstdarg>
+#include <cstdio>
 #include <ctime>
 #include <ios>
 #include <fstream>
@@ -269,7 +271,14 @@ void ConsoleLogProvider::Init() {}
 void ConsoleLogProvider::WriteMessage(LogLevel level, const char* msg)
 {
     if (level != LogLevel::Error)
+    {
+#if defined(KGE_PLATFORM_WINDOWS)
+        // ̨ɫЧڻָɫǰı
         std::cout << GetColor(level) << msg << std::flush << ConsoleColorBrush<-1>;
+#else
+        std::cout << GetColor(level) << msg << ConsoleColorBrush<-1>;
+#endif
+    }
     else
         std::cerr << GetColor(level) << msg << ConsoleColorBrush<-1>;
 
@@ -316,7 +325,7 @@ void FileLogProvider::WriteMessage(LogLevel level, const char* msg)
 {
     if (ofs_)
     {
-        ofs_ << msg << std::flush;
+        ofs_ << msg;
     }
 }
 
@@ -375,6 +384,19 @@ const char* LogBuffer::GetRaw() const
     return "";
 }
 
+const char* LogBuffer::GetData() const
+{
+    return buf_.data();
+}
+
+size_t LogBuffer::GetLength() const
+{
+    const auto pptr = this->pptr();
+    if (!pptr)
+        return 0;
+    return size_t(pptr - buf_.data());
+}
+
 LogBuffer::int_type LogBuffer::overflow(int_type ch)
 {
     if (traits_type::eq_int_type(ch, traits_type::eof()))
@@ -542,6 +564,106 @@ LogBuffer::pos_type LogBuffer::seekoff(off_type offset, std::ios_base::seekdir w
     return pos_type(offset);
 }
 
+//
+// AsyncLogQueue
+//
+
+// нߵУÿλţͨ CAS ռдλ
+class AsyncLogQueue
+{
+public:
+    struct Record
+    {
+        std::atomic<size_t> sequence;
+        LogLevel            level;
+        ClockTime           time;
+        size_t              length;
+        char                text[KGE_ASYNC_LOG_MESSAGE_SIZE];
+    };
+
+    explicit AsyncLogQueue(size_t capacity)
+        : mask_(0)
+        , enqueue_pos_(0)
+        , dequeue_pos_(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        mask_    = size - 1;
+        records_ = std::unique_ptr<Record[]>(new Record[size]);
+        for (size_t i = 0; i < size; ++i)
+        {
+            records_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t GetCapacity() const
+    {
+        return mask_ + 1;
+    }
+
+    bool Push(LogLevel level, const char* text, size_t length)
+    {
+        Record* record = nullptr;
+        size_t  pos    = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            record              = &records_[pos & mask_];
+            const size_t   seq  = record->sequence.load(std::memory_order_acquire);
+            const intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+            {
+                // 
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        length = std::min(length, size_t(KGE_ASYNC_LOG_MESSAGE_SIZE));
+        ::memcpy(record->text, text, length);
+        record->level  = level;
+        record->time   = ClockTime::Now();
+        record->length = length;
+        record->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ɳ Logger ߵ
+    Record* Front()
+    {
+        Record* record = &records_[dequeue_pos_ & mask_];
+        if (record->sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+            return nullptr;
+        return record;
+    }
+
+    void Pop()
+    {
+        records_[dequeue_pos_ & mask_].sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+        ++dequeue_pos_;
+    }
+
+    size_t GetApproxSize() const
+    {
+        return enqueue_pos_.load(std::memory_order_relaxed) - dequeue_pos_;
+    }
+
+private:
+    size_t                    mask_;
+    std::unique_ptr<Record[]> records_;
+    std::atomic<size_t>       enqueue_pos_;
+    size_t                    dequeue_pos_;
+};
+
 //
 // Logger
 //
@@ -550,6 +672,12 @@ Logger::Logger()
     , level_(LogLevel::Debug)
     , buffer_(1024)
     , stream_(&buffer_)
+    , async_(false)
+    , async_wake_(false)
+    , async_stop_(false)
+    , async_users_(0)
+    , dropped_(0)
+    , reported_dropped_(0)
 {
     RefPtr<LogFormater> formater = MakePtr<TextFormater>();
     SetFormater(formater);
@@ -558,7 +686,7 @@ Logger::Logger()
     AddProvider(provider);
 }
 
-std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
+std::iostream& Logger::GetFormatedStream(LogLevel level, ClockTime time, LogBuffer* buffer)
 {
     // reset buffer
     buffer->Reset();
@@ -568,12 +696,15 @@ std::iostream& Logger::GetFormatedStream(LogLevel level, LogBuffer* buffer)
 
     if (formater_)
     {
-        formater_->FormatHeader(stream_, level, ClockTime::Now());
+        formater_->FormatHeader(stream_, level, time);
     }
     return stream_;
 }
 
-Logger::~Logger() {}
+Logger::~Logger()
+{
+    DisableAsync();
+}
 
 void Logger::Logf(LogLevel level, const char* format, ...)
 {
@@ -583,19 +714,41 @@ void Logger::Logf(LogLevel level, const char* format, ...)
     if (level < level_)
         return;
 
+    if (this->IsAsync())
+    {
+        // ֱӸʽֲ߳̾УҪ
+        static thread_local char text[KGE_ASYNC_LOG_MESSAGE_SIZE];
+
+        va_list args;
+        va_start(args, format);
+
+        text[0]         = ' ';
+        const int count = ::vsnprintf(text + 1, sizeof(text) - 1, format, args);
+
+        va_end(args);
+
+        if (count >= 0)
+        {
+            const size_t length = std::min(size_t(count) + 1, sizeof(text) - 1);
+            this->PushAsyncMessage(level, text, length);
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     va_list args = nullptr;
     va_start(args, format);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &buffer_);
+    auto& stream = this->GetFormatedStream(level, ClockTime::Now(), &buffer_);
     stream << ' ' << strings::FormatArgs(format, args);
 
     va_end(args);
 
     // write message
     WriteToProviders(level, &buffer_);
+    FlushProviders();
 }
 
 void Logger::Flush()
@@ -603,12 +756,196 @@ void Logger::Flush()
     if (!enabled_)
         return;
 
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (async_queue_)
+    {
+        DrainAsyncQueue();
+    }
+    FlushProviders();
+}
+
+void Logger::FlushProviders()
+{
     for (auto provider : providers_)
     {
         provider->Flush();
     }
 }
 
+void Logger::EnableAsync(size_t capacity, Duration flush_interval)
+{
+    DisableAsync();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    async_queue_ = std::unique_ptr<AsyncLogQueue>(new AsyncLogQueue(capacity));
+    async_stop_  = false;
+    async_wake_  = false;
+    async_thread_ = std::thread(&Logger::AsyncLoop, this, flush_interval);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::DisableAsync()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!async_thread_.joinable())
+            return;
+
+        async_.store(false, std::memory_order_release);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_stop_ = true;
+    }
+    async_cond_.notify_one();
+    async_thread_.join();
+
+    // ȴде߳˳ͷŶ
+    while (async_users_.load(std::memory_order_seq_cst) != 0)
+        std::this_thread::yield();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    DrainAsyncQueue();
+    async_queue_.reset();
+}
+
+namespace
+{
+
+// 첽ģʽÿ̶߳ĸʽ壬ݻᱻ
+struct AsyncLogStream
+{
+    LogBuffer     buffer;
+    std::iostream stream;
+
+    AsyncLogStream()
+        : buffer(KGE_ASYNC_LOG_MESSAGE_SIZE)
+        , stream(&buffer)
+    {
+    }
+
+    static AsyncLogStream& Get()
+    {
+        static thread_local AsyncLogStream instance;
+        return instance;
+    }
+};
+
+}  // namespace
+
+std::ostream& Logger::GetAsyncStream()
+{
+    auto& ts = AsyncLogStream::Get();
+    ts.buffer.Reset();
+    ts.stream.clear();
+    return ts.stream;
+}
+
+void Logger::PushAsyncStream(LogLevel level)
+{
+    const auto& buffer = AsyncLogStream::Get().buffer;
+    this->PushAsyncMessage(level, buffer.GetData(), buffer.GetLength());
+}
+
+void Logger::PushAsyncMessage(LogLevel level, const char* text, size_t length)
+{
+    // ȵǼټ첽״̬DisableAsync ȴǼǵ߳˳ͷŶ
+    async_users_.fetch_add(1, std::memory_order_seq_cst);
+    if (!async_.load(std::memory_order_seq_cst))
+    {
+        async_users_.fetch_sub(1, std::memory_order_seq_cst);
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    AsyncLogQueue* queue  = async_queue_.get();
+    const bool     pushed = queue->Push(level, text, length);
+
+    // ־Ҫд룬йʱҲǰѺ̨߳
+    const bool wake = pushed && (level == LogLevel::Error || queue->GetApproxSize() > queue->GetCapacity() / 2);
+    async_users_.fetch_sub(1, std::memory_order_seq_cst);
+
+    if (!pushed)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (wake && !async_wake_.load(std::memory_order_relaxed))
+    {
+        // ѱǱą̼̃߳νʺ󡢽ȴǰ֪ͨᶪʧ
+        // ֻѱǣ̨߳д־ʱ
+        {
+            std::lock_guard<std::mutex> lock(async_mutex_);
+            async_wake_.store(true, std::memory_order_relaxed);
+        }
+        async_cond_.notify_one();
+    }
+}
+
+void Logger::AsyncLoop(Duration flush_interval)
+{
+    const auto interval = std::chrono::milliseconds(std::max<int64_t>(flush_interval.GetMilliseconds(), 1));
+
+    std::unique_lock<std::mutex> wake_lock(async_mutex_);
+    while (!async_stop_)
+    {
+        async_cond_.wait_for(wake_lock, interval, [this]() { return async_stop_ || async_wake_.load(); });
+        async_wake_.store(false, std::memory_order_relaxed);
+
+        // дˢ־ʱͷŻ߲ȴļ IO
+        wake_lock.unlock();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            DrainAsyncQueue();
+        }
+        wake_lock.lock();
+    }
+}
+
+void Logger::DrainAsyncQueue()
+{
+    if (!async_queue_)
+        return;
+
+    bool written = false;
+
+    // ÿдһ־дʱһֱռ
+    const size_t capacity = async_queue_->GetCapacity();
+    for (size_t i = 0; i < capacity; ++i)
+    {
+        AsyncLogQueue::Record* record = async_queue_->Front();
+        if (!record)
+            break;
+
+        auto& stream = this->GetFormatedStream(record->level, record->time, &buffer_);
+        stream.write(record->text, std::streamsize(record->length));
+        const LogLevel level = record->level;
+        async_queue_->Pop();
+
+        WriteToProviders(level, &buffer_);
+        written = true;
+    }
+
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != reported_dropped_)
+    {
+        auto& stream = this->GetFormatedStream(LogLevel::Warning, ClockTime::Now(), &buffer_);
+        stream << ' ' << (dropped - reported_dropped_) << " log messages were dropped because the queue was full";
+        reported_dropped_ = dropped;
+
+        WriteToProviders(LogLevel::Warning, &buffer_);
+        written = true;
+    }
+
+    if (written)
+    {
+        FlushProviders();
+    }
+}
+
 void Logger::SetLevel(LogLevel level)
 {
     level_ = level;
@@ -618,11 +955,25 @@ void Logger::AddProvider(RefPtr<LogProvider> provider)
 {
     if (provider)
     {
+        // 첽ģʽº̨̻߳ͬʱ־
+        std::lock_guard<std::mutex> lock(mutex_);
+
         provider->Init();
         providers_.push_back(provider);
     }
 }
 
+void Logger::RemoveProvider(RefPtr<LogProvider> provider)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto iter = std::find(providers_.begin(), providers_.end(), provider);
+    if (iter != providers_.end())
+    {
+        providers_.erase(iter);
+    }
+}
+
 RefPtr<LogFormater> Logger::GetFormater()
 {
     return formater_;
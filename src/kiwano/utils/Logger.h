@@ -19,7 +19,10 @@
 // THE SOFTWARE.
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 #include <iomanip>
 #include <streambuf>
 #include <fstream>
@@ -113,9 +116,15 @@
 #endif
 #endif  // KGE_PLATFORM_WINDOWS
 
+#ifndef KGE_ASYNC_LOG_MESSAGE_SIZE
+#define KGE_ASYNC_LOG_MESSAGE_SIZE 512
+#endif
+
 namespace kiwano
 {
 
+class AsyncLogQueue;
+
 /**
  * \~chinese
  * @brief ־ȼ
@@ -158,6 +167,10 @@ public:
 
     const char* GetRaw() const;
 
+    const char* GetData() const;
+
+    size_t GetLength() const;
+
     LogBuffer(const LogBuffer&) = delete;
 
     LogBuffer& operator=(const LogBuffer&) = delete;
@@ -292,6 +305,15 @@ public:
     /// @param provider ־
     void AddProvider(RefPtr<LogProvider> provider);
 
+    /// \~chinese
+    /// @brief Ƴ־
+    /// @param provider ־
+    void RemoveProvider(RefPtr<LogProvider> provider);
+
+    /// \~chinese
+    /// @brief ȡ־
+    const Vector<RefPtr<LogProvider>>& GetProviders() const;
+
     /// \~chinese
     /// @brief ־ʽ
     /// @param formater ־ʽ
@@ -311,15 +333,50 @@ public:
     /// @brief ʾرտ̨
     void ShowConsole(bool show);
 
+    /// \~chinese
+    /// @brief 첽־
+    /// @details ־ڵ̸߳ʽУɺ̨߳д־ߣ
+    /// ÿˢ¼ִ־ʱˢ¡ʱ־ᱻ
+    /// @param capacity ÿ־ KGE_ASYNC_LOG_MESSAGE_SIZE ֽڣֱض
+    /// @param flush_interval ˢ¼
+    /// @note Ӧû̴߳ӡ־ʱãʱ
+    void EnableAsync(size_t capacity = 4096, Duration flush_interval = time::Millisecond * 200);
+
+    /// \~chinese
+    /// @brief ر첽־
+    /// @details дʣ־ֹ̨ͣ߳
+    /// @note Ӧû̴߳ӡ־ʱã˳ʱ
+    void DisableAsync();
+
+    /// \~chinese
+    /// @brief Ƿ첽־
+    bool IsAsync() const;
+
+    /// \~chinese
+    /// @brief ȡ־
+    uint64_t GetDroppedCount() const;
+
     virtual ~Logger();
 
 private:
     Logger();
 
-    std::iostream& GetFormatedStream(LogLevel level, LogBuffer* buffer);
+    std::iostream& GetFormatedStream(LogLevel level, ClockTime time, LogBuffer* buffer);
 
     void WriteToProviders(LogLevel level, LogBuffer* buffer);
 
+    void FlushProviders();
+
+    std::ostream& GetAsyncStream();
+
+    void PushAsyncStream(LogLevel level);
+
+    void PushAsyncMessage(LogLevel level, const char* text, size_t length);
+
+    void AsyncLoop(Duration flush_interval);
+
+    void DrainAsyncQueue();
+
 private:
     bool                        enabled_;
     LogLevel                    level_;
@@ -328,6 +385,17 @@ private:
     std::iostream               stream_;
     Vector<RefPtr<LogProvider>> providers_;
     std::mutex                  mutex_;
+
+    std::atomic<bool>              async_;
+    std::atomic<bool>              async_wake_;
+    bool                           async_stop_;
+    std::atomic<uint32_t>          async_users_;
+    std::unique_ptr<AsyncLogQueue> async_queue_;
+    std::thread                    async_thread_;
+    std::mutex                     async_mutex_;
+    std::condition_variable        async_cond_;
+    std::atomic<uint64_t>          dropped_;
+    uint64_t                       reported_dropped_;
 };
 
 inline void Logger::Enable()
@@ -345,6 +413,21 @@ inline void Logger::SetFormater(RefPtr<LogFormater> formater)
     formater_ = formater;
 }
 
+inline const Vector<RefPtr<LogProvider>>& Logger::GetProviders() const
+{
+    return providers_;
+}
+
+inline bool Logger::IsAsync() const
+{
+    return async_.load(std::memory_order_relaxed);
+}
+
+inline uint64_t Logger::GetDroppedCount() const
+{
+    return dropped_.load(std::memory_order_relaxed);
+}
+
 template <typename... _Args>
 inline void Logger::Log(LogLevel level, _Args&&... args)
 {
@@ -354,14 +437,25 @@ inline void Logger::Log(LogLevel level, _Args&&... args)
     if (level < level_)
         return;
 
+    if (this->IsAsync())
+    {
+        // ڵǰ̵߳Ļиʽ־ͷɺ̨߳
+        auto& stream = this->GetAsyncStream();
+        (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
+
+        this->PushAsyncStream(level);
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
 
     // build message
-    auto& stream = this->GetFormatedStream(level, &this->buffer_);
+    auto& stream = this->GetFormatedStream(level, ClockTime::Now(), &this->buffer_);
     (void)std::initializer_list<int>{ ((stream << ' ' << args), 0)... };
 
     // write message
     this->WriteToProviders(level, &this->buffer_);
+    this->FlushProviders();
 }
 
 }  // namespace kiwano
@@ -0,0 +1,343 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include <kiwano/utils/Profiler.h>
+#include <kiwano/utils/Logger.h>
+#include <fstream>
+#include <iomanip>
+#include <thread>
+
+namespace kiwano
+{
+
+namespace
+{
+
+// ʱͳƵָƽϵ
+const float TIMING_SMOOTHING = 0.1f;
+
+// ɷУ߳˳黹ڱβɼ¼ȻԵ
+thread_local void*  current_buffer = nullptr;
+thread_local String current_thread_name;
+
+void WriteJsonString(std::ostream& os, const char* str)
+{
+    os << '"';
+    for (; *str; ++str)
+    {
+        char ch = *str;
+        if (ch == '"' || ch == '\\')
+            os << '\\' << ch;
+        else if (static_cast<unsigned char>(ch) < 0x20)
+            os << ' ';
+        else
+            os << ch;
+    }
+    os << '"';
+}
+
+}  // namespace
+
+// ߳˳ʱ黹֮󴴽̸߳
+class Profiler::ThreadBufferOwner
+{
+public:
+    ThreadBuffer* buffer = nullptr;
+
+    ~ThreadBufferOwner()
+    {
+        if (buffer)
+        {
+            current_buffer = nullptr;
+            Profiler::GetInstance().ReleaseThreadBuffer(buffer);
+        }
+    }
+};
+
+void ProfileTiming::Record(float ms)
+{
+    last     = ms;
+    smoothed = smoothed + (ms - smoothed) * TIMING_SMOOTHING;
+    max      = (std::max)(max, ms);
+}
+
+Profiler::Profiler()
+    : capturing_(false)
+    , sampling_(false)
+    , generation_(0)
+    , capacity_(65536)
+    , sample_interval_(10)
+    , frame_index_(0)
+    , frames_to_capture_(0)
+    , capture_start_(0)
+    , next_thread_id_(0)
+{
+}
+
+Profiler::~Profiler() {}
+
+void Profiler::StartCapture()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // ֻ߳գдʱִ仯Ż
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    frame_index_   = 0;
+    capture_start_ = GetTimestamp();
+    sampling_.store(sample_interval_ != 0, std::memory_order_relaxed);
+    capturing_.store(true, std::memory_order_release);
+}
+
+void Profiler::StopCapture()
+{
+    sampling_.store(false, std::memory_order_relaxed);
+    capturing_.store(false, std::memory_order_release);
+    frames_to_capture_ = 0;
+}
+
+void Profiler::CaptureFrames(uint32_t frames, StringView file_path)
+{
+    if (frames == 0)
+        return;
+
+    StartCapture();
+    frames_to_capture_ = frames;
+    capture_file_      = file_path;
+}
+
+void Profiler::SetSampleInterval(uint32_t interval)
+{
+    sample_interval_ = interval;
+}
+
+void Profiler::SetBufferCapacity(uint32_t capacity)
+{
+    capacity_.store((std::max)(capacity, 1u), std::memory_order_relaxed);
+}
+
+void Profiler::SetThreadName(StringView name)
+{
+    // ߳дһ¼ʱŴӲɼ̲߳ռڴ
+    current_thread_name = name;
+
+    if (current_buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        static_cast<ThreadBuffer*>(current_buffer)->name = current_thread_name;
+    }
+}
+
+void Profiler::NewFrame()
+{
+    if (!IsCapturing())
+        return;
+
+    ++frame_index_;
+
+    if (frames_to_capture_ > 0 && frame_index_ > frames_to_capture_)
+    {
+        String file_path = std::move(capture_file_);
+        StopCapture();
+        SaveChromeTrace(file_path);
+        return;
+    }
+
+    sampling_.store(sample_interval_ != 0 && frame_index_ % sample_interval_ == 0, std::memory_order_relaxed);
+}
+
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+{
+    if (!current_buffer)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // ˳̵߳Ļбβɼ¼ʱһβɼ
+        ThreadBuffer*  buffer     = nullptr;
+        const uint32_t generation = generation_.load(std::memory_order_relaxed);
+        for (auto iter = free_buffers_.begin(); iter != free_buffers_.end(); ++iter)
+        {
+            if ((*iter)->generation.load(std::memory_order_relaxed) != generation
+                || (*iter)->count.load(std::memory_order_relaxed) == 0)
+            {
+                buffer = *iter;
+                free_buffers_.erase(iter);
+                break;
+            }
+        }
+
+        if (!buffer)
+        {
+            buffers_.push_back(std::make_unique<ThreadBuffer>());
+
+            buffer             = buffers_.back().get();
+            buffer->generation = 0;
+            buffer->writing    = false;
+            buffer->count      = 0;
+        }
+        buffer->id   = ++next_thread_id_;
+        buffer->name = current_thread_name;
+
+        current_buffer = buffer;
+
+        thread_local ThreadBufferOwner owner;
+        owner.buffer = buffer;
+    }
+    return static_cast<ThreadBuffer*>(current_buffer);
+}
+
+void Profiler::ReleaseThreadBuffer(ThreadBuffer* buffer)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    free_buffers_.push_back(buffer);
+}
+
+void Profiler::AddEvent(const char* name, int64_t begin, int64_t end)
+{
+    ThreadBuffer* buffer = GetThreadBuffer();
+
+    // ȱдټɼ״̬ WaitForWriters ϣʱҪôȴдɣ
+    // Ҫôд뿴ɼֹͣ
+    buffer->writing.store(true);
+    if (!capturing_.load())
+    {
+        buffer->writing.store(false, std::memory_order_release);
+        return;
+    }
+
+    const uint32_t generation = generation_.load(std::memory_order_relaxed);
+    if (buffer->generation.load(std::memory_order_relaxed) != generation)
+    {
+        buffer->generation.store(generation, std::memory_order_relaxed);
+        buffer->count.store(0, std::memory_order_relaxed);
+
+        const uint32_t capacity = capacity_.load(std::memory_order_relaxed);
+        if (buffer->events.size() != capacity)
+        {
+            buffer->events.clear();
+            buffer->events.shrink_to_fit();
+            buffer->events.resize(capacity);
+        }
+    }
+
+    const uint64_t index = buffer->count.load(std::memory_order_relaxed);
+
+    ProfileEvent& evt = buffer->events[size_t(index % buffer->events.size())];
+    evt.name          = name;
+    evt.begin         = begin;
+    evt.end           = end;
+
+    buffer->count.store(index + 1, std::memory_order_release);
+    buffer->writing.store(false, std::memory_order_release);
+}
+
+void Profiler::WaitForWriters()
+{
+    for (const auto& buffer : buffers_)
+    {
+        while (buffer->writing.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+Vector<ProfileEvent> Profiler::GetEvents(Vector<uint32_t>* thread_ids)
+{
+    StopCapture();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // ɼֹͣȴ󻺳ٱ޸
+    WaitForWriters();
+
+    const uint32_t generation = generation_.load(std::memory_order_relaxed);
+
+    Vector<ProfileEvent> events;
+    for (const auto& buffer : buffers_)
+    {
+        const uint64_t count = buffer->count.load(std::memory_order_acquire);
+        if (buffer->generation.load(std::memory_order_relaxed) != generation || count == 0)
+            continue;
+
+        const uint64_t capacity = buffer->events.size();
+        const uint64_t first    = count > capacity ? count - capacity : 0;
+        for (uint64_t i = first; i < count; ++i)
+        {
+            events.push_back(buffer->events[size_t(i % capacity)]);
+            if (thread_ids)
+                thread_ids->push_back(buffer->id);
+        }
+    }
+    return events;
+}
+
+void Profiler::WriteChromeTrace(std::ostream& os)
+{
+    Vector<uint32_t>     thread_ids;
+    Vector<ProfileEvent> events = GetEvents(&thread_ids);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    for (const auto& buffer : buffers_)
+    {
+        if (buffer->name.empty())
+            continue;
+
+        os << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id
+           << ",\"args\":{\"name\":";
+        WriteJsonString(os, buffer->name.c_str());
+        os << "}}";
+        first = false;
+    }
+
+    os << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        const auto& evt = events[i];
+
+        os << (first ? "" : ",") << "\n{\"name\":";
+        WriteJsonString(os, evt.name);
+        os << ",\"cat\":\"kiwano\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread_ids[i]
+           << ",\"ts\":" << double(evt.begin - capture_start_) / 1000.0
+           << ",\"dur\":" << double(evt.end - evt.begin) / 1000.0 << "}";
+        first = false;
+    }
+
+    os << "\n]}\n";
+}
+
+bool Profiler::SaveChromeTrace(StringView file_path)
+{
+    std::ofstream ofs(file_path);
+    if (!ofs.is_open())
+    {
+        KGE_ERRORF("Failed to open trace file: %s", String(file_path).c_str());
+        return false;
+    }
+
+    WriteChromeTrace(ofs);
+    KGE_NOTICEF("Profiler trace saved to %s", String(file_path).c_str());
+    return true;
+}
+
+}  // namespace kiwano
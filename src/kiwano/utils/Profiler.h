@@ -0,0 +1,242 @@
+// Copyright (c) 2016-2018 Kiwano - Nomango
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <kiwano/core/Common.h>
+
+#define KGE_PROFILE_CONCAT_IMPL(A, B) A##B
+#define KGE_PROFILE_CONCAT(A, B) KGE_PROFILE_CONCAT_IMPL(A, B)
+
+#ifndef KGE_PROFILE_SCOPE
+#define KGE_PROFILE_SCOPE(NAME)                                              \
+    ::kiwano::ProfileScope KGE_PROFILE_CONCAT(kge_profile_scope_, __LINE__)( \
+        NAME, ::kiwano::Profiler::GetInstance().IsCapturing())
+#endif
+
+#ifndef KGE_PROFILE_SCOPE_SAMPLED
+#define KGE_PROFILE_SCOPE_SAMPLED(NAME)                                      \
+    ::kiwano::ProfileScope KGE_PROFILE_CONCAT(kge_profile_scope_, __LINE__)( \
+        NAME, ::kiwano::Profiler::GetInstance().IsSampling())
+#endif
+
+namespace kiwano
+{
+
+/**
+ * \~chinese
+ * @brief ܷ¼
+ */
+struct ProfileEvent
+{
+    const char* name;   ///< ¼ƣڲɼڼ䱣Чַͨ
+    int64_t     begin;  ///< ʼʱ룩
+    int64_t     end;    ///< ʱ룩
+};
+
+/**
+ * \~chinese
+ * @brief ʱͳƣλΪ
+ */
+struct KGE_API ProfileTiming
+{
+    float last     = 0.0f;  ///< һκʱ
+    float smoothed = 0.0f;  ///< ƽĺʱ
+    float max      = 0.0f;  ///< ʱ
+
+    /// \~chinese
+    /// @brief ¼һκʱ
+    void Record(float ms);
+};
+
+/**
+ * \~chinese
+ * @brief ܷ
+ * @details ʹ KGE_PROFILE_SCOPE ¼ĺʱÿ߳̽¼дԼĻλ
+ * дɼԵΪ Chrome trace ʽ JSON chrome://tracing  Perfetto
+ * в鿴δɼʱÿֻһη֧жϣںȾ
+ */
+class KGE_API Profiler final : public Singleton<Profiler>
+{
+    friend Singleton<Profiler>;
+
+public:
+    /// \~chinese
+    /// @brief ʼɼ
+    /// @details ֮ǰɼ¼
+    void StartCapture();
+
+    /// \~chinese
+    /// @brief ֹͣɼ
+    void StopCapture();
+
+    /// \~chinese
+    /// @brief ɼָֹ֡ͣΪ Chrome trace ļ
+    /// @param frames ֡
+    /// @param file_path ļ·
+    void CaptureFrames(uint32_t frames, StringView file_path);
+
+    /// \~chinese
+    /// @brief Ƿڲɼ
+    bool IsCapturing() const;
+
+    /// \~chinese
+    /// @brief ǰ֡Ƿ
+    /// @details ɫĸºȾֻܶ࣬ڲ֡м¼
+    bool IsSampling() const;
+
+    /// \~chinese
+    /// @brief ò
+    /// @param interval ÿ interval ֡һ֡Ϊ 0 ʱĬΪ 10
+    void SetSampleInterval(uint32_t interval);
+
+    /// \~chinese
+    /// @brief ÿ̵߳Ļλɵ¼
+    /// @details д󸲸¼һοʼɼʱЧĬΪ 65536
+    void SetBufferCapacity(uint32_t capacity);
+
+    /// \~chinese
+    /// @brief õǰ̵߳ƣʾڵĽ
+    void SetThreadName(StringView name);
+
+    /// \~chinese
+    /// @brief ʼµһ֡
+    /// @details  Application ÿ֡ǰ
+    void NewFrame();
+
+    /// \~chinese
+    /// @brief ǰ̵߳Ļ¼
+    void AddEvent(const char* name, int64_t begin, int64_t end);
+
+    /// \~chinese
+    /// @brief ȡɼ¼
+    /// @param thread_ids Ӧÿ¼̵߳ı
+    /// @details ǰֹͣɼȴ߳д¼ɡֹͣٱ¼
+    Vector<ProfileEvent> GetEvents(Vector<uint32_t>* thread_ids = nullptr);
+
+    /// \~chinese
+    /// @brief  Chrome trace ʽɼ
+    /// @details ǰֹͣɼ
+    void WriteChromeTrace(std::ostream& os);
+
+    /// \~chinese
+    /// @brief ɼΪ Chrome trace ļ
+    /// @details ǰֹͣɼ
+    bool SaveChromeTrace(StringView file_path);
+
+    /// \~chinese
+    /// @brief ȡʱ룩
+    static int64_t GetTimestamp();
+
+    ~Profiler();
+
+private:
+    Profiler();
+
+    struct ThreadBuffer
+    {
+        uint32_t              id;
+        String                name;
+        std::atomic<uint32_t> generation;
+        std::atomic<bool>     writing;
+        Vector<ProfileEvent>  events;
+        std::atomic<uint64_t> count;
+    };
+
+    class ThreadBufferOwner;
+
+    ThreadBuffer* GetThreadBuffer();
+
+    void ReleaseThreadBuffer(ThreadBuffer* buffer);
+
+    void WaitForWriters();
+
+private:
+    std::atomic<bool>     capturing_;
+    std::atomic<bool>     sampling_;
+    std::atomic<uint32_t> generation_;
+    std::atomic<uint32_t> capacity_;
+    uint32_t              sample_interval_;
+    uint32_t              frame_index_;
+    uint32_t              frames_to_capture_;
+    int64_t               capture_start_;
+    String                capture_file_;
+    uint32_t              next_thread_id_;
+    std::mutex            mutex_;
+
+    Vector<std::unique_ptr<ThreadBuffer>> buffers_;
+    Vector<ThreadBuffer*>                 free_buffers_;
+};
+
+/**
+ * \~chinese
+ * @brief ܷ
+ * @details ʱĺʱдܷͨͨ KGE_PROFILE_SCOPE ʹ
+ */
+class ProfileScope : Noncopyable
+{
+public:
+    ProfileScope(const char* name, bool enabled);
+
+    ~ProfileScope();
+
+private:
+    const char* name_;
+    int64_t     begin_;
+};
+
+inline bool Profiler::IsCapturing() const
+{
+    return capturing_.load(std::memory_order_relaxed);
+}
+
+inline bool Profiler::IsSampling() const
+{
+    return sampling_.load(std::memory_order_relaxed);
+}
+
+inline int64_t Profiler::GetTimestamp()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+inline ProfileScope::ProfileScope(const char* name, bool enabled)
+    : name_(nullptr)
+    , begin_(0)
+{
+    if (enabled)
+    {
+        name_  = name;
+        begin_ = Profiler::GetTimestamp();
+    }
+}
+
+inline ProfileScope::~ProfileScope()
+{
+    if (name_)
+    {
+        Profiler::GetInstance().AddEvent(name_, begin_, Profiler::GetTimestamp());
+    }
+}
+
+}  // namespace kiwano